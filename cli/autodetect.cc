@@ -3,6 +3,7 @@
 #include "logger.hh"
 #include "radioinfo.hh"
 #include "usbdevice.hh"
+#include "radiodetector.hh"
 
 QVariant
 parseDeviceHandle(const QString &device) {
@@ -14,8 +15,9 @@ parseDeviceHandle(const QString &device) {
 }
 
 void
-printDevices(QTextStream &out, const QList<USBDeviceDescriptor> &devices) {
-  foreach (USBDeviceDescriptor device, devices) {
+printDevices(QTextStream &out, const QList<USBDeviceDescriptor> &devices, const QList<RadioInfo> &radios) {
+  for (int i=0; i<devices.count(); i++) {
+    const USBDeviceDescriptor &device = devices.at(i);
     if (USBDeviceInfo::Class::None == device.interfaceClass())
       continue;
     out << "Device '";
@@ -30,6 +32,8 @@ printDevices(QTextStream &out, const QList<USBDeviceDescriptor> &devices) {
     }
     out << " Type:        " << device.description() << "\n";
     out << " Description: " << device.longDescription() << "\n";
+    if ((i < radios.count()) && radios.at(i).isValid())
+      out << " Radio:       " << radios.at(i).manufactuer() << " " << radios.at(i).name() << "\n";
   }
 }
 
@@ -66,11 +70,14 @@ autoDetect(QCommandLineParser &parser, QCoreApplication &app, const ErrorStack &
       return nullptr;
     }
   } else if (1 != interfaces.size()) {
-    // If no device is specified, there should only be one interface
+    // If no device is specified, there should only be one interface. Identify all devices
+    // concurrently, that are save to probe, to help selecting the device.
+    RadioDetector detector;
+    QList<RadioInfo> radios = detector.identify(interfaces);
     ErrorStack::MessageStream msg(err, __FILE__, __LINE__);
     msg << "Cannot auto-detect radio, more than one matching USB devices found:"
         << " Use --device option to specifiy to which device to talk to. Devices found:\n";
-    printDevices(msg, interfaces);
+    printDevices(msg, interfaces, radios);
     return nullptr;
   } else if (! interfaces.first().isSave()) {
     ErrorStack::MessageStream msg(err, __FILE__, __LINE__);
@@ -7,7 +7,8 @@
 
 
 QVariant parseDeviceHandle(const QString &device);
-void printDevices(QTextStream &out, const QList<USBDeviceDescriptor> &devices);
+void printDevices(QTextStream &out, const QList<USBDeviceDescriptor> &devices,
+                  const QList<RadioInfo> &radios=QList<RadioInfo>());
 Radio *autoDetect(QCommandLineParser &parser, QCoreApplication &app, const ErrorStack &err=ErrorStack());
 
 #endif // AUTODETECT_HH
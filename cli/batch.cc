@@ -0,0 +1,241 @@
+#include "batch.hh"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <QElapsedTimer>
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "logger.hh"
+#include "userdatabase.hh"
+#include "options.hh"
+#include "verify.hh"
+#include "encodecodeplug.hh"
+#include "encodecallsigndb.hh"
+#include "decodecodeplug.hh"
+#include "infofile.hh"
+#include "concurrency.hh"
+
+
+/** A single job of the batch. */
+struct BatchJob {
+  /** The line number within the job list. */
+  int line;
+  /** The job command line. */
+  QStringList arguments;
+  /** The parsed command line. */
+  QCommandLineParser parser;
+  /** The exit status of the job. */
+  int status;
+  /** Runtime of the job in ms. */
+  qint64 duration;
+};
+
+
+/** Splits a job line into its arguments. Arguments are separated by white spaces, single and
+ * double quotes can be used to pass arguments containing white spaces. */
+static QStringList
+splitArguments(const QString &line) {
+  QStringList args;
+  QString current;
+  bool inArg = false;
+  QChar quote;
+  foreach (QChar c, line) {
+    if (! quote.isNull()) {
+      if (c == quote)
+        quote = QChar();
+      else
+        current.append(c);
+    } else if (('"' == c) || ('\'' == c)) {
+      quote = c; inArg = true;
+    } else if (c.isSpace()) {
+      if (inArg)
+        args.append(current);
+      current.clear(); inArg = false;
+    } else {
+      current.append(c); inArg = true;
+    }
+  }
+  if (inArg)
+    args.append(current);
+  return args;
+}
+
+/** Checks the job, as the commands bail out on missing arguments. */
+static bool
+checkJob(BatchJob &job) {
+  if (! job.parser.parse(QStringList("dmrconf") + job.arguments)) {
+    logError() << "Job at line " << job.line << ": " << job.parser.errorText();
+    return false;
+  }
+
+  QStringList positional = job.parser.positionalArguments();
+  if (positional.isEmpty()) {
+    logError() << "Job at line " << job.line << ": No command given.";
+    return false;
+  }
+
+  QString command = positional.at(0);
+  if (("detect" == command) || ("read" == command) || ("write" == command) || ("write-db" == command)) {
+    logError() << "Job at line " << job.line << ": Command '" << command
+               << "' accesses a radio and cannot be used in batch mode.";
+    return false;
+  } else if (("verify" == command) || ("decode" == command) || ("info" == command)) {
+    if (2 > positional.size()) {
+      logError() << "Job at line " << job.line << ": Command '" << command << "' needs a file.";
+      return false;
+    }
+  } else if ("encode-db" == command) {
+    if (2 > positional.size()) {
+      logError() << "Job at line " << job.line << ": Command '" << command << "' needs a file.";
+      return false;
+    }
+    if (! job.parser.isSet("radio")) {
+      logError() << "Job at line " << job.line << ": Command '" << command
+                 << "' needs the --radio option.";
+      return false;
+    }
+  } else if ("encode" == command) {
+    if (3 > positional.size()) {
+      logError() << "Job at line " << job.line << ": Command '" << command
+                 << "' needs an input and an output file.";
+      return false;
+    }
+    if (! job.parser.isSet("radio")) {
+      logError() << "Job at line " << job.line << ": Command '" << command
+                 << "' needs the --radio option.";
+      return false;
+    }
+  } else {
+    logError() << "Job at line " << job.line << ": Unknown command '" << command << "'.";
+    return false;
+  }
+
+  return true;
+}
+
+static int
+runJob(BatchJob &job, QCoreApplication &app, UserDatabase *userdb) {
+  QString command = job.parser.positionalArguments().at(0);
+  if ("verify" == command)
+    return verify(job.parser, app);
+  if ("encode" == command)
+    return encodeCodeplug(job.parser, app);
+  if ("encode-db" == command)
+    return encodeCallsignDB(job.parser, app, userdb);
+  if ("decode" == command)
+    return decodeCodeplug(job.parser, app);
+  if ("info" == command)
+    return infoFile(job.parser, app);
+  return -1;
+}
+
+
+int batch(QCommandLineParser &parser, QCoreApplication &app) {
+  // Read job list from file or stdin
+  QFile file;
+  if ((2 > parser.positionalArguments().size()) || ("-" == parser.positionalArguments().at(1))) {
+    if (! file.open(stdin, QIODevice::ReadOnly)) {
+      logError() << "Cannot read jobs from stdin: " << file.errorString();
+      return -1;
+    }
+  } else {
+    file.setFileName(parser.positionalArguments().at(1));
+    if (! file.open(QIODevice::ReadOnly)) {
+      logError() << "Cannot open job list '" << file.fileName() << "': " << file.errorString();
+      return -1;
+    }
+  }
+
+  // Parse and check all jobs first
+  QList<BatchJob *> jobs;
+  bool valid = true, needsUserDB = false;
+  QTextStream stream(&file);
+  for (int line=1; ! stream.atEnd(); line++) {
+    QString text = stream.readLine().trimmed();
+    if (text.isEmpty() || text.startsWith('#'))
+      continue;
+    BatchJob *job = new BatchJob();
+    job->line = line; job->arguments = splitArguments(text);
+    job->status = -1; job->duration = 0;
+    setupParser(job->parser);
+    jobs.append(job);
+    if (! checkJob(*job))
+      valid = false;
+    else if ("encode-db" == job->parser.positionalArguments().at(0))
+      needsUserDB = true;
+  }
+  file.close();
+
+  if (! valid) {
+    qDeleteAll(jobs);
+    return -1;
+  }
+
+  // Load shared resources once
+  UserDatabase *userdb = nullptr;
+  if (needsUserDB) {
+    userdb = new UserDatabase();
+    if (! loadCallsignDB(*userdb)) {
+      delete userdb;
+      qDeleteAll(jobs);
+      return -1;
+    }
+  }
+
+  unsigned workers = QThread::idealThreadCount();
+  if (parser.isSet("jobs")) {
+    bool ok = true;
+    workers = parser.value("jobs").toUInt(&ok);
+    if ((! ok) || (0 == workers)) {
+      logError() << "Please specify a valid number of parallel jobs using the -j/--jobs option.";
+      delete userdb;
+      qDeleteAll(jobs);
+      return -1;
+    }
+  }
+  workers = std::max(1u, std::min(workers, unsigned(jobs.count())));
+
+  // Run jobs, each worker takes the next pending job
+  std::atomic<int> next(0);
+  // The cores are shared by the workers, limit the threads used within each job accordingly
+  unsigned threadsPerJob = std::max(1u, unsigned(QThread::idealThreadCount())/workers);
+  auto work = [&jobs, &next, &app, userdb, threadsPerJob]() {
+    ParallelRegion region(threadsPerJob);
+    for (int i=next++; i<jobs.count(); i=next++) {
+      QElapsedTimer timer; timer.start();
+      jobs[i]->status = runJob(*jobs[i], app, userdb);
+      jobs[i]->duration = timer.elapsed();
+    }
+  };
+
+  logDebug() << "Run " << jobs.count() << " jobs using " << workers << " workers.";
+  std::vector<std::thread> threads;
+  for (unsigned i=1; i<workers; i++)
+    threads.emplace_back(work);
+  work();
+  for (std::thread &thread: threads)
+    thread.join();
+
+  // Report exit status per job
+  int failed = 0;
+  QTextStream out(stdout);
+  foreach (BatchJob *job, jobs) {
+    out << (job->status ? "FAIL" : "OK  ") << " " << job->line << ": "
+        << job->arguments.join(" ") << " (" << job->duration << "ms)\n";
+    if (job->status)
+      failed++;
+  }
+  out << jobs.count()-failed << " of " << jobs.count() << " jobs succeeded.\n";
+  out.flush();
+
+  delete userdb;
+  qDeleteAll(jobs);
+
+  return (failed ? -1 : 0);
+}
@@ -0,0 +1,9 @@
+#ifndef BATCH_HH
+#define BATCH_HH
+
+class QCommandLineParser;
+class QCoreApplication;
+
+int batch(QCommandLineParser &parser, QCoreApplication &app);
+
+#endif // BATCH_HH
@@ -4,10 +4,13 @@
 #include <QCommandLineParser>
 #include <QFile>
 #include <QFileInfo>
+#include <QDir>
+#include <atomic>
 
 #include "logger.hh"
 #include "config.hh"
 #include "radioinfo.hh"
+#include "concurrency.hh"
 #include "md390_codeplug.hh"
 #include "md390_filereader.hh"
 #include "uv390_codeplug.hh"
@@ -26,31 +29,12 @@
 #include "d878uv2_codeplug.hh"
 #include "d578uv_codeplug.hh"
 
-int decodeCodeplug(QCommandLineParser &parser, QCoreApplication &app) {
-  Q_UNUSED(app);
-
-  if (2 > parser.positionalArguments().size())
-    parser.showHelp(-1);
-
-  QString filename = parser.positionalArguments().at(1);
+static int
+decodeFile(QCommandLineParser &parser, RadioInfo::Radio radio, const QString &filename,
+           const QString &output)
+{
   QString errorMessage;
   ErrorStack err;
-
-  if (! parser.isSet("radio")) {
-    logError() << "No radio type is specified! Use the --radio option.";
-    return -1;
-  }
-
-  if (! RadioInfo::hasRadioKey(parser.value("radio").toLower())) {
-    QStringList radios;
-    foreach (RadioInfo info, RadioInfo::allRadios())
-      radios.append(info.key());
-    logError() << "Unknown radio '" << parser.value("radio").toLower() << ".";
-    logError() << "Known radios " << radios.join(", ") << ".";
-    return -1;
-  }
-
-  RadioInfo::Radio radio = RadioInfo::byKey(parser.value("radio").toLower()).id();
   Config config;
 
   if (RadioInfo::MD390 == radio) {
@@ -249,8 +233,8 @@ int decodeCodeplug(QCommandLineParser &parser, QCoreApplication &app) {
     return -1;
   }
 
-  if (3 <= parser.positionalArguments().size()) {
-    QFileInfo info(parser.positionalArguments().at(2));
+  if (! output.isEmpty()) {
+    QFileInfo info(output);
     if (("conf" == info.suffix()) || ("csv" == info.suffix()) || parser.isSet("csv")) {
       logError() << "Export of the old table based format was disabled with 0.9.0. "
                     "Import still works.";
@@ -293,3 +277,62 @@ int decodeCodeplug(QCommandLineParser &parser, QCoreApplication &app) {
   return 0;
 }
 
+
+int decodeCodeplug(QCommandLineParser &parser, QCoreApplication &app) {
+  Q_UNUSED(app);
+
+  if (2 > parser.positionalArguments().size())
+    parser.showHelp(-1);
+
+  QString filename = parser.positionalArguments().at(1);
+
+  if (! parser.isSet("radio")) {
+    logError() << "No radio type is specified! Use the --radio option.";
+    return -1;
+  }
+
+  if (! RadioInfo::hasRadioKey(parser.value("radio").toLower())) {
+    QStringList radios;
+    foreach (RadioInfo info, RadioInfo::allRadios())
+      radios.append(info.key());
+    logError() << "Unknown radio '" << parser.value("radio").toLower() << ".";
+    logError() << "Known radios " << radios.join(", ") << ".";
+    return -1;
+  }
+
+  RadioInfo::Radio radio = RadioInfo::byKey(parser.value("radio").toLower()).id();
+  QString output;
+  if (3 <= parser.positionalArguments().size())
+    output = parser.positionalArguments().at(2);
+
+  if (! QFileInfo(filename).isDir())
+    return decodeFile(parser, radio, filename, output);
+
+  // Decode all files of the directory concurrently into YAML files within the output directory
+  if (output.isEmpty()) {
+    logError() << "Please specify an output directory to decode the codeplugs in '"
+               << filename << "' into.";
+    return -1;
+  }
+  QDir outdir(output);
+  if ((! outdir.exists()) && (! outdir.mkpath("."))) {
+    logError() << "Cannot create output directory '" << output << "'.";
+    return -1;
+  }
+
+  QFileInfoList files = QDir(filename).entryInfoList(QDir::Files, QDir::Name);
+  std::atomic<int> failed(0);
+  parallel_for(files.count(), [&parser, radio, &files, &outdir, &failed](unsigned first, unsigned last) {
+    for (unsigned i=first; i<last; i++) {
+      QString target = outdir.absoluteFilePath(files.at(i).completeBaseName() + ".yaml");
+      if (0 != decodeFile(parser, radio, files.at(i).filePath(), target))
+        failed++;
+    }
+  }, 1);
+
+  int nfailed = failed;
+  logInfo() << "Decoded " << files.count()-nfailed << " of " << files.count()
+            << " codeplugs into '" << outdir.absolutePath() << "'.";
+
+  return (nfailed ? -1 : 0);
+}
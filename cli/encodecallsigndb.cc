@@ -1,4 +1,4 @@
-#include "encodecodeplug.hh"
+#include "encodecallsigndb.hh"
 
 #include <QCoreApplication>
 #include <QCommandLineParser>
@@ -16,13 +16,7 @@
 #include "crc32.hh"
 
 
-int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
-  Q_UNUSED(app);
-
-  if (2 > parser.positionalArguments().size())
-    parser.showHelp(-1);
-
-  UserDatabase userdb;
+bool loadCallsignDB(UserDatabase &userdb) {
   if (0 == userdb.count()) {
     logInfo() << "Downloading call-sign DB...";
     // Wait for download to finish
@@ -33,10 +27,30 @@ int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
     // Check if call-sign DB has been loaded
     if (0 == userdb.count()) {
       logError() << "Could not download/load call-sign DB.";
-      return -1;
+      return false;
     }
   }
+  return true;
+}
+
+int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
+  if (2 > parser.positionalArguments().size())
+    parser.showHelp(-1);
 
+  UserDatabase userdb;
+  if (! loadCallsignDB(userdb))
+    return -1;
+
+  return encodeCallsignDB(parser, app, &userdb);
+}
+
+int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app, UserDatabase *userdb) {
+  Q_UNUSED(app);
+
+  if (2 > parser.positionalArguments().size())
+    parser.showHelp(-1);
+
+  CallsignDB::Selection selection;
   if (parser.isSet("id")) {
     QStringList prefixes_text = parser.value("id").split(",");
     QSet<unsigned> prefixes;
@@ -54,16 +68,15 @@ int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
     foreach (unsigned prefix, prefixes) {
       prefixes_text.append(QString::number(prefix));
     }
-    logDebug() << "Sort call-sign DB w.r.t. DMR ID(s) {" << prefixes_text.join(", ") << "}.";
-    userdb.sortUsers(prefixes);
+    logDebug() << "Select call-signs closest to DMR ID(s) {" << prefixes_text.join(", ") << "}.";
+    selection.setPreferredIds(prefixes);
   } else {
     logWarn() << "No ID is specified, a more or less random set of call-signs will be used "
-              << "if the radio cannot hold the entire call-sign DB of " << userdb.count()
+              << "if the radio cannot hold the entire call-sign DB of " << userdb->count()
               << " entries. Specify your DMR ID with --id=YOUR_DMR_ID. dmrconf will then "
               << "select those entries 'closest' to you. I.e., DMR IDs with the same prefix.";
   }
 
-  CallsignDB::Selection selection;
   if (parser.isSet("limit")) {
     bool ok=true;
     selection.setCountLimit(parser.value("limit").toUInt(&ok));
@@ -93,7 +106,7 @@ int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
 
   if (RadioInfo::UV390 == radio) {
     UV390CallsignDB db;
-    if (! db.encode(&userdb, selection, err)) {
+    if (! db.encode(userdb, selection, err)) {
       logError() << "Cannot encode call-sign DB: " << err.format();
       return -1;
     }
@@ -104,7 +117,7 @@ int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
     }
   } else if (RadioInfo::MD2017 == radio) {
     MD2017CallsignDB db;
-    if (! db.encode(&userdb, selection, err)) {
+    if (! db.encode(userdb, selection, err)) {
       logError() << "Cannot encode call-sign DB: " << err.format();
       return -1;
     }
@@ -115,7 +128,7 @@ int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
     }
   } else if (RadioInfo::OpenGD77 == radio) {
     OpenGD77CallsignDB db;
-    if (! db.encode(&userdb, selection, err)) {
+    if (! db.encode(userdb, selection, err)) {
       logError() << "Cannot encode call-sign DB: " << err.format();
       return -1;
     }
@@ -126,7 +139,7 @@ int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
     }
   } else if (RadioInfo::GD77 == radio) {
     GD77CallsignDB db;
-    if (! db.encode(&userdb, selection, err)) {
+    if (! db.encode(userdb, selection, err)) {
       logError() << "Cannot encode call-sign DB: " << err.format();
       return -1;
     }
@@ -137,7 +150,7 @@ int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
     }
   } else if ((RadioInfo::D868UVE == radio) || (RadioInfo::D878UV == radio)){
     D868UVCallsignDB db;
-    if (! db.encode(&userdb, selection, err)) {
+    if (! db.encode(userdb, selection, err)) {
       logError() << "Cannot encode call-sign DB: " << err.format();
       return -1;
     }
@@ -148,7 +161,7 @@ int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
     }
   } else if ((RadioInfo::D878UVII == radio) || (RadioInfo::D578UV == radio)){
     D878UV2CallsignDB db;
-    if (! db.encode(&userdb, selection, err)) {
+    if (! db.encode(userdb, selection, err)) {
       logError() << "Cannot encode call-sign DB: " << err.format();
       return -1;
     }
@@ -3,7 +3,10 @@
 
 class QCoreApplication;
 class QCommandLineParser;
+class UserDatabase;
 
+bool loadCallsignDB(UserDatabase &userdb);
 int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app);
+int encodeCallsignDB(QCommandLineParser &parser, QCoreApplication &app, UserDatabase *userdb);
 
 #endif // ENCODECALLSIGNDB_HH
@@ -0,0 +1,99 @@
+#include "options.hh"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+
+void setupParser(QCommandLineParser &parser) {
+  parser.setApplicationDescription(
+        QCoreApplication::translate(
+          "main", "Up- and download codeplugs for cheap Chineese DMR radios."));
+
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addOption({
+                     {"V","verbose"},
+                     QCoreApplication::translate("main", "Verbose output.")
+                   });
+  parser.addOption({
+                     {"c", "csv"},
+                     QCoreApplication::translate("main", "Up- and download codeplugs in CSV format.")
+                   });
+  parser.addOption({
+                     {"y", "yaml"},
+                     QCoreApplication::translate("main", "Up- and download codeplugs in extensible YAML format.")
+                   });
+  parser.addOption({
+                     {"b", "bin"},
+                     QCoreApplication::translate("main", "Up- and download codeplugs in binary format.")
+                   });
+  parser.addOption({
+                     {"m", "manufacturer"},
+                     QCoreApplication::translate("main", "Given file is manufacturer codeplug file. "
+                     " Can be used with 'decode'.")
+                   });
+  parser.addOption({
+                     {"D","device"},
+                     QCoreApplication::translate("main", "Specifies the device to use to talk to "
+                     "the radio. If not specified, the dmrconf will try to detect the radio "
+                     "automatically. Please note, that for some radios the device must be specified."),
+                     QCoreApplication::translate("main", "DEVICE")
+                   });
+  parser.addOption({
+                     {"R", "radio"},
+                     QCoreApplication::translate("main", "Specifies the radio. This option can also "
+                     "be used to override the auto-detection of radios. Be careful using this "
+                     "option when writing to the device. A incompatible code-plug might be written."),
+                     QCoreApplication::translate("main", "RADIO")
+                   });
+  parser.addOption({
+                     {"i", "id"},
+                     QCoreApplication::translate("main", "Specifies the DMR id."),
+                     QCoreApplication::translate("main", "ID")
+                   });
+  parser.addOption({
+                     {"n", "limit"},
+                     QCoreApplication::translate("main", "Limits several amonuts, depending on the "
+                     "context. When encoding/writing the callsign db, this option specifies the "
+                     "maximum number of callsigns to encode."),
+                     QCoreApplication::translate("main", "N")
+                   });
+  parser.addOption(QCommandLineOption(
+                     "init-codeplug",
+                     QCoreApplication::translate(
+                       "main", "Initializes the code-plug in the radio. If not present (default) "
+                               "the code-plug gets updated, maintining all settings made earlier.")));
+  parser.addOption(QCommandLineOption(
+                     "auto-enable-gps",
+                     QCoreApplication::translate("main", "Automatically enables GPS if there is a "
+                                                         "GPS/APRS system used by any channel.")));
+  parser.addOption(QCommandLineOption(
+                     "auto-enable-roaming",
+                     QCoreApplication::translate("main", "Automatically enables roaming if there is a "
+                                                         "roaming zone used by any channel.")));
+  parser.addOption(QCommandLineOption(
+                     "ignore-limits",
+                     QCoreApplication::translate("main", "Disables some limit checks.")));
+  parser.addOption({
+                     {"j", "jobs"},
+                     QCoreApplication::translate("main", "Specifies the number of jobs to run in "
+                     "parallel in batch mode. By default, one job per CPU core is run."),
+                     QCoreApplication::translate("main", "N")
+                   });
+  parser.addOption(QCommandLineOption(
+                     "list-radios",
+                     QCoreApplication::translate("main", "Lists all supported radios including the "
+                                                 "keys to be used with the --radio option.")));
+  parser.addPositionalArgument(
+        "command", QCoreApplication::translate(
+          "main", "Specifies the command to perform. Either detect, verify, read, write, "
+          "write-db, encode, encode-db, decode, info or batch. Consult the man-page of dmrconf for a "
+          "detailed descriptoin of these commands."),
+        QCoreApplication::translate("main", "[command]"));
+
+  parser.addPositionalArgument(
+        "file", QCoreApplication::translate(
+          "main", "The code-plug file. Either binary (extension .dfu), text/csv (extension .conf "
+          "or .csv) or YAML format (extension .yaml). The format can be forced using the --csv, "
+          "--yaml or --binary options."),
+        QCoreApplication::translate("main", "[filename]"));
+}
@@ -0,0 +1,8 @@
+#ifndef OPTIONS_HH
+#define OPTIONS_HH
+
+class QCommandLineParser;
+
+void setupParser(QCommandLineParser &parser);
+
+#endif // OPTIONS_HH
@@ -4,6 +4,8 @@
 #include <QString>
 #include <QFile>
 #include <QTextStream>
+#include <QMutex>
+#include <QHash>
 #include <iostream>
 
 #include "logger.hh"
@@ -22,6 +24,44 @@
 #include "d578uv.hh"
 
 
+const RadioLimits *radioLimits(const QString &radio) {
+  // Radios are kept for the lifetime of the process, such that the limits get assembled only once
+  // per model, even if many codeplugs are verified (see batch mode).
+  static QMutex lock;
+  static QHash<QString, Radio *> radios;
+
+  QMutexLocker locker(&lock);
+  if (radios.contains(radio))
+    return &radios[radio]->limits();
+
+  Radio *instance = nullptr;
+  if ("rd5r" == radio)
+    instance = new RD5R();
+  else if (("uv390" == radio) || ("rt3s" == radio))
+    instance = new UV390();
+  else if (("md2017" == radio) || ("rt82" == radio))
+    instance = new MD2017();
+  else if ("gd77" == radio)
+    instance = new GD77();
+  else if ("opengd77" == radio)
+    instance = new OpenGD77();
+  else if ("d868uv" == radio)
+    instance = new D868UV();
+  else if ("d878uv" == radio)
+    instance = new D878UV();
+  else if ("d878uv2" == radio)
+    instance = new D878UV2();
+  else if ("d578uv" == radio)
+    instance = new D578UV();
+  else
+    return nullptr;
+
+  // The instance may be created by a batch job, move it to the main thread
+  instance->moveToThread(QCoreApplication::instance()->thread());
+  radios.insert(radio, instance);
+  return &instance->limits();
+}
+
 int verify(QCommandLineParser &parser, QCoreApplication &app)
 {
   Q_UNUSED(app);
@@ -68,31 +108,15 @@ int verify(QCommandLineParser &parser, QCoreApplication &app)
     return 0;
   }
 
-  RadioLimitContext ctx;
-  QString radio = parser.value("radio").toLower();
-  if ("rd5r" == radio) {
-    RD5R radio; radio.limits().verifyConfig(&config, ctx);
-  } else if (("uv390" == radio) || ("rt3s" == radio)) {
-    UV390 radio; radio.limits().verifyConfig(&config, ctx);
-  } else if (("md2017" == radio) || ("rt82" == radio)) {
-    MD2017 radio; radio.limits().verifyConfig(&config, ctx);
-  } else if ("gd77" == radio) {
-    GD77 radio; radio.limits().verifyConfig(&config, ctx);
-  } else if ("opengd77" == radio) {
-    OpenGD77 radio; radio.limits().verifyConfig(&config, ctx);
-  } else if ("d868uv" == radio) {
-    D868UV radio; radio.limits().verifyConfig(&config, ctx);
-  } else if ("d878uv" == radio) {
-    D878UV radio; radio.limits().verifyConfig(&config, ctx);
-  } else if ("d878uv2" == radio) {
-    D878UV2 radio; radio.limits().verifyConfig(&config, ctx);
-  } else if ("d578uv" == radio) {
-    D578UV radio; radio.limits().verifyConfig(&config, ctx);
-  } else {
-    logError() << "Cannot verify code-plug against unknown radio '" << radio << "'.";
+  const RadioLimits *limits = radioLimits(parser.value("radio").toLower());
+  if (nullptr == limits) {
+    logError() << "Cannot verify code-plug against unknown radio '" << parser.value("radio") << "'.";
     return -1;
   }
 
+  RadioLimitContext ctx;
+  limits->verifyConfig(&config, ctx);
+
   bool valid = true;
   for (int i=0; i<ctx.count(); i++) {
     switch (ctx.message(i).severity()) {
@@ -3,7 +3,10 @@
 
 class QCommandLineParser;
 class QCoreApplication;
+class QString;
+class RadioLimits;
 
+const RadioLimits *radioLimits(const QString &radio);
 int verify(QCommandLineParser &parser, QCoreApplication &app);
 
 #endif // VERIFY_HH
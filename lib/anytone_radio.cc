@@ -93,10 +93,9 @@ AnytoneRadio::startUpload(Config *config, bool blocking, const Codeplug::Flags &
 
 bool
 AnytoneRadio::startUploadCallsignDB(UserDatabase *db, bool blocking, const CallsignDB::Selection &selection, const ErrorStack &err) {
-  Q_UNUSED(db);
-  Q_UNUSED(blocking);
-
-  _callsigns->encode(db, selection);
+  // Call-signs get selected and encoded within the radio thread
+  _userDB = db;
+  _selection = selection;
 
   _task = StatusUploadCallsigns;
   _errorStack = err;
@@ -165,6 +164,14 @@ AnytoneRadio::run() {
       return;
     }
 
+    if (! encodeCallsignDB(_callsigns)) {
+      _dev->reboot();
+      _dev->close();
+      _task = StatusError;
+      emit uploadError(this);
+      return;
+    }
+
     emit uploadStarted();
 
     if (! uploadCallsigns()) {
@@ -238,6 +245,8 @@ AnytoneRadio::upload() {
     return false;
   }
 
+  Codeplug::Preparation prepared(_codeplug, _config);
+
   // Download bitmaps first
   size_t nbitmaps = _codeplug->numImages();
   for (int n=0; n<_codeplug->image(0).numElements(); n++) {
@@ -271,7 +280,11 @@ AnytoneRadio::upload() {
   _codeplug->allocateForEncoding();
 
   // Update binary codeplug from config
-  if (! _codeplug->encode(_config, _codeplugFlags, _errorStack)) {
+  if (! prepared.wait(_errorStack)) {
+    errMsg(_errorStack) << "Cannot encode codeplug.";
+    return false;
+  }
+  if (! _codeplug->encodeElements(_codeplugFlags, prepared.context(), _errorStack)) {
     errMsg(_errorStack) << "Cannot encode codeplug.";
     return false;
   }
@@ -11,7 +11,7 @@ CallsignDB::Selection::Selection(int64_t count)
 }
 
 CallsignDB::Selection::Selection(const Selection &other)
-  : _count(other._count)
+  : _count(other._count), _preferredIds(other._preferredIds)
 {
   // pass...
 }
@@ -38,6 +38,32 @@ CallsignDB::Selection::clearCountLimit() {
   _count = -1;
 }
 
+bool
+CallsignDB::Selection::hasPreferredIds() const {
+  return ! _preferredIds.isEmpty();
+}
+
+const QSet<unsigned> &
+CallsignDB::Selection::preferredIds() const {
+  return _preferredIds;
+}
+
+void
+CallsignDB::Selection::setPreferredId(unsigned id) {
+  _preferredIds.clear();
+  _preferredIds.insert(id);
+}
+
+void
+CallsignDB::Selection::setPreferredIds(const QSet<unsigned> &ids) {
+  _preferredIds = ids;
+}
+
+void
+CallsignDB::Selection::clearPreferredIds() {
+  _preferredIds.clear();
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of CallsignDB
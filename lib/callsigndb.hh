@@ -2,6 +2,7 @@
 #define CALLSIGNDB_HH
 
 #include "dfufile.hh"
+#include <QSet>
 
 // Forward decl.
 class UserDatabase;
@@ -33,10 +34,25 @@ public:
     /** Clears the count limit. */
     void clearCountLimit();
 
+    /** Returns @c true if the callsigns closest to some preferred IDs should be selected. */
+    bool hasPreferredIds() const;
+    /** Returns the set of preferred IDs. If empty, the first callsigns of the database are
+     * selected. */
+    const QSet<unsigned> &preferredIds() const;
+    /** Selects the callsigns closest to the given ID. */
+    void setPreferredId(unsigned id);
+    /** Selects the callsigns closest to any of the given IDs. */
+    void setPreferredIds(const QSet<unsigned> &ids);
+    /** Clears the preferred IDs. */
+    void clearPreferredIds();
+
   protected:
     /** Specifies the maximum ammount of callsigns to add. If negative, the device limit should be
      * used. */
     int64_t _count;
+    /** The set of IDs, the selected callsigns should be closest to. The database itself is not
+     * reordered, the selection is performed by the encoder using @c UserDatabase::select. */
+    QSet<unsigned> _preferredIds;
   };
 
 protected:
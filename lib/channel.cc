@@ -14,6 +14,9 @@
 #include <QDoubleValidator>
 #include <QIntValidator>
 #include <cmath>
+#include <algorithm>
+#include <QCoreApplication>
+#include <mutex>
 #include "application.hh"
 #include <QCompleter>
 #include <QAbstractProxyModel>
@@ -28,15 +31,17 @@
 Channel::Channel(QObject *parent)
   : ConfigObject("ch", parent), _rxFreq(0), _txFreq(0), _defaultPower(true),
     _power(Power::Low), _txTimeOut(std::numeric_limits<unsigned>::max()), _rxOnly(false),
-    _vox(std::numeric_limits<unsigned>::max()), _scanlist(), _openGD77ChannelExtension(nullptr),
+    _vox(std::numeric_limits<unsigned>::max()), _scanlist(this), _openGD77ChannelExtension(nullptr),
     _tytChannelExtension(nullptr), _commercialExtension(nullptr)
 {
+  // References are children of the channel. Hence they are moved along with the channel to
+  // another thread, see Codeplug::createConcurrent.
   // Link scan list modification event (e.g., scan list gets deleted).
   connect(&_scanlist, SIGNAL(modified()), this, SLOT(onReferenceModified()));
 }
 
 Channel::Channel(const Channel &other, QObject *parent)
-  : ConfigObject("ch", parent), _scanlist(), _openGD77ChannelExtension(nullptr),
+  : ConfigObject("ch", parent), _scanlist(this), _openGD77ChannelExtension(nullptr),
     _tytChannelExtension(nullptr), _commercialExtension(nullptr)
 {
   copy(other);
@@ -347,14 +352,14 @@ AnalogChannel::AnalogChannel(QObject *parent)
   : Channel(parent),
     _admit(Admit::Always), _squelch(std::numeric_limits<unsigned>::max()),
     _rxTone(Signaling::SIGNALING_NONE), _txTone(Signaling::SIGNALING_NONE), _bw(Bandwidth::Narrow),
-    _aprsSystem()
+    _aprsSystem(this)
 {
   // Link APRS system reference
   connect(&_aprsSystem, SIGNAL(modified()), this, SLOT(onReferenceModified()));
 }
 
 AnalogChannel::AnalogChannel(const AnalogChannel &other, QObject *parent)
-  : Channel(parent), _aprsSystem()
+  : Channel(parent), _aprsSystem(this)
 {
   copy(other);
   // Link APRS system reference
@@ -591,7 +596,7 @@ AnalogChannel::parse(const YAML::Node &node, Context &ctx, const ErrorStack &err
 DigitalChannel::DigitalChannel(QObject *parent)
   : Channel(parent), _admit(Admit::Always),
     _colorCode(1), _timeSlot(TimeSlot::TS1),
-    _rxGroup(), _txContact(), _posSystem(), _roaming(), _radioId()
+    _rxGroup(this), _txContact(this), _posSystem(this), _roaming(this), _radioId(this)
 {
   // Register default tags
   if (! ConfigItem::Context::hasTag(metaObject()->className(), "roaming", "!default"))
@@ -608,7 +613,7 @@ DigitalChannel::DigitalChannel(QObject *parent)
 }
 
 DigitalChannel::DigitalChannel(const DigitalChannel &other, QObject *parent)
-  : Channel(parent), _rxGroup(), _txContact(), _posSystem(), _roaming(), _radioId()
+  : Channel(parent), _rxGroup(this), _txContact(this), _posSystem(this), _roaming(this), _radioId(this)
 {
   // Register default tags
   if (! ConfigItem::Context::hasTag(metaObject()->className(), "roaming", "!default"))
@@ -873,8 +878,13 @@ SelectedChannel::clone() const {
 
 SelectedChannel *
 SelectedChannel::get() {
-  if (nullptr == SelectedChannel::_instance)
+  // Thread-safe, see DefaultRadioID::get()
+  static std::once_flag once;
+  std::call_once(once, []() {
     SelectedChannel::_instance = new SelectedChannel();
+    if (QCoreApplication *app = QCoreApplication::instance())
+      SelectedChannel::_instance->moveToThread(app->thread());
+  });
   return SelectedChannel::_instance;
 }
 
@@ -883,7 +893,8 @@ SelectedChannel::get() {
  * Implementation of ChannelList
  * ********************************************************************************************* */
 ChannelList::ChannelList(QObject *parent)
-  : ConfigObjectList(Channel::staticMetaObject, parent)
+  : ConfigObjectList(Channel::staticMetaObject, parent), _indexValid(false), _digitalIndex(),
+    _analogIndex(), _indexKeys(), _positionsValid(false), _positions()
 {
   // pass...
 }
@@ -897,6 +908,30 @@ ChannelList::add(ConfigObject *obj, int row) {
   return ConfigObjectList::add(obj, row);
 }
 
+bool
+ChannelList::moveUp(int idx) {
+  _positionsValid = false;
+  return ConfigObjectList::moveUp(idx);
+}
+
+bool
+ChannelList::moveUp(int first, int last) {
+  _positionsValid = false;
+  return ConfigObjectList::moveUp(first, last);
+}
+
+bool
+ChannelList::moveDown(int idx) {
+  _positionsValid = false;
+  return ConfigObjectList::moveDown(idx);
+}
+
+bool
+ChannelList::moveDown(int first, int last) {
+  _positionsValid = false;
+  return ConfigObjectList::moveDown(first, last);
+}
+
 Channel *
 ChannelList::channel(int idx) const {
   if (ConfigItem *obj = get(idx))
@@ -906,32 +941,147 @@ ChannelList::channel(int idx) const {
 
 DigitalChannel *
 ChannelList::findDigitalChannel(double rx, double tx, DigitalChannel::TimeSlot ts, unsigned cc) const {
-  for (int i=0; i<count(); i++) {
-    if (! _items[i]->is<DigitalChannel>())
-      continue;
-    /// @bug I should certainly change the frequency handling to integer values!
-    if ( (1e-6<std::abs(channel(i)->txFrequency()-tx)) ||
-         (1e-6<std::abs(channel(i)->rxFrequency()-rx)) )
-      continue;
-    DigitalChannel *digi = channel(i)->as<DigitalChannel>();
-    if (digi->timeSlot() != ts)
-      continue;
-    if (digi->colorCode() != cc)
-      continue;
-    return digi;
+  updateIndex();
+  // Frequencies within 1Hz may be rounded to neighbouring keys
+  quint64 key = frequencyKey(rx, tx);
+  DigitalChannel *match = nullptr;
+  for (qint64 drx=-1; drx<=1; drx++) {
+    for (qint64 dtx=-1; dtx<=1; dtx++) {
+      quint64 probe = key + (drx<<32) + dtx;
+      QMultiHash<quint64, DigitalChannel *>::const_iterator it = _digitalIndex.constFind(probe);
+      for (; (it != _digitalIndex.constEnd()) && (it.key() == probe); it++) {
+        DigitalChannel *digi = it.value();
+        if ((digi->timeSlot() != ts) || (digi->colorCode() != cc) ||
+            (1e-6 <= std::abs(digi->txFrequency()-tx)) || (1e-6 <= std::abs(digi->rxFrequency()-rx)))
+          continue;
+        match = firstInList(match, digi);
+      }
+    }
   }
-  return nullptr;
+  return match;
 }
 
 AnalogChannel *
 ChannelList::findAnalogChannelByTxFreq(double freq) const {
-  for (int i=0; i<count(); i++) {
-    if (! channel(i)->is<AnalogChannel>())
-      continue;
-    if (1e-5 > std::abs(channel(i)->txFrequency()-freq))
-      return channel(i)->as<AnalogChannel>();
+  updateIndex();
+  // Frequencies within 10Hz may be rounded to any of the neighbouring keys
+  qint64 key = quint32(frequencyKey(0, freq));
+  AnalogChannel *match = nullptr;
+  for (qint64 probe=std::max(qint64(0), key-10); probe<=(key+10); probe++) {
+    QMultiHash<quint32, AnalogChannel *>::const_iterator it = _analogIndex.constFind(quint32(probe));
+    for (; (it != _analogIndex.constEnd()) && (it.key() == quint32(probe)); it++) {
+      if (1e-5 <= std::abs(it.value()->txFrequency()-freq))
+        continue;
+      match = firstInList(match, it.value());
+    }
   }
-  return nullptr;
+  return match;
+}
+
+template <class T>
+T *
+ChannelList::firstInList(T *a, T *b) const {
+  if (nullptr == a)
+    return b;
+  if (nullptr == b)
+    return a;
+  // Resolve ambiguities by the position within the list
+  updatePositions();
+  return (_positions.value(b) < _positions.value(a)) ? b : a;
+}
+
+quint64
+ChannelList::frequencyKey(double rx, double tx) {
+  quint64 rxHz = quint32(std::round(std::max(0.0, rx)*1e6));
+  quint64 txHz = quint32(std::round(std::max(0.0, tx)*1e6));
+  return (rxHz << 32) | txHz;
+}
+
+void
+ChannelList::updateIndex() const {
+  if (_indexValid)
+    return;
+  _digitalIndex.clear();
+  _analogIndex.clear();
+  _indexKeys.clear();
+  for (int i=0; i<count(); i++)
+    indexChannel(channel(i));
+  _indexValid = true;
+}
+
+void
+ChannelList::updatePositions() const {
+  if (_positionsValid)
+    return;
+  _positions.clear();
+  _positions.reserve(count());
+  for (int i=0; i<count(); i++)
+    _positions.insert(channel(i), i);
+  _positionsValid = true;
+}
+
+void
+ChannelList::indexChannel(Channel *ch) const {
+  quint64 key = frequencyKey(ch->rxFrequency(), ch->txFrequency());
+  _indexKeys.insert(ch, key);
+  if (DigitalChannel *digi = ch->as<DigitalChannel>())
+    _digitalIndex.insert(key, digi);
+  else if (AnalogChannel *analog = ch->as<AnalogChannel>())
+    _analogIndex.insert(quint32(key), analog);
+}
+
+void
+ChannelList::unindexChannel(Channel *ch) const {
+  if (! _indexKeys.contains(ch))
+    return;
+  quint64 key = _indexKeys.take(ch);
+  if (DigitalChannel *digi = ch->as<DigitalChannel>())
+    _digitalIndex.remove(key, digi);
+  else if (AnalogChannel *analog = ch->as<AnalogChannel>())
+    _analogIndex.remove(quint32(key), analog);
+}
+
+void
+ChannelList::signalAdded(int idx) {
+  // Keep the index up-to-date, also during bulk updates
+  onChannelAdded(idx);
+  ConfigObjectList::signalAdded(idx);
+}
+
+void
+ChannelList::signalModified(int idx) {
+  onChannelModified(idx);
+  ConfigObjectList::signalModified(idx);
+}
+
+void
+ChannelList::signalRemoved(int idx) {
+  onChannelRemoved(idx);
+  ConfigObjectList::signalRemoved(idx);
+}
+
+void
+ChannelList::onChannelAdded(int idx) {
+  _positionsValid = false;
+  if (_indexValid)
+    indexChannel(channel(idx));
+}
+
+void
+ChannelList::onChannelModified(int idx) {
+  if (! _indexValid)
+    return;
+  Channel *ch = channel(idx);
+  unindexChannel(ch);
+  indexChannel(ch);
+}
+
+void
+ChannelList::onChannelRemoved(int idx) {
+  Q_UNUSED(idx);
+  // The removed channel may be deleted already, rebuild the index with the next lookup.
+  _indexValid = false;
+  _positionsValid = false;
 }
 
 ConfigItem *
@@ -223,7 +223,7 @@ public:
 
 public:
   /** Constructs a new empty analog channel. */
-  explicit AnalogChannel(QObject *parent=nullptr);
+  Q_INVOKABLE explicit AnalogChannel(QObject *parent=nullptr);
   /** Copy constructor. */
   AnalogChannel(const AnalogChannel &other, QObject *parent=nullptr);
 
@@ -342,7 +342,7 @@ public:
 
 public:
   /** Constructs a new empty digital (DMR) channel. */
-  DigitalChannel(QObject *parent=nullptr);
+  Q_INVOKABLE DigitalChannel(QObject *parent=nullptr);
   /** Copy constructor. */
   DigitalChannel(const DigitalChannel &other, QObject *parent=nullptr);
 
@@ -460,7 +460,7 @@ public:
   bool copy(const ConfigItem &other);
   ConfigItem *clone() const;
 
-  /** Constructs/gets the singleton instance. */
+  /** Constructs/gets the singleton instance. May be called from any thread. */
   static SelectedChannel *get();
 
 protected:
@@ -485,16 +485,66 @@ public:
 	explicit ChannelList(QObject *parent=nullptr);
 
   int add(ConfigObject *obj, int row=-1);
+  bool moveUp(int idx);
+  bool moveUp(int first, int last);
+  bool moveDown(int idx);
+  bool moveDown(int first, int last);
 
   /** Gets the channel at the specified index. */
   Channel *channel(int idx) const;
-  /** Finds a digial channel with the given frequencies, time slot and color code. */
+  /** Finds a digial channel with the given frequencies, time slot and color code.
+   * Frequencies are matched with a tolerance of 1Hz. If there are several matching channels, the
+   * first one in the list is returned. */
   DigitalChannel *findDigitalChannel(double rx, double tx, DigitalChannel::TimeSlot ts, unsigned cc) const;
-  /** Finds an analog channel with the given frequeny. */
+  /** Finds an analog channel with the given TX frequeny.
+   * The frequency is matched with a tolerance of 10Hz. If there are several matching channels, the
+   * first one in the list is returned. */
   AnalogChannel *findAnalogChannelByTxFreq(double freq) const;
 
 public:
   ConfigItem *allocateChild(const YAML::Node &node, ConfigItem::Context &ctx, const ErrorStack &err=ErrorStack());
+
+protected:
+  /** Returns the index key for the given RX and TX frequencies in MHz. */
+  static quint64 frequencyKey(double rx, double tx);
+  /** Rebuilds the frequency index if needed. */
+  void updateIndex() const;
+  /** Adds the given channel to the frequency index. */
+  void indexChannel(Channel *ch) const;
+  /** Removes the given channel from the frequency index. */
+  void unindexChannel(Channel *ch) const;
+  /** Rebuilds the position table if needed. */
+  void updatePositions() const;
+  /** Returns the one of the given channels that comes first in the list. Either may be
+   * @c nullptr. */
+  template <class T>
+  T *firstInList(T *a, T *b) const;
+
+  void signalAdded(int idx);
+  void signalModified(int idx);
+  void signalRemoved(int idx);
+
+  /** Updates the frequency index if a channel was added. */
+  void onChannelAdded(int idx);
+  /** Updates the frequency index if a channel was modified. */
+  void onChannelModified(int idx);
+  /** Invalidates the frequency index if a channel was removed. */
+  void onChannelRemoved(int idx);
+
+protected:
+  /** If @c false, the frequency index gets rebuilt with the next lookup. */
+  mutable bool _indexValid;
+  /** Frequency index of all digital channels. Maps the RX and TX frequencies in Hz (upper and
+   * lower 32bit) to the channels. */
+  mutable QMultiHash<quint64, DigitalChannel *> _digitalIndex;
+  /** Frequency index of all analog channels. Maps the TX frequency in Hz to the channels. */
+  mutable QMultiHash<quint32, AnalogChannel *> _analogIndex;
+  /** The keys under which each channel is indexed. */
+  mutable QHash<Channel *, quint64> _indexKeys;
+  /** If @c false, the position table gets rebuilt with the next ambiguous lookup. */
+  mutable bool _positionsValid;
+  /** Maps each channel to its position within the list. */
+  mutable QHash<Channel *, int> _positions;
 };
 
 
@@ -1,7 +1,12 @@
 #include "codeplug.hh"
 #include "config.hh"
 #include <QtEndian>
+#include <atomic>
+#include <algorithm>
+#include <QMutex>
+#include <QMutexLocker>
 #include "logger.hh"
+#include "utils.hh"
 
 
 /* ********************************************************************************************* *
@@ -56,6 +61,21 @@ Codeplug::Element::fill(uint8_t value, unsigned offset, int size) {
   return true;
 }
 
+bool
+Codeplug::Element::checkLayoutSize(size_t size) const {
+  if (_size >= size)
+    return true;
+  logFatal() << "Codeplug element of size " << QString::number(_size, 16)
+             << " cannot hold a layout of size " << QString::number(size, 16) << ".";
+  return false;
+}
+
+void
+Codeplug::Element::fieldOverflow(size_t end) const {
+  logFatal() << "Cannot access field ending at " << QString::number(end, 16)
+             << " in codeplug element of size " << QString::number(_size, 16) << ": Overflow.";
+}
+
 bool
 Codeplug::Element::getBit(unsigned offset, unsigned bit) const {
   if (offset >= _size) {
@@ -445,10 +465,7 @@ Codeplug::Element::getBCD8_be(unsigned offset) const {
     return 0;
   }
 
-  uint32_t val = getUInt32_be(offset);
-  return (val & 0xf) + ((val>>4) & 0xf)*10 + ((val>>8) & 0xf)*100 + ((val>>12) & 0xf)*1000 +
-      ((val>>16) & 0xf)*10000 + ((val>>20) & 0xf)*100000 + ((val>>24) & 0xf)*1000000 +
-      ((val>>28) & 0xf)*10000000;
+  return decode_bcd8(getUInt32_be(offset));
 }
 void
 Codeplug::Element::setBCD8_be(unsigned offset, uint32_t val) {
@@ -457,15 +474,7 @@ Codeplug::Element::setBCD8_be(unsigned offset, uint32_t val) {
     return;
   }
 
-  uint32_t a  = (val / 10000000) % 10;
-  uint32_t b  = (val /  1000000) % 10;
-  uint32_t c  = (val /   100000) % 10;
-  uint32_t d  = (val /    10000) % 10;
-  uint32_t e  = (val /     1000) % 10;
-  uint32_t f  = (val /      100) % 10;
-  uint32_t g  = (val /       10) % 10;
-  uint32_t h  = (val /        1) % 10;
-  setUInt32_be(offset, (a << 28) + (b << 24) + (c << 20) + (d << 16) + (e << 12) + (f << 8) + (g << 4) + h);
+  setUInt32_be(offset, encode_bcd8(val));
 }
 uint32_t
 Codeplug::Element::getBCD8_le(unsigned offset) const {
@@ -474,10 +483,7 @@ Codeplug::Element::getBCD8_le(unsigned offset) const {
     return 0;
   }
 
-  uint32_t val = getUInt32_le(offset);
-  return (val & 0xf) + ((val>>4) & 0xf)*10 + ((val>>8) & 0xf)*100 + ((val>>12) & 0xf)*1000 +
-      ((val>>16) & 0xf)*10000 + ((val>>20) & 0xf)*100000 + ((val>>24) & 0xf)*1000000 +
-      ((val>>28) & 0xf)*10000000;
+  return decode_bcd8(getUInt32_le(offset));
 }
 void
 Codeplug::Element::setBCD8_le(unsigned offset, uint32_t val) {
@@ -486,63 +492,36 @@ Codeplug::Element::setBCD8_le(unsigned offset, uint32_t val) {
     return;
   }
 
-  uint32_t a  = (val / 10000000) % 10;
-  uint32_t b  = (val /  1000000) % 10;
-  uint32_t c  = (val /   100000) % 10;
-  uint32_t d  = (val /    10000) % 10;
-  uint32_t e  = (val /     1000) % 10;
-  uint32_t f  = (val /      100) % 10;
-  uint32_t g  = (val /       10) % 10;
-  uint32_t h  = (val /        1) % 10;
-  setUInt32_le(offset, (a << 28) + (b << 24) + (c << 20) + (d << 16) + (e << 12) + (f << 8) + (g << 4) + h);
+  setUInt32_le(offset, encode_bcd8(val));
 }
 
 QString
 Codeplug::Element::readASCII(unsigned offset, unsigned maxlen, uint8_t eos) const {
-  QString txt;
-  uint8_t *ptr = (uint8_t *)(_data+offset);
-  for (unsigned i=0; (i<maxlen)&&(ptr[i])&&(eos!=ptr[i]); i++) {
-    txt.append(QChar::fromLatin1(ptr[i]));
-  }
-  return txt;
+  return decode_ascii(_data+offset, maxlen, eos);
 }
 void
 Codeplug::Element::writeASCII(unsigned offset, const QString &txt, unsigned maxlen, uint8_t eos) {
-  uint8_t *ptr = (uint8_t *)(_data+offset);
-  for (unsigned i=0; i<maxlen; i++) {
-    if (i < unsigned(txt.length()))
-      ptr[i] = txt.at(i).toLatin1();
-    else
-      ptr[i] = eos;
-  }
+  encode_ascii(_data+offset, txt, maxlen, eos);
 }
 
 QString
 Codeplug::Element::readUnicode(unsigned offset, unsigned maxlen, uint16_t eos) const {
-  QString txt;
-  uint16_t *ptr = (uint16_t *)(_data+offset);
-  for (unsigned i=0; (i<maxlen)&&(eos!=ptr[i]); i++) {
-    txt.append(QChar(ptr[i]));
-  }
-  return txt;
+  return decode_unicode((const uint16_t *)(_data+offset), maxlen, eos);
 }
 void
 Codeplug::Element::writeUnicode(unsigned offset, const QString &txt, unsigned maxlen, uint16_t eos) {
-  uint16_t *ptr = (uint16_t *)(_data+offset);
-  for (unsigned i=0; i<maxlen; i++) {
-    if (i < unsigned(txt.length()))
-      ptr[i] = txt.at(i).unicode();
-    else
-      ptr[i] = eos;
-  }
+  encode_unicode((uint16_t *)(_data+offset), txt, maxlen, eos);
 }
 
 
 /* ********************************************************************************************* *
  * Implementation of CodePlug::Context
  * ********************************************************************************************* */
+// Indices below this limit are stored in the dense tables, any larger index is stored in a hash.
+#define CONTEXT_MAX_DENSE_INDEX 0x10000
+
 Codeplug::Context::Context(Config *config)
-  : _config(config), _tables()
+  : _config(config), _tables(), _typeTables(), _indices()
 {
   // Add tables for common elements
   addTable(&DMRRadioID::staticMetaObject);
@@ -562,61 +541,154 @@ Codeplug::Context::config() const {
   return _config;
 }
 
-bool
-Codeplug::Context::hasTable(const QMetaObject *obj) const {
-  // Find a matching table
-  if (_tables.contains(obj->className()))
-    return true;
-  else if (obj->superClass())
-    return hasTable(obj->superClass());
-  return false;
+unsigned
+Codeplug::Context::typeId(const QMetaObject *type) {
+  static QMutex lock;
+  static QHash<const QMetaObject *, unsigned> ids;
+  QMutexLocker locker(&lock);
+  if (! ids.contains(type))
+    ids.insert(type, ids.size());
+  return ids[type];
 }
 
-Codeplug::Context::Table &
-Codeplug::Context::getTable(const QMetaObject *obj) {
-  if (_tables.contains(obj->className()))
-    return _tables[obj->className()];
-  return getTable(obj->superClass());
+int
+Codeplug::Context::tableIndex(unsigned typeId) const {
+  if (typeId >= unsigned(_typeTables.size()))
+    return -1;
+  return _typeTables[typeId];
+}
+
+int
+Codeplug::Context::tableIndex(const QMetaObject *type) const {
+  // Find a matching table, walks up the class hierarchy
+  for (; nullptr != type; type = type->superClass()) {
+    int idx = tableIndex(typeId(type));
+    if (0 <= idx)
+      return idx;
+  }
+  return -1;
+}
+
+bool
+Codeplug::Context::hasTable(const QMetaObject *obj) const {
+  return 0 <= tableIndex(obj);
 }
 
 bool
 Codeplug::Context::addTable(const QMetaObject *obj) {
   if (hasTable(obj))
     return false;
-  _tables.insert(obj->className(), Table());
+  unsigned id = typeId(obj);
+  while (id >= unsigned(_typeTables.size()))
+    _typeTables.append(-1);
+  _typeTables[id] = _tables.size();
+  _tables.append(Table());
   return true;
 }
 
+void
+Codeplug::Context::reserve(const QMetaObject *type, unsigned count) {
+  int table = tableIndex(type);
+  if (0 > table)
+    return;
+  _tables[table].objects.reserve(std::min(count, unsigned(CONTEXT_MAX_DENSE_INDEX)));
+}
+
+ConfigItem *
+Codeplug::Context::obj(const QMetaObject *elementType, unsigned idx) const {
+  int table = tableIndex(elementType);
+  if (0 > table)
+    return nullptr;
+  const Table &t = _tables[table];
+  if (idx < unsigned(t.objects.size()))
+    return t.objects[idx];
+  return t.sparse.value(idx, nullptr);
+}
+
 ConfigItem *
-Codeplug::Context::obj(const QMetaObject *elementType, unsigned idx) {
-  if (! hasTable(elementType))
+Codeplug::Context::obj(unsigned typeId, const QMetaObject *elementType, unsigned idx) const {
+  int table = tableIndex(typeId);
+  // If not cached, search class hierarchy
+  if (0 > table)
+    table = tableIndex(elementType);
+  if (0 > table)
     return nullptr;
-  return getTable(elementType).objects.value(idx, nullptr);
+  const Table &t = _tables[table];
+  if (idx < unsigned(t.objects.size()))
+    return t.objects[idx];
+  return t.sparse.value(idx, nullptr);
 }
 
 int
-Codeplug::Context::index(ConfigItem *obj) {
+Codeplug::Context::index(ConfigItem *obj) const {
   if (nullptr == obj)
     return -1;
-  if (! hasTable(obj->metaObject()))
-    return -1;
-  return getTable(obj->metaObject()).indices.value(obj, -1);
+  return _indices.value(obj, -1);
 }
 
 bool
 Codeplug::Context::add(ConfigItem *obj, unsigned idx) {
-  if (!hasTable(obj->metaObject()))
+  if (nullptr == obj)
     return false;
-  if (getTable(obj->metaObject()).indices.contains(obj))
+  int table = tableIndex(obj->metaObject());
+  if (0 > table)
     return false;
-  if (getTable(obj->metaObject()).objects.contains(idx))
+  if (_indices.contains(obj))
     return false;
-  getTable(obj->metaObject()).objects.insert(idx, obj);
-  getTable(obj->metaObject()).indices.insert(obj, idx);
+  Table &t = _tables[table];
+  if (idx < CONTEXT_MAX_DENSE_INDEX) {
+    if (idx >= unsigned(t.objects.size()))
+      t.objects.resize(idx+1);
+    if (nullptr != t.objects[idx])
+      return false;
+    t.objects[idx] = obj;
+  } else {
+    if (t.sparse.contains(idx))
+      return false;
+    t.sparse.insert(idx, obj);
+  }
+  _indices.insert(obj, idx);
+  // Cache table for the concrete type, to speed-up later lookups
+  unsigned id = typeId(obj->metaObject());
+  while (id >= unsigned(_typeTables.size()))
+    _typeTables.append(-1);
+  if (0 > _typeTables[id])
+    _typeTables[id] = table;
   return true;
 }
 
 
+/* ********************************************************************************************* *
+ * Implementation of Codeplug::Preparation
+ * ********************************************************************************************* */
+Codeplug::Preparation::Preparation(const Codeplug *codeplug, Config *config)
+  : _context(config), _err(), _success(false), _result()
+{
+  _result = std::async(std::launch::async, [this, codeplug, config]() {
+    return codeplug->prepareEncoding(config, _context, _err);
+  });
+}
+
+Codeplug::Preparation::~Preparation() {
+  if (_result.valid())
+    _result.wait();
+}
+
+bool
+Codeplug::Preparation::wait(const ErrorStack &err) {
+  if (_result.valid())
+    _success = _result.get();
+  if (! _success)
+    err.take(_err);
+  return _success;
+}
+
+Codeplug::Context &
+Codeplug::Preparation::context() {
+  return _context;
+}
+
+
 /* ********************************************************************************************* *
  * Implementation of CodePlug
  * ********************************************************************************************* */
@@ -629,3 +701,15 @@ Codeplug::Codeplug(QObject *parent)
 Codeplug::~Codeplug() {
 	// pass...
 }
+
+bool
+Codeplug::prepareEncoding(Config *config, Context &ctx, const ErrorStack &err) const {
+  return index(config, ctx, err);
+}
+
+bool
+Codeplug::encodeElements(const Flags &flags, Context &ctx, const ErrorStack &err) {
+  Q_UNUSED(flags); Q_UNUSED(ctx);
+  errMsg(err) << "Cannot encode codeplug elements: Not implemented for this codeplug.";
+  return false;
+}
@@ -3,9 +3,16 @@
 
 #include <QObject>
 #include "dfufile.hh"
+#include "codeplugfield.hh"
 #include "userdatabase.hh"
 #include <QHash>
+#include <QThread>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include "config.hh"
+#include "concurrency.hh"
 
 //class Config;
 class ConfigItem;
@@ -169,6 +176,36 @@ public:
      * The stored string gets padded with @c eos to @c maxlen. */
     void writeUnicode(unsigned offset, const QString &txt, unsigned maxlen, uint16_t eos=0x0000);
 
+    /** Decodes the given field (see @c CodeplugLayout). The field bounds are checked at compile
+     * time against the layout of the element. Only the end of the field gets checked against the
+     * actual element size. If the field exceeds the element, a default value is returned. */
+    template <class Field>
+    inline typename Field::Type getField() const {
+      if (Q_UNLIKELY(Field::End > _size)) {
+        fieldOverflow(Field::End);
+        return typename Field::Type();
+      }
+      return Field::get(_data);
+    }
+    /** Encodes the given field (see @c CodeplugLayout). If the field exceeds the element, nothing
+     * is written. */
+    template <class Field>
+    inline void setField(const typename Field::Type &value) {
+      if (Q_UNLIKELY(Field::End > _size)) {
+        fieldOverflow(Field::End);
+        return;
+      }
+      Field::set(_data, value);
+    }
+
+  protected:
+    /** Checks that the element is large enough to hold a layout of the given size. Elements
+     * accessing their fields via @c getField and @c setField should call this once on construction
+     * to report a mismatching layout early. */
+    bool checkLayoutSize(size_t size) const;
+    /** Reports a field access past the end of the element. */
+    void fieldOverflow(size_t end) const;
+
   protected:
     /** Holds the pointer to the element. */
     uint8_t *_data;
@@ -181,6 +218,12 @@ public:
    * be indexed in a separate index. By default tables for @c DigitalContact, @c RXGroupList,
    * @c Channel, @c Zone and @c ScanList are defined. For any other type, an additional table must
    * be defined first using @c addTable.
+   *
+   * The index and linking lookups are performed within the innermost loops of all encoders and
+   * decoders. Hence each table holds a dense vector mapping indices to objects and all tables share
+   * a single flat map from objects to indices. Element types are identified by small integer IDs
+   * obtained once per type from @c T::staticMetaObject, such that typed lookups via @c get and
+   * @c has do not require any string hashing.
    * @since 0.9.0 */
   class Context
   {
@@ -193,49 +236,106 @@ public:
 
     /** Resolves the given index for the specifies element type.
      * @returns @c nullptr if the index is not defined or the type is unknown. */
-    ConfigItem *obj(const QMetaObject *elementType, unsigned idx);
+    ConfigItem *obj(const QMetaObject *elementType, unsigned idx) const;
     /** Returns the index for the given object.
      * @returns -1 if no index is associated with the object or its type is unknown. */
-    int index(ConfigItem *obj);
+    int index(ConfigItem *obj) const;
     /** Associates the given object with the given index. */
     bool add(ConfigItem *obj, unsigned idx);
 
     /** Adds a table for the given type. */
     bool addTable(const QMetaObject *obj);
+    /** Reserves space for objects of the given type with indices below @c count. */
+    void reserve(const QMetaObject *type, unsigned count);
 
     /** Returns the object associated by the given index and type. */
     template <class T>
-    T* get(unsigned idx) {
-      return this->obj(&(T::staticMetaObject), idx)->template as<T>();
+    T* get(unsigned idx) const {
+      ConfigItem *item = this->obj(typeId<T>(), &(T::staticMetaObject), idx);
+      if (nullptr == item)
+        return nullptr;
+      return item->template as<T>();
     }
 
     /** Returns @c true, if the given index is defined for the specified type. */
     template <class T>
-    bool has(unsigned idx) {
-      return nullptr != this->obj(&(T::staticMetaObject), idx)->template as<T>();
+    bool has(unsigned idx) const {
+      return nullptr != this->get<T>(idx);
+    }
+
+  public:
+    /** Returns a process-wide unique and dense ID for the given type. */
+    static unsigned typeId(const QMetaObject *type);
+    /** Returns a process-wide unique and dense ID for the given type.
+     * The ID gets resolved only once per type. */
+    template <class T>
+    static unsigned typeId() {
+      static const unsigned id = typeId(&T::staticMetaObject);
+      return id;
     }
 
   protected:
-    /** Internal used table type to associate objects and indices. */
+    /** Internal used table type to associate indices with objects. */
     class Table {
     public:
-      /** The index->object map. */
-      QHash<unsigned, ConfigItem *> objects;
-      /** The object->index map. */
-      QHash<ConfigItem *, unsigned> indices;
+      /** The dense index->object map. */
+      QVector<ConfigItem *> objects;
+      /** Holds objects with indices beyond the dense range. */
+      QHash<unsigned, ConfigItem *> sparse;
     };
 
   protected:
+    /** Resolves the given index for the specified type ID. Falls back to the class hierarchy of
+     * the given type, if the type ID is not associated with a table directly. */
+    ConfigItem *obj(unsigned typeId, const QMetaObject *elementType, unsigned idx) const;
+    /** Returns the table index for the given type ID or -1 if there is no table. */
+    int tableIndex(unsigned typeId) const;
+    /** Returns the table index for the given type or -1 if there is no table. */
+    int tableIndex(const QMetaObject *type) const;
     /** Returns @c true if a table is defined for the given type. */
     bool hasTable(const QMetaObject *obj) const;
-    /** Returns a reference to the table for the given type. */
-    Table &getTable(const QMetaObject *obj);
 
   protected:
     /** A weak reference to the config object. */
     Config *_config;
     /** Table of tables. */
-    QHash<QString, Table> _tables;
+    QVector<Table> _tables;
+    /** Maps type IDs to table indices (-1 if not resolved yet or no table exists). */
+    QVector<int> _typeTables;
+    /** The flat object->index map shared by all tables. */
+    QHash<ConfigItem *, unsigned> _indices;
+  };
+
+  /** Prepares the encoding of a configuration on a background thread, see @c prepareEncoding.
+   *
+   * This allows to check and index the configuration during an upload, while the current codeplug
+   * is read back from the device. The destructor waits for the background thread. Hence it is
+   * joined on every return path of the upload.
+   * @since 0.10.2 */
+  class Preparation
+  {
+  public:
+    /** Starts preparing the encoding of the given configuration. */
+    Preparation(const Codeplug *codeplug, Config *config);
+    /** Waits for the preparation to finish. */
+    ~Preparation();
+
+    /** Waits for the preparation to finish. Returns @c false and passes the errors to @c err, if
+     * the preparation failed. */
+    bool wait(const ErrorStack &err=ErrorStack());
+    /** Returns the prepared context. Only valid after @c wait succeeded. */
+    Context &context();
+
+  protected:
+    /** The context being prepared. */
+    Context _context;
+    /** The errors of the preparation. */
+    ErrorStack _err;
+    /** The result of the preparation, @c true on success. */
+    bool _success;
+    /** The background preparation, must be the last member. Hence it gets joined before any
+     * other member gets destroyed. */
+    std::future<bool> _result;
   };
 
 protected:
@@ -258,6 +358,100 @@ public:
   /** Encodes a given abstract configuration (@c config) to the device specific binary code-plug.
    * This must be implemented by the device-specific codeplug. */
   virtual bool encode(Config *config, const Flags &flags=Flags(), const ErrorStack &err=ErrorStack()) = 0;
+
+  /** Prepares the encoding of the given configuration. That is, the configuration gets checked and
+   * all objects get indexed within the given context. This method does not access the binary
+   * codeplug. Hence it may run concurrently to the read-back of the current codeplug from the
+   * device during an upload. The default implementation just calls @c index.
+   * @since 0.10.2 */
+  virtual bool prepareEncoding(Config *config, Context &ctx, const ErrorStack &err=ErrorStack()) const;
+  /** Encodes the configuration into the binary codeplug using the context prepared by
+   * @c prepareEncoding. The default implementation fails.
+   * @since 0.10.2 */
+  virtual bool encodeElements(const Flags &flags, Context &ctx, const ErrorStack &err=ErrorStack());
+
+protected:
+  /** Creates the config objects for up to @c count codeplug elements concurrently.
+   *
+   * The @c create function gets called (possibly from several threads) once for every element
+   * index and may return @c nullptr to skip that element. It must not modify the config or the
+   * context. The created objects are collected in per-thread staging slices, moved to the calling
+   * thread and finally passed to @c commit in index order on the calling thread. Hence, @c commit
+   * may add the objects to the config and the context. If given, @c reserve gets called with the
+   * number of created objects before the first call to @c commit, to preallocate the storage
+   * the objects get committed to.
+   * @since 0.10.2 */
+  template <class T>
+  static void createConcurrent(unsigned count, const std::function<T *(unsigned idx)> &create,
+                               const std::function<void(unsigned idx, T *obj)> &commit,
+                               const std::function<void(unsigned n)> &reserve=nullptr)
+  {
+    QThread *owner = QThread::currentThread();
+    QVector<T *> staging(count, nullptr);
+    T **objs = staging.data();
+    parallel_for(count, [&create, objs, owner](unsigned first, unsigned last) {
+      for (unsigned i=first; i<last; i++) {
+        if (T *obj = create(i)) {
+          obj->moveToThread(owner);
+          objs[i] = obj;
+        }
+      }
+    });
+    if (reserve)
+      reserve(std::count_if(staging.begin(), staging.end(), [](T *obj) { return nullptr != obj; }));
+    // Merge staged objects in index order
+    for (unsigned i=0; i<count; i++) {
+      if (nullptr != objs[i])
+        commit(i, objs[i]);
+    }
+  }
+
+  /** Links the config objects for up to @c count codeplug elements concurrently.
+   *
+   * The @c object function gets called on the calling thread for every element index and returns
+   * the object to link or @c nullptr to skip that element. The @c link function then gets called
+   * (possibly from several threads) once for every object. It may only modify the given object and
+   * must not modify the config or context.
+   *
+   * Signals emitted on the worker threads would be queued to the thread owning the objects and
+   * delivered long after the decoding finished. Hence the signals of the objects and their
+   * children (e.g., references) are blocked while linking. Instead, @c modified gets emitted for
+   * every linked object on the calling thread afterwards. Within a @c Config::beginUpdate, these
+   * are merged into a single reset of the list. Returns @c false if any call to @c link returned
+   * @c false.
+   * @since 0.10.2 */
+  template <class T>
+  static bool linkConcurrent(unsigned count, const std::function<T *(unsigned idx)> &object,
+                             const std::function<bool(unsigned idx, T *obj)> &link)
+  {
+    QVector<T *> objs(count, nullptr);
+    QList<QObject *> blocked;
+    for (unsigned i=0; i<count; i++) {
+      if (nullptr == (objs[i] = object(i)))
+        continue;
+      blocked.append(objs[i]);
+      blocked.append(objs[i]->template findChildren<QObject *>());
+    }
+    foreach (QObject *obj, blocked)
+      obj->blockSignals(true);
+
+    std::atomic<bool> success(true);
+    T **items = objs.data();
+    parallel_for(count, [&link, &success, items](unsigned first, unsigned last) {
+      for (unsigned i=first; i<last; i++) {
+        if ((nullptr != items[i]) && (! link(i, items[i])))
+          success = false;
+      }
+    });
+
+    foreach (QObject *obj, blocked)
+      obj->blockSignals(false);
+    foreach (T *obj, objs) {
+      if (nullptr != obj)
+        emit obj->modified(obj);
+    }
+    return success;
+  }
 };
 
 #endif // CODEPLUG_HH
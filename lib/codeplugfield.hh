@@ -0,0 +1,225 @@
+#ifndef CODEPLUGFIELD_HH
+#define CODEPLUGFIELD_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <QString>
+
+
+/** Compile-time descriptors of fields within codeplug elements.
+ *
+ * Each field is a type describing the location (byte offset, bit offset and width), the byte
+ * order and the encoding of a single member of an encoded element. The type provides the
+ * decoded value type as @c Type and inlinable static @c get and @c set methods operating on the
+ * raw element memory. The element layout is declared once as a list of field types (see
+ * @c CodeplugLayout) instead of repeating magic offsets in every accessor. As all offsets are
+ * known at compile time, the bounds get checked by the compiler and no runtime check is needed
+ * per access.
+ *
+ * @ingroup util */
+namespace CodeplugField {
+
+/** Possible byte orders of multi-byte fields. */
+enum Endian {
+  LittleEndian, ///< Least significant byte first.
+  BigEndian     ///< Most significant byte first.
+};
+
+/** An unsigned integer of @c Width bits starting at bit @c Bit within the byte at @c Offset. */
+template <unsigned Offset, unsigned Bit, unsigned Width>
+struct Bits {
+  static_assert((0 < Width) && ((Bit+Width) <= 8), "Bit-field must not span several bytes.");
+  /** The decoded value type. */
+  typedef uint8_t Type;
+  /** The first byte past the field. */
+  static constexpr size_t End = Offset+1;
+  /** The bit mask of the field (unshifted). */
+  static constexpr uint8_t Mask = uint8_t((1u<<Width)-1);
+
+  /** Decodes the field. */
+  static inline Type get(const uint8_t *data) {
+    return (data[Offset] >> Bit) & Mask;
+  }
+  /** Encodes the field. */
+  static inline void set(uint8_t *data, Type value) {
+    data[Offset] = (data[Offset] & ~uint8_t(Mask << Bit)) | uint8_t((value & Mask) << Bit);
+  }
+};
+
+/** A single bit flag. If @c Inverted is @c true, a cleared bit means the flag is set. */
+template <unsigned Offset, unsigned Bit, bool Inverted=false>
+struct Flag {
+  static_assert(Bit < 8, "Bit index out of range.");
+  /** The decoded value type. */
+  typedef bool Type;
+  /** The first byte past the field. */
+  static constexpr size_t End = Offset+1;
+
+  /** Decodes the field. */
+  static inline Type get(const uint8_t *data) {
+    return bool((data[Offset] >> Bit) & 1) != Inverted;
+  }
+  /** Encodes the field. */
+  static inline void set(uint8_t *data, Type value) {
+    if (value != Inverted)
+      data[Offset] |= uint8_t(1u << Bit);
+    else
+      data[Offset] &= ~uint8_t(1u << Bit);
+  }
+};
+
+/** An unsigned integer of @c Bytes bytes (1-4) at the given offset and byte order. */
+template <unsigned Offset, unsigned Bytes, Endian Order=LittleEndian>
+struct UInt {
+  static_assert((0 < Bytes) && (4 >= Bytes), "Unsupported integer size.");
+  /** The decoded value type. */
+  typedef uint32_t Type;
+  /** The first byte past the field. */
+  static constexpr size_t End = Offset+Bytes;
+
+  /** Decodes the field. */
+  static inline Type get(const uint8_t *data) {
+    Type value = 0;
+    for (unsigned i=0; i<Bytes; i++)
+      value |= Type(data[Offset + ((LittleEndian == Order) ? i : (Bytes-1-i))]) << (8*i);
+    return value;
+  }
+  /** Encodes the field. */
+  static inline void set(uint8_t *data, Type value) {
+    for (unsigned i=0; i<Bytes; i++)
+      data[Offset + ((LittleEndian == Order) ? i : (Bytes-1-i))] = (value >> (8*i)) & 0xff;
+  }
+};
+
+/** A BCD encoded unsigned integer of @c Bytes bytes (2 digits per byte) at the given offset and
+ * byte order. */
+template <unsigned Offset, unsigned Bytes, Endian Order=LittleEndian>
+struct BCD {
+  static_assert((0 < Bytes) && (4 >= Bytes), "Unsupported BCD size.");
+  /** The decoded value type. */
+  typedef uint32_t Type;
+  /** The first byte past the field. */
+  static constexpr size_t End = Offset+Bytes;
+
+  /** Decodes the field. */
+  static inline Type get(const uint8_t *data) {
+    Type value = 0;
+    for (unsigned i=0; i<Bytes; i++) {
+      uint8_t byte = data[Offset + ((LittleEndian == Order) ? (Bytes-1-i) : i)];
+      value = value*100 + (byte >> 4)*10 + (byte & 0xf);
+    }
+    return value;
+  }
+  /** Encodes the field. */
+  static inline void set(uint8_t *data, Type value) {
+    for (unsigned i=0; i<Bytes; i++) {
+      data[Offset + ((LittleEndian == Order) ? i : (Bytes-1-i))] =
+          (((value/10) % 10) << 4) | (value % 10);
+      value /= 100;
+    }
+  }
+};
+
+/** A string of up to @c Length 8bit characters, padded with @c Eos. */
+template <unsigned Offset, unsigned Length, uint8_t Eos=0x00>
+struct ASCII {
+  /** The decoded value type. */
+  typedef QString Type;
+  /** The first byte past the field. */
+  static constexpr size_t End = Offset+Length;
+
+  /** Decodes the field. */
+  static inline Type get(const uint8_t *data) {
+    const uint8_t *ptr = data+Offset;
+    QString txt;
+    for (unsigned i=0; (i<Length) && ptr[i] && (Eos != ptr[i]); i++)
+      txt.append(QChar::fromLatin1(ptr[i]));
+    return txt;
+  }
+  /** Encodes the field. */
+  static inline void set(uint8_t *data, const Type &txt) {
+    uint8_t *ptr = data+Offset;
+    for (unsigned i=0; i<Length; i++)
+      ptr[i] = (i < unsigned(txt.length())) ? txt.at(i).toLatin1() : Eos;
+  }
+};
+
+/** A string of up to @c Length 16bit (little-endian) characters, padded with @c Eos. */
+template <unsigned Offset, unsigned Length, uint16_t Eos=0x0000>
+struct Unicode {
+  /** The decoded value type. */
+  typedef QString Type;
+  /** The first byte past the field. */
+  static constexpr size_t End = Offset+2*Length;
+
+  /** Decodes the field. */
+  static inline Type get(const uint8_t *data) {
+    QString txt;
+    for (unsigned i=0; i<Length; i++) {
+      uint16_t c = UInt<Offset, 2>::get(data+2*i);
+      if (Eos == c)
+        break;
+      txt.append(QChar(c));
+    }
+    return txt;
+  }
+  /** Encodes the field. */
+  static inline void set(uint8_t *data, const Type &txt) {
+    for (unsigned i=0; i<Length; i++)
+      UInt<Offset, 2>::set(data+2*i, (i < unsigned(txt.length())) ? txt.at(i).unicode() : Eos);
+  }
+};
+
+}
+
+
+/** Declares the layout of a codeplug element of @c Size bytes.
+ *
+ * Elements declare their fields as members of their layout. Each field gets checked at compile
+ * time to be within the element. For example
+ * @code
+ * typedef CodeplugLayout<0x40> Layout;
+ * typedef Layout::BCD<16, 4> RXFrequency;
+ * @endcode
+ * declares a 4-byte little-endian BCD field at offset 16 within a 64-byte element. The field can
+ * then be accessed using @c Codeplug::Element::getField and @c Codeplug::Element::setField.
+ *
+ * @ingroup util */
+template <size_t ElementSize>
+struct CodeplugLayout {
+  /** The size of the element in bytes. */
+  static constexpr size_t Size = ElementSize;
+
+  /** Bounds-checked @c CodeplugField::Bits. */
+  template <unsigned Offset, unsigned Bit, unsigned Width>
+  struct Bits: CodeplugField::Bits<Offset, Bit, Width> {
+    static_assert(Offset < Size, "Field exceeds element.");
+  };
+  /** Bounds-checked @c CodeplugField::Flag. */
+  template <unsigned Offset, unsigned Bit, bool Inverted=false>
+  struct Flag: CodeplugField::Flag<Offset, Bit, Inverted> {
+    static_assert(Offset < Size, "Field exceeds element.");
+  };
+  /** Bounds-checked @c CodeplugField::UInt. */
+  template <unsigned Offset, unsigned Bytes, CodeplugField::Endian Order=CodeplugField::LittleEndian>
+  struct UInt: CodeplugField::UInt<Offset, Bytes, Order> {
+    static_assert((Offset+Bytes) <= Size, "Field exceeds element.");
+  };
+  /** Bounds-checked @c CodeplugField::BCD. */
+  template <unsigned Offset, unsigned Bytes, CodeplugField::Endian Order=CodeplugField::LittleEndian>
+  struct BCD: CodeplugField::BCD<Offset, Bytes, Order> {
+    static_assert((Offset+Bytes) <= Size, "Field exceeds element.");
+  };
+  /** Bounds-checked @c CodeplugField::ASCII. */
+  template <unsigned Offset, unsigned Length, uint8_t Eos=0x00>
+  struct ASCII: CodeplugField::ASCII<Offset, Length, Eos> {
+    static_assert((Offset+Length) <= Size, "Field exceeds element.");
+  };
+  /** Bounds-checked @c CodeplugField::Unicode. */
+  template <unsigned Offset, unsigned Length, uint16_t Eos=0x0000>
+  struct Unicode: CodeplugField::Unicode<Offset, Length, Eos> {
+    static_assert((Offset+2*Length) <= Size, "Field exceeds element.");
+  };
+};
+
+#endif // CODEPLUGFIELD_HH
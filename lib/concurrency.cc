@@ -0,0 +1,68 @@
+#include "concurrency.hh"
+#include <QThread>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+
+/** Maximum number of threads parallel_for may use on the current thread, 0 means no limit. */
+static thread_local unsigned threadLimit = 0;
+
+
+ParallelRegion::ParallelRegion(unsigned threads)
+  : _previous(threadLimit)
+{
+  threadLimit = std::max(1u, threads);
+}
+
+ParallelRegion::~ParallelRegion() {
+  threadLimit = _previous;
+}
+
+
+unsigned
+parallel_chunks(unsigned count, unsigned minChunkSize) {
+  if (0 == count)
+    return 0;
+  unsigned maxChunks = std::max(1, QThread::idealThreadCount());
+  if (threadLimit)
+    maxChunks = std::min(maxChunks, threadLimit);
+  unsigned chunks = (count + std::max(1u, minChunkSize) - 1)/std::max(1u, minChunkSize);
+  return std::max(1u, std::min(maxChunks, chunks));
+}
+
+void
+parallel_for(unsigned count, const std::function<void(unsigned, unsigned)> &body, unsigned minChunkSize) {
+  unsigned chunks = parallel_chunks(count, minChunkSize);
+  if (0 == chunks)
+    return;
+
+  // If there is only one chunk, process it on the calling thread
+  if (1 == chunks) {
+    body(0, count);
+    return;
+  }
+
+  unsigned chunkSize = (count + chunks - 1)/chunks;
+  std::vector<std::thread> workers;
+  workers.reserve(chunks-1);
+  for (unsigned c=1; c<chunks; c++) {
+    unsigned first = c*chunkSize, last = std::min(count, first+chunkSize);
+    if (first >= last)
+      break;
+    workers.emplace_back([&body, first, last]() {
+      // Nested calls run on this worker
+      ParallelRegion region(1);
+      body(first, last);
+    });
+  }
+
+  // Process first chunk on the calling thread
+  {
+    ParallelRegion region(1);
+    body(0, std::min(count, chunkSize));
+  }
+
+  for (std::thread &worker: workers)
+    worker.join();
+}
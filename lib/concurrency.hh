@@ -0,0 +1,48 @@
+#ifndef CONCURRENCY_HH
+#define CONCURRENCY_HH
+
+#include <functional>
+
+/** Splits the index range [0, count) into contiguous chunks and processes these chunks
+ * concurrently. This function blocks until all chunks are processed.
+ *
+ * The number of chunks is limited by @c QThread::idealThreadCount() as well as by
+ * @c minChunkSize, such that small ranges get processed on the calling thread without spawning
+ * any additional threads. The @c body is called once for each chunk with the first index and the
+ * index past the last element of that chunk. The first chunk is always processed on the calling
+ * thread. Calls nested within the @c body of another @c parallel_for process their range on the
+ * calling thread, see also @c ParallelRegion.
+ *
+ * @note The @c body must not modify any state shared between the chunks without proper
+ *       synchronization. In particular, any @c QObject created within the @c body is owned by the
+ *       worker thread and must be moved explicitly (see @c QObject::moveToThread).
+ *
+ * @ingroup util */
+void parallel_for(unsigned count, const std::function<void(unsigned first, unsigned last)> &body,
+                  unsigned minChunkSize=64);
+
+/** Returns the number of chunks, @c parallel_for will split a range of @c count elements into. */
+unsigned parallel_chunks(unsigned count, unsigned minChunkSize=64);
+
+/** Limits the number of threads used by @c parallel_for on the calling thread, for the lifetime of
+ * this instance.
+ *
+ * Code running on several threads already (e.g., the jobs of a batch) should share the cores
+ * with any @c parallel_for called within. Otherwise, each of the N threads would spawn up to N
+ * additional threads.
+ *
+ * @ingroup util */
+class ParallelRegion
+{
+public:
+  /** Limits @c parallel_for on the calling thread to the given number of threads (at least 1). */
+  explicit ParallelRegion(unsigned threads);
+  /** Restores the previous limit. */
+  ~ParallelRegion();
+
+private:
+  /** The previous limit. */
+  unsigned _previous;
+};
+
+#endif // CONCURRENCY_HH
@@ -30,27 +30,35 @@ Config::Config(QObject *parent)
   connect(_radioIDs, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
   connect(_radioIDs, SIGNAL(elementRemoved(int)), this, SLOT(onConfigModified()));
   connect(_radioIDs, SIGNAL(elementModified(int)), this, SLOT(onConfigModified()));
+  connect(_radioIDs, SIGNAL(elementsReset()), this, SLOT(onConfigModified()));
   connect(_contacts, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
   connect(_contacts, SIGNAL(elementRemoved(int)), this, SLOT(onConfigModified()));
   connect(_contacts, SIGNAL(elementModified(int)), this, SLOT(onConfigModified()));
+  connect(_contacts, SIGNAL(elementsReset()), this, SLOT(onConfigModified()));
   connect(_rxGroupLists, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
   connect(_rxGroupLists, SIGNAL(elementRemoved(int)), this, SLOT(onConfigModified()));
   connect(_rxGroupLists, SIGNAL(elementModified(int)), this, SLOT(onConfigModified()));
+  connect(_rxGroupLists, SIGNAL(elementsReset()), this, SLOT(onConfigModified()));
   connect(_channels, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
   connect(_channels, SIGNAL(elementRemoved(int)), this, SLOT(onConfigModified()));
   connect(_channels, SIGNAL(elementModified(int)), this, SLOT(onConfigModified()));
+  connect(_channels, SIGNAL(elementsReset()), this, SLOT(onConfigModified()));
   connect(_zones, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
   connect(_zones, SIGNAL(elementRemoved(int)), this, SLOT(onConfigModified()));
   connect(_zones, SIGNAL(elementModified(int)), this, SLOT(onConfigModified()));
+  connect(_zones, SIGNAL(elementsReset()), this, SLOT(onConfigModified()));
   connect(_scanlists, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
   connect(_scanlists, SIGNAL(elementRemoved(int)), this, SLOT(onConfigModified()));
   connect(_scanlists, SIGNAL(elementModified(int)), this, SLOT(onConfigModified()));
+  connect(_scanlists, SIGNAL(elementsReset()), this, SLOT(onConfigModified()));
   connect(_gpsSystems, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
   connect(_gpsSystems, SIGNAL(elementRemoved(int)), this, SLOT(onConfigModified()));
   connect(_gpsSystems, SIGNAL(elementModified(int)), this, SLOT(onConfigModified()));
+  connect(_gpsSystems, SIGNAL(elementsReset()), this, SLOT(onConfigModified()));
   connect(_roaming, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
   connect(_roaming, SIGNAL(elementRemoved(int)), this, SLOT(onConfigModified()));
   connect(_roaming, SIGNAL(elementModified(int)), this, SLOT(onConfigModified()));
+  connect(_roaming, SIGNAL(elementsReset()), this, SLOT(onConfigModified()));
 }
 
 bool
@@ -59,6 +67,7 @@ Config::copy(const ConfigItem &other) {
   if ((nullptr==conf) || (! ConfigItem::copy(other)))
     return false;
 
+  beginUpdate();
   _settings->copy(*conf->settings());
   _radioIDs->copy(*conf->radioIDs());
   _contacts->copy(*conf->contacts());
@@ -68,6 +77,7 @@ Config::copy(const ConfigItem &other) {
   _scanlists->copy(*conf->scanlists());
   _gpsSystems->copy(*conf->posSystems());
   _roaming->copy(*conf->roaming());
+  endUpdate();
 
   return true;
 }
@@ -238,6 +248,7 @@ Config::clear() {
   ConfigItem::clear();
 
   // Reset lists
+  beginUpdate();
   _settings->clear();
   _radioIDs->clear();
   _contacts->clear();
@@ -247,10 +258,35 @@ Config::clear() {
   _scanlists->clear();
   _gpsSystems->clear();
   _roaming->clear();
+  endUpdate();
 
   emit modified(this);
 }
 
+void
+Config::beginUpdate() {
+  _radioIDs->beginUpdate();
+  _contacts->beginUpdate();
+  _rxGroupLists->beginUpdate();
+  _channels->beginUpdate();
+  _zones->beginUpdate();
+  _scanlists->beginUpdate();
+  _gpsSystems->beginUpdate();
+  _roaming->beginUpdate();
+}
+
+void
+Config::endUpdate() {
+  _radioIDs->endUpdate();
+  _contacts->endUpdate();
+  _rxGroupLists->endUpdate();
+  _channels->endUpdate();
+  _zones->endUpdate();
+  _scanlists->endUpdate();
+  _gpsSystems->endUpdate();
+  _roaming->endUpdate();
+}
+
 const Config *
 Config::config() const {
   return this;
@@ -310,7 +346,10 @@ Config::readCSV(const QString &filename, QString &errorMessage) {
 bool
 Config::readCSV(QTextStream &stream, QString &errorMessage)
 {
-  if (CSVReader::read(this, stream, errorMessage))
+  beginUpdate();
+  bool ok = CSVReader::read(this, stream, errorMessage);
+  endUpdate();
+  if (ok)
     _modified = false;
   else
     return false;
@@ -333,16 +372,13 @@ Config::readYAML(const QString &filename, const ErrorStack &err) {
     return false;
   }
 
+  beginUpdate();
   clear();
   ConfigItem::Context context;
+  bool ok = parse(node, context, err) && link(node, context, err);
+  endUpdate();
 
-  if (! parse(node, context, err))
-    return false;
-
-  if (! link(node, context, err))
-    return false;
-
-  return true;
+  return ok;
 }
 
 bool
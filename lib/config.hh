@@ -130,6 +130,12 @@ public:
   /** Clears the complete configuration. */
   void clear();
 
+  /** Starts a bulk update of all lists of the configuration, see
+   * @c AbstractConfigObjectList::beginUpdate. */
+  void beginUpdate();
+  /** Finishes a bulk update of all lists of the configuration. */
+  void endUpdate();
+
   const Config *config() const;
 
   /** Returns the encryption settings extension.
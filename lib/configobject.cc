@@ -4,6 +4,7 @@
 
 #include <QMetaProperty>
 #include <QMetaEnum>
+#include <QMutexLocker>
 
 // Helper function to extract key names for a QMetaEnum
 inline QStringList enumKeys(const QMetaEnum &e) {
@@ -31,6 +32,8 @@ QHash<QString, QHash<QString, ConfigObject *>> ConfigObject::Context::_tagObject
     QHash<QString, QHash<QString, ConfigObject *>>();
 QHash<QString, QHash<ConfigObject *, QString>> ConfigObject::Context::_tagNames =
     QHash<QString, QHash<ConfigObject *, QString>>();
+QMutex ConfigObject::Context::_tagLock;
+QMutex ConfigObject::_referrerLock;
 
 ConfigItem::Context::Context()
   : _version(), _objects(), _ids()
@@ -82,18 +85,21 @@ ConfigItem::Context::add(const QString &id, ConfigObject *obj) {
 
 bool
 ConfigItem::Context::hasTag(const QString &className, const QString &property, const QString &tag) {
+  QMutexLocker locker(&_tagLock);
   QString qname = className+"::"+property;
   return _tagObjects.contains(qname) && _tagObjects[qname].contains(tag);
 }
 
 bool
 ConfigItem::Context::hasTag(const QString &className, const QString &property, ConfigObject *obj) {
+  QMutexLocker locker(&_tagLock);
   QString qname = className+"::"+property;
   return _tagNames.contains(qname) && _tagNames[qname].contains(obj);
 }
 
 ConfigObject *
 ConfigItem::Context::getTag(const QString &className, const QString &property, const QString &tag) {
+  QMutexLocker locker(&_tagLock);
   //logDebug() << "Request " << tag << " for " << property << " in " << className << ".";
   QString qname = className+"::"+property;
   if (! _tagObjects.contains(qname))
@@ -103,6 +109,7 @@ ConfigItem::Context::getTag(const QString &className, const QString &property, c
 
 QString
 ConfigItem::Context::getTag(const QString &className, const QString &property, ConfigObject *obj) {
+  QMutexLocker locker(&_tagLock);
   //logDebug() << "Request tag for " << property << " in " << className << ".";
   QString qname = className+"::"+property;
   if (! _tagNames.contains(qname))
@@ -112,6 +119,7 @@ ConfigItem::Context::getTag(const QString &className, const QString &property, C
 
 void
 ConfigItem::Context::setTag(const QString &className, const QString &property, const QString &tag, ConfigObject *obj) {
+  QMutexLocker locker(&_tagLock);
   //logDebug() << "Register tag " << tag << " for " << property << " in " << className << ".";
   QString qname = className+"::"+property;
   if (! _tagObjects.contains(qname))
@@ -872,6 +880,22 @@ ConfigObject::ConfigObject(const QString &name, const QString &idBase, QObject *
   // pass...
 }
 
+ConfigObject::~ConfigObject() {
+  // Take the reverse index first, the referrers will not unregister themself from this object.
+  QSet<ConfigObjectReference *> references;
+  QSet<ConfigObjectRefList *> lists;
+  {
+    QMutexLocker locker(&_referrerLock);
+    references.swap(_references);
+    lists.swap(_referringLists);
+  }
+  // Clear all references to this object, this is O(number of referrers).
+  foreach (ConfigObjectReference *ref, references)
+    ref->onReferenceDeleted(this);
+  foreach (ConfigObjectRefList *list, lists)
+    list->onElementDeleted(this);
+}
+
 const QString &
 ConfigObject::name() const {
   return _name;
@@ -885,6 +909,48 @@ ConfigObject::setName(const QString &name) {
   emit modified(this);
 }
 
+bool
+ConfigObject::isReferenced() const {
+  QMutexLocker locker(&_referrerLock);
+  return (! _references.isEmpty()) || (! _referringLists.isEmpty());
+}
+
+QList<ConfigObjectReference *>
+ConfigObject::references() const {
+  QMutexLocker locker(&_referrerLock);
+  return _references.values();
+}
+
+QList<ConfigObjectRefList *>
+ConfigObject::referringLists() const {
+  QMutexLocker locker(&_referrerLock);
+  return _referringLists.values();
+}
+
+void
+ConfigObject::addReferrer(ConfigObjectReference *ref) {
+  QMutexLocker locker(&_referrerLock);
+  _references.insert(ref);
+}
+
+void
+ConfigObject::remReferrer(ConfigObjectReference *ref) {
+  QMutexLocker locker(&_referrerLock);
+  _references.remove(ref);
+}
+
+void
+ConfigObject::addReferrer(ConfigObjectRefList *list) {
+  QMutexLocker locker(&_referrerLock);
+  _referringLists.insert(list);
+}
+
+void
+ConfigObject::remReferrer(ConfigObjectRefList *list) {
+  QMutexLocker locker(&_referrerLock);
+  _referringLists.remove(list);
+}
+
 bool
 ConfigObject::label(ConfigObject::Context &context, const ErrorStack &err) {
   // With empty ID base, skip labeling.
@@ -950,23 +1016,25 @@ ConfigExtension::ConfigExtension(QObject *parent)
  * Implementation of AbstractConfigObjectList
  * ********************************************************************************************* */
 AbstractConfigObjectList::AbstractConfigObjectList(const QMetaObject &elementType, QObject *parent)
-  : QObject(parent), _elementTypes(), _items()
+  : QObject(parent), _elementTypes(), _items(), _updateDepth(0), _updateChanged(false)
 {
   _elementTypes.append(elementType);
 }
 
 AbstractConfigObjectList::AbstractConfigObjectList(const std::initializer_list<QMetaObject> &elementTypes, QObject *parent)
-  : QObject(parent), _elementTypes(elementTypes), _items()
+  : QObject(parent), _elementTypes(elementTypes), _items(), _updateDepth(0), _updateChanged(false)
 {
   // pass...
 }
 
 bool
 AbstractConfigObjectList::copy(const AbstractConfigObjectList &other) {
+  beginUpdate();
   this->clear();
   _elementTypes = other._elementTypes;
   foreach (ConfigObject *item, other._items)
     add(item);
+  endUpdate();
   return true;
 }
 
@@ -975,6 +1043,11 @@ AbstractConfigObjectList::count() const {
   return _items.count();
 }
 
+void
+AbstractConfigObjectList::reserve(int n) {
+  _items.reserve(n);
+}
+
 int
 AbstractConfigObjectList::indexOf(ConfigObject *obj) const {
   return _items.indexOf(obj);
@@ -982,10 +1055,13 @@ AbstractConfigObjectList::indexOf(ConfigObject *obj) const {
 
 void
 AbstractConfigObjectList::clear() {
+  beginUpdate();
   for (int i=(count()-1); i>=0; i--) {
     _items.pop_back();
-    emit elementRemoved(i);
+    signalRemoved(i);
   }
+  _pending.clear();
+  endUpdate();
 }
 
 const Config *
@@ -1033,10 +1109,14 @@ int AbstractConfigObjectList::add(ConfigObject *obj, int row) {
     return -1;
   }
   _items.insert(row, obj);
-  // Otherwise connect to object
-  connect(obj, SIGNAL(destroyed(QObject*)), this, SLOT(onElementDeleted(QObject*)));
+  // Otherwise connect to object. Modifications are tracked immediately, as some lists keep
+  // lookup indices that must remain valid during updates.
   connect(obj, SIGNAL(modified(ConfigItem*)), this, SLOT(onElementModified(ConfigItem*)));
-  emit elementAdded(row);
+  if (isUpdating())
+    _pending.insert(obj);
+  else
+    attach(obj);
+  signalAdded(row);
   return row;
 }
 
@@ -1049,7 +1129,8 @@ AbstractConfigObjectList::take(ConfigObject *obj) {
   if (0 > idx)
     return false;
   _items.remove(idx, 1);
-  emit elementRemoved(idx);
+  _pending.remove(obj);
+  signalRemoved(idx);
   // Otherwise disconnect from
   disconnect(obj, nullptr, this, nullptr);
   return true;
@@ -1060,6 +1141,100 @@ AbstractConfigObjectList::del(ConfigObject *obj) {
   return take(obj);
 }
 
+int
+AbstractConfigObjectList::addMany(const QList<ConfigObject *> &objs, int row) {
+  int n = 0;
+  beginUpdate();
+  _items.reserve(_items.count()+objs.count());
+  foreach (ConfigObject *obj, objs) {
+    int idx = add(obj, row);
+    if (0 > idx)
+      continue;
+    if (0 <= row)
+      row = idx+1;
+    n++;
+  }
+  endUpdate();
+  return n;
+}
+
+int
+AbstractConfigObjectList::delMany(const QList<ConfigObject *> &objs) {
+  int n = 0;
+  beginUpdate();
+  foreach (ConfigObject *obj, objs) {
+    if (0 > indexOf(obj))
+      continue;
+    del(obj);
+    n++;
+  }
+  endUpdate();
+  return n;
+}
+
+void
+AbstractConfigObjectList::beginUpdate() {
+  if (0 == _updateDepth++)
+    _updateChanged = false;
+}
+
+void
+AbstractConfigObjectList::endUpdate() {
+  if ((0 == _updateDepth) || (0 != --_updateDepth))
+    return;
+  // Attach elements added during the update in list order
+  if (! _pending.isEmpty()) {
+    foreach (ConfigObject *obj, _items) {
+      if (_pending.contains(obj))
+        attach(obj);
+    }
+    _pending.clear();
+  }
+  if (_updateChanged)
+    emit elementsReset();
+  _updateChanged = false;
+}
+
+bool
+AbstractConfigObjectList::isUpdating() const {
+  return 0 < _updateDepth;
+}
+
+void
+AbstractConfigObjectList::attach(ConfigObject *obj) {
+  Q_UNUSED(obj);
+  // pass...
+}
+
+bool
+AbstractConfigObjectList::isPending(ConfigObject *obj) const {
+  return _pending.contains(obj);
+}
+
+void
+AbstractConfigObjectList::signalAdded(int idx) {
+  if (isUpdating())
+    _updateChanged = true;
+  else
+    emit elementAdded(idx);
+}
+
+void
+AbstractConfigObjectList::signalModified(int idx) {
+  if (isUpdating())
+    _updateChanged = true;
+  else
+    emit elementModified(idx);
+}
+
+void
+AbstractConfigObjectList::signalRemoved(int idx) {
+  if (isUpdating())
+    _updateChanged = true;
+  else
+    emit elementRemoved(idx);
+}
+
 bool
 AbstractConfigObjectList::moveUp(int row) {
   if ((row <= 0) || (row>=count()))
@@ -1111,8 +1286,8 @@ AbstractConfigObjectList::classNames() const {
 void
 AbstractConfigObjectList::onElementModified(ConfigItem *obj) {
   int idx = indexOf(obj->as<ConfigObject>());
-  if (0 >= idx)
-    emit elementModified(idx);
+  if (0 <= idx)
+    signalModified(idx);
 }
 
 void
@@ -1122,7 +1297,7 @@ AbstractConfigObjectList::onElementDeleted(QObject *obj) {
   int idx = indexOf(reinterpret_cast<ConfigObject *>(obj));
   if (0 <= idx) {
     _items.remove(idx);
-    emit elementRemoved(idx);
+    signalRemoved(idx);
   }
 }
 
@@ -1227,10 +1402,10 @@ ConfigObjectList::link(const YAML::Node &node, const ConfigItem::Context &ctx, c
   return true;
 }
 
-int ConfigObjectList::add(ConfigObject *obj, int row) {
-  if (0 <= (row = AbstractConfigObjectList::add(obj, row)))
-    obj->setParent(this);
-  return row;
+void
+ConfigObjectList::attach(ConfigObject *obj) {
+  obj->setParent(this);
+  connect(obj, SIGNAL(destroyed(QObject*)), this, SLOT(onElementDeleted(QObject*)));
 }
 
 bool
@@ -1242,25 +1417,40 @@ ConfigObjectList::take(ConfigObject *obj) {
 
 bool
 ConfigObjectList::del(ConfigObject *obj) {
-  if (AbstractConfigObjectList::del(obj))
-    obj->deleteLater();
+  // Elements added during the current update were never announced, delete them right away
+  bool pending = isPending(obj);
+  if (AbstractConfigObjectList::del(obj)) {
+    if (pending)
+      delete obj;
+    else
+      obj->deleteLater();
+  }
   return true;
 }
 
 void
 ConfigObjectList::clear() {
   QVector<ConfigObject *> items = _items;
+  QSet<ConfigObject *> pending = _pending;
   AbstractConfigObjectList::clear();
-  for (int i=0; i<items.count(); i++)
-    items[i]->deleteLater();
+  // Elements added during the current update (e.g., a failed decode) were never announced,
+  // delete them right away.
+  for (int i=0; i<items.count(); i++) {
+    if (pending.contains(items[i]))
+      delete items[i];
+    else
+      items[i]->deleteLater();
+  }
 }
 
 bool
 ConfigObjectList::copy(const AbstractConfigObjectList &other) {
+  beginUpdate();
   clear();
   _elementTypes = other.elementTypes();
   for (int i=0; i<other.count(); i++)
     add(other.get(i)->clone()->as<ConfigObject>());
+  endUpdate();
   return true;
 }
 
@@ -1280,6 +1470,35 @@ ConfigObjectRefList::ConfigObjectRefList(const std::initializer_list<QMetaObject
   // pass...
 }
 
+ConfigObjectRefList::~ConfigObjectRefList() {
+  foreach (ConfigObject *obj, _items)
+    obj->remReferrer(this);
+}
+
+int
+ConfigObjectRefList::add(ConfigObject *obj, int row) {
+  // Referenced objects are tracked using the reverse index of the object instead of its
+  // destroyed() signal.
+  if (0 <= (row = AbstractConfigObjectList::add(obj, row)))
+    obj->addReferrer(this);
+  return row;
+}
+
+bool
+ConfigObjectRefList::take(ConfigObject *obj) {
+  if (! AbstractConfigObjectList::take(obj))
+    return false;
+  obj->remReferrer(this);
+  return true;
+}
+
+void
+ConfigObjectRefList::clear() {
+  foreach (ConfigObject *obj, _items)
+    obj->remReferrer(this);
+  AbstractConfigObjectList::clear();
+}
+
 bool
 ConfigObjectRefList::label(ConfigItem::Context &context, const ErrorStack &err) {
   Q_UNUSED(context); Q_UNUSED(err);
@@ -6,6 +6,8 @@
 #include <QHash>
 #include <QVector>
 #include <QMetaProperty>
+#include <QMutex>
+#include <QSet>
 
 #include <yaml-cpp/yaml.h>
 
@@ -15,6 +17,8 @@
 class Config;
 class ConfigObject;
 class ConfigExtension;
+class ConfigObjectReference;
+class ConfigObjectRefList;
 
 /** Helper function to test property type. */
 template <class T>
@@ -92,6 +96,8 @@ public:
     static QHash<QString, QHash<QString, ConfigObject *>> _tagObjects;
     /** Maps singleton objects to tags. */
     static QHash<QString, QHash<ConfigObject *, QString>> _tagNames;
+    /** Guards the tag tables, as config objects may be created concurrently. */
+    static QMutex _tagLock;
   };
 
 protected:
@@ -204,11 +210,21 @@ protected:
   ConfigObject(const QString &name, const QString &idBase="id", QObject *parent = nullptr);
 
 public:
+  /** Destructor, clears all references to this object. */
+  virtual ~ConfigObject();
+
   /** Returns the name of the object. */
   virtual const QString &name() const;
   /** Sets the name of the object. */
   virtual void setName(const QString &name);
 
+  /** Returns @c true if this object is referenced by any reference or reference list. */
+  bool isReferenced() const;
+  /** Returns all references currently pointing to this object. */
+  QList<ConfigObjectReference *> references() const;
+  /** Returns all reference lists currently containing this object. */
+  QList<ConfigObjectRefList *> referringLists() const;
+
 public:
   bool label(Context &context, const ErrorStack &err=ErrorStack());
   bool parse(const YAML::Node &node, Context &ctx, const ErrorStack &err=ErrorStack());
@@ -216,12 +232,32 @@ public:
 protected:
   virtual bool populate(YAML::Node &node, const Context &context, const ErrorStack &err=ErrorStack());
 
+protected:
+  /** Registers a reference pointing to this object. */
+  void addReferrer(ConfigObjectReference *ref);
+  /** Unregisters a reference pointing to this object. */
+  void remReferrer(ConfigObjectReference *ref);
+  /** Registers a reference list containing this object. */
+  void addReferrer(ConfigObjectRefList *list);
+  /** Unregisters a reference list containing this object. */
+  void remReferrer(ConfigObjectRefList *list);
+
 protected:
   /** Holds the base string to derive an ID from. All objects need some ID to be referenced within
    * a codeplug file. */
   QString _idBase;
   /** Holds the name of the object. */
   QString _name;
+  /** Reverse index of all references pointing to this object. */
+  QSet<ConfigObjectReference *> _references;
+  /** Reverse index of all reference lists containing this object. */
+  QSet<ConfigObjectRefList *> _referringLists;
+
+  /** Guards the reverse indices of all objects, references may get linked concurrently. */
+  static QMutex _referrerLock;
+
+  friend class ConfigObjectReference;
+  friend class ConfigObjectRefList;
 };
 
 
@@ -262,6 +298,8 @@ public:
 
   /** Returns the number of elements in the list. */
   virtual int count() const;
+  /** Reserves space for @c n elements. */
+  void reserve(int n);
   /** Retunrs the index of the given object within the list. */
   virtual int indexOf(ConfigObject *obj) const;
   /** Clears the list. */
@@ -281,6 +319,25 @@ public:
   /** Removes an element from the list (and deletes it if owned). */
   virtual bool del(ConfigObject *obj);
 
+  /** Adds all given elements to the list, starting at @c row. The per-element signals get
+   * replaced by a single @c elementsReset signal. Returns the number of elements added. */
+  virtual int addMany(const QList<ConfigObject *> &objs, int row=-1);
+  /** Removes all given elements from the list (and deletes them if owned). The per-element
+   * signals get replaced by a single @c elementsReset signal. Returns the number of elements
+   * removed. */
+  virtual int delMany(const QList<ConfigObject *> &objs);
+
+  /** Starts a bulk update of the list.
+   * Until the matching @c endUpdate, no per-element signals (@c elementAdded, @c elementModified
+   * and @c elementRemoved) are emitted. Updates may be nested. Elements added during an update
+   * get attached to the list (see @c attach) once the outermost update is finished. */
+  void beginUpdate();
+  /** Finishes a bulk update. If the list was changed during the update, @c elementsReset gets
+   * emitted once the outermost update is finished. */
+  void endUpdate();
+  /** Returns @c true during a bulk update. */
+  bool isUpdating() const;
+
   /** Moves the channel at index @c idx one step up. */
   virtual bool moveUp(int idx);
   /** Moves the channels at one step up. */
@@ -302,8 +359,28 @@ signals:
   void elementModified(int idx);
   /** Gets emitted if one of the lists elements gets deleted. */
   void elementRemoved(int idx);
+  /** Gets emitted after a bulk update changed the list. Any number of elements may have been
+   * added, modified or removed. */
+  void elementsReset();
 
-private slots:
+protected:
+  /** Gets called whenever an element was added. Emits @c elementAdded unless the list is
+   * updated. */
+  virtual void signalAdded(int idx);
+  /** Gets called whenever an element was modified. Emits @c elementModified unless the list is
+   * updated. */
+  virtual void signalModified(int idx);
+  /** Gets called whenever an element was removed. Emits @c elementRemoved unless the list is
+   * updated. */
+  virtual void signalRemoved(int idx);
+  /** Gets called once an added element is attached to the list. During bulk updates, this gets
+   * deferred until the update is finished. */
+  virtual void attach(ConfigObject *obj);
+  /** Returns @c true if the given element was added during the current update and is not
+   * attached yet. */
+  bool isPending(ConfigObject *obj) const;
+
+protected slots:
   /** Internal used callback to handle modified elments. */
   void onElementModified(ConfigItem *obj);
   /** Internal used callback to handle deleted elments. */
@@ -314,6 +391,12 @@ protected:
   QList<QMetaObject> _elementTypes;
   /** Holds the list items. */
   QVector<ConfigObject *> _items;
+  /** Nesting depth of bulk updates. */
+  int _updateDepth;
+  /** If @c true, the list was changed during the current bulk update. */
+  bool _updateChanged;
+  /** Elements added during the current bulk update, not attached yet. */
+  QSet<ConfigObject *> _pending;
 };
 
 
@@ -332,7 +415,6 @@ protected:
   ConfigObjectList(const std::initializer_list<QMetaObject> &elementTypes, QObject *parent=nullptr);
 
 public:
-  int add(ConfigObject *obj, int row=-1);
   bool take(ConfigObject *obj);
   bool del(ConfigObject *obj);
   void clear();
@@ -347,6 +429,10 @@ public:
 
   bool label(ConfigItem::Context &context, const ErrorStack &err=ErrorStack());
   YAML::Node serialize(const ConfigItem::Context &context, const ErrorStack &err=ErrorStack());
+
+protected:
+  /** Takes ownership of the element. */
+  void attach(ConfigObject *obj);
 };
 
 
@@ -365,8 +451,17 @@ protected:
   ConfigObjectRefList(const std::initializer_list<QMetaObject> &elementTypes, QObject *parent=nullptr);
 
 public:
+  /** Destructor, unregisters this list from all referenced objects. */
+  virtual ~ConfigObjectRefList();
+
+  int add(ConfigObject *obj, int row=-1);
+  bool take(ConfigObject *obj);
+  void clear();
+
   bool label(ConfigItem::Context &context, const ErrorStack &err=ErrorStack());
   YAML::Node serialize(const ConfigItem::Context &context, const ErrorStack &err=ErrorStack());
+
+  friend class ConfigObject;
 };
 
 
@@ -19,6 +19,11 @@ ConfigObjectReference::ConfigObjectReference(const QMetaObject &elementType, QOb
   _elementTypes.append(elementType.className());
 }
 
+ConfigObjectReference::~ConfigObjectReference() {
+  if (_object)
+    _object->remReferrer(this);
+}
+
 bool
 ConfigObjectReference::isNull() const {
   return nullptr == _object;
@@ -27,18 +32,17 @@ ConfigObjectReference::isNull() const {
 void
 ConfigObjectReference::clear() {
   if (_object) {
-    disconnect(_object, SIGNAL(destroyed(QObject*)), this, SLOT(onReferenceDeleted(QObject*)));
+    _object->remReferrer(this);
+    _object = nullptr;
     emit modified();
   }
-  _object = nullptr;
 }
 
 bool
 ConfigObjectReference::set(ConfigObject *object) {
-  if (_object)
-    disconnect(_object, SIGNAL(destroyed(QObject*)), this, SLOT(onReferenceDeleted(QObject*)));
-
   if (nullptr == object) {
+    if (_object)
+      _object->remReferrer(this);
     _object = nullptr;
     return true;
   }
@@ -57,9 +61,13 @@ ConfigObjectReference::set(ConfigObject *object) {
     return false;
   }
 
-  _object = object;
+  // Register with the reverse index of the referenced object. Unlike a connection to its
+  // destroyed() signal, this is cheap for objects with many referrers and does not depend on the
+  // thread affinity of this reference, which may get linked concurrently during decoding.
   if (_object)
-    connect(_object, SIGNAL(destroyed(QObject*)), this, SLOT(onReferenceDeleted(QObject*)));
+    _object->remReferrer(this);
+  _object = object;
+  _object->addReferrer(this);
 
   emit modified();
   return true;
@@ -22,6 +22,9 @@ protected:
   ConfigObjectReference(const QMetaObject &elementType=ConfigObject::staticMetaObject, QObject *parent = nullptr);
 
 public:
+  /** Destructor, unregisters the reference from the referenced object. */
+  virtual ~ConfigObjectReference();
+
   /** Returns @c true if the reference is null.
    * That is, if there is no object referenced. */
   bool isNull() const;
@@ -70,6 +73,8 @@ protected:
   QStringList _elementTypes;
   /** The reference to the object. */
   ConfigObject *_object;
+
+  friend class ConfigObject;
 };
 
 
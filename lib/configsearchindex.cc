@@ -0,0 +1,318 @@
+#include "configsearchindex.hh"
+#include "config.hh"
+#include "channel.hh"
+#include "contact.hh"
+#include "radioid.hh"
+#include "configreference.hh"
+#include <QMetaProperty>
+
+
+/** Returns the tri-gram starting at index @c i of the given string. */
+inline quint64
+trigram(const QString &str, int i) {
+  return (quint64(str.at(i).unicode())<<32) | (quint64(str.at(i+1).unicode())<<16)
+      | quint64(str.at(i+2).unicode());
+}
+
+/** Returns the references and reference lists of the given object. */
+static QList<const QObject *>
+objectReferences(ConfigObject *obj) {
+  QList<const QObject *> refs;
+  const QMetaObject *meta = obj->metaObject();
+  for (int p=QObject::staticMetaObject.propertyCount(); p<meta->propertyCount(); p++) {
+    QVariant value = meta->property(p).read(obj);
+    if (ConfigObjectReference *ref = value.value<ConfigObjectReference *>())
+      refs.append(ref);
+    else if (ConfigObjectRefList *lst = value.value<ConfigObjectRefList *>())
+      refs.append(lst);
+  }
+  return refs;
+}
+
+/** Assembles the lower-case search keys for the given object. */
+static QStringList
+searchKeys(ConfigObject *obj, const QList<const QObject *> &refs) {
+  QStringList keys;
+  keys.append(obj->name().toLower());
+  if (Channel *ch = obj->as<Channel>()) {
+    keys.append(QString::number(ch->rxFrequency(), 'f', 4));
+    keys.append(QString::number(ch->txFrequency(), 'f', 4));
+  } else if (DigitalContact *contact = obj->as<DigitalContact>()) {
+    keys.append(QString::number(contact->number()));
+  } else if (DTMFContact *contact = obj->as<DTMFContact>()) {
+    keys.append(contact->number().toLower());
+  } else if (DMRRadioID *id = obj->as<DMRRadioID>()) {
+    keys.append(QString::number(id->number()));
+  }
+  // Names of referenced objects, as shown in the tables
+  foreach (const QObject *ref, refs) {
+    if (const ConfigObjectReference *r = qobject_cast<const ConfigObjectReference *>(ref)) {
+      if (ConfigObject *target = r->as<ConfigObject>())
+        keys.append(target->name().toLower());
+    }
+  }
+  return keys;
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of ConfigSearchIndex
+ * ********************************************************************************************* */
+ConfigSearchIndex::ConfigSearchIndex(Config *config, QObject *parent)
+  : QObject(parent), _lists(), _index(), _owners(), _dirty(), _stale()
+{
+  if (nullptr == config)
+    return;
+
+  watch(config->radioIDs());
+  watch(config->contacts());
+  watch(config->rxGroupLists());
+  watch(config->channelList());
+  watch(config->zones());
+  watch(config->scanlists());
+  watch(config->posSystems());
+  watch(config->roaming());
+}
+
+bool
+ConfigSearchIndex::indexes(const AbstractConfigObjectList *list) const {
+  return _index.contains(list);
+}
+
+QList<ConfigObject *>
+ConfigSearchIndex::find(const QString &query) {
+  QList<ConfigObject *> result;
+  foreach (AbstractConfigObjectList *list, _lists)
+    result.append(find(query, list));
+  return result;
+}
+
+QList<ConfigObject *>
+ConfigSearchIndex::find(const QString &query, const AbstractConfigObjectList *list) {
+  QList<ConfigObject *> result;
+  foreach (int idx, indices(query, list))
+    result.append(list->get(idx));
+  return result;
+}
+
+QList<int>
+ConfigSearchIndex::indices(const QString &query, const AbstractConfigObjectList *list) {
+  QList<int> result;
+  if ((nullptr == list) || (! indexes(list)) || query.isEmpty())
+    return result;
+
+  QSet<ConfigObject *> matches = match(query, list);
+  if (matches.isEmpty())
+    return result;
+
+  // Restore list order
+  for (int i=0; (i<list->count()) && (result.count()<matches.count()); i++) {
+    if (matches.contains(list->get(i)))
+      result.append(i);
+  }
+  return result;
+}
+
+QList<ConfigObject *>
+ConfigSearchIndex::referrers(ConfigObject *obj) {
+  QList<ConfigObject *> result;
+  if (nullptr == obj)
+    return result;
+
+  update();
+
+  QList<const QObject *> refs;
+  foreach (ConfigObjectReference *ref, obj->references())
+    refs.append(ref);
+  foreach (ConfigObjectRefList *lst, obj->referringLists())
+    refs.append(lst);
+  foreach (const QObject *ref, refs) {
+    ConfigObject *owner = _owners.value(ref, nullptr);
+    if ((nullptr != owner) && (! result.contains(owner)))
+      result.append(owner);
+  }
+  return result;
+}
+
+AbstractConfigObjectList *
+ConfigSearchIndex::listOf(ConfigObject *obj) {
+  update();
+  foreach (AbstractConfigObjectList *list, _lists) {
+    if (_index[list].keys.contains(obj))
+      return list;
+  }
+  return nullptr;
+}
+
+void
+ConfigSearchIndex::watch(AbstractConfigObjectList *list) {
+  if ((nullptr == list) || indexes(list))
+    return;
+  _lists.append(list);
+  _index.insert(list, ListIndex());
+  _dirty.insert(list);
+  connect(list, SIGNAL(elementAdded(int)), this, SLOT(onElementAdded(int)));
+  connect(list, SIGNAL(elementModified(int)), this, SLOT(onElementModified(int)));
+  connect(list, SIGNAL(elementRemoved(int)), this, SLOT(onElementRemoved(int)));
+  connect(list, SIGNAL(elementsReset()), this, SLOT(onElementsReset()));
+}
+
+void
+ConfigSearchIndex::update() {
+  if (_dirty.isEmpty())
+    return;
+
+  foreach (AbstractConfigObjectList *list, _lists) {
+    if (! _dirty.contains(list))
+      continue;
+    QSet<ConfigObject *> members, current;
+    for (QHash<ConfigObject *, QStringList>::const_iterator it=_index[list].keys.begin();
+         it!=_index[list].keys.end(); it++)
+      members.insert(it.key());
+    for (int i=0; i<list->count(); i++)
+      current.insert(list->get(i));
+    // Remove vanished and stale objects
+    QSet<ConfigObject *> outdated = members - current;
+    outdated.unite(members & _stale);
+    foreach (ConfigObject *obj, outdated)
+      remove(obj, list);
+    // (Re-)index new and stale objects
+    foreach (ConfigObject *obj, current - (members - outdated))
+      insert(obj, list);
+  }
+
+  _dirty.clear();
+  _stale.clear();
+}
+
+void
+ConfigSearchIndex::insert(ConfigObject *obj, const AbstractConfigObjectList *list) {
+  ListIndex &index = _index[list];
+  QList<const QObject *> refs = objectReferences(obj);
+  QStringList keys = searchKeys(obj, refs);
+  index.keys.insert(obj, keys);
+  index.refs.insert(obj, refs);
+  foreach (const QObject *ref, refs)
+    _owners.insert(ref, obj);
+  foreach (const QString &key, keys) {
+    for (int i=0; (i+2)<key.size(); i++)
+      index.grams[trigram(key, i)].insert(obj);
+  }
+}
+
+void
+ConfigSearchIndex::remove(ConfigObject *obj, const AbstractConfigObjectList *list) {
+  ListIndex &index = _index[list];
+  foreach (const QString &key, index.keys.value(obj)) {
+    for (int i=0; (i+2)<key.size(); i++) {
+      quint64 gram = trigram(key, i);
+      if (! index.grams.contains(gram))
+        continue;
+      index.grams[gram].remove(obj);
+      if (index.grams[gram].isEmpty())
+        index.grams.remove(gram);
+    }
+  }
+  foreach (const QObject *ref, index.refs.value(obj)) {
+    // The reference may belong to another object by now
+    if (obj == _owners.value(ref, nullptr))
+      _owners.remove(ref);
+  }
+  index.keys.remove(obj);
+  index.refs.remove(obj);
+}
+
+QSet<ConfigObject *>
+ConfigSearchIndex::match(const QString &query, const AbstractConfigObjectList *list) {
+  update();
+
+  const ListIndex &index = _index[list];
+  QString q = query.toLower();
+  QSet<ConfigObject *> candidates, matches;
+  if (q.size() < 3) {
+    // Query too short for tri-grams, check all objects
+    for (QHash<ConfigObject *, QStringList>::const_iterator it=index.keys.begin();
+         it!=index.keys.end(); it++)
+      candidates.insert(it.key());
+  } else {
+    // Use the smallest posting set as candidates, all others must contain these anyway
+    for (int i=0; (i+2)<q.size(); i++) {
+      quint64 gram = trigram(q, i);
+      if (! index.grams.contains(gram))
+        return matches;
+      const QSet<ConfigObject *> &posting = index.grams[gram];
+      if ((0 == i) || (posting.size() < candidates.size()))
+        candidates = posting;
+    }
+  }
+
+  // Verify candidates
+  foreach (ConfigObject *obj, candidates) {
+    foreach (const QString &key, index.keys[obj]) {
+      if (key.contains(q)) {
+        matches.insert(obj);
+        break;
+      }
+    }
+  }
+  return matches;
+}
+
+void
+ConfigSearchIndex::invalidateReferrers(ConfigObject *obj) {
+  foreach (ConfigObjectReference *ref, obj->references()) {
+    ConfigObject *owner = _owners.value(ref, nullptr);
+    if (nullptr == owner)
+      continue;
+    _stale.insert(owner);
+    foreach (AbstractConfigObjectList *list, _lists) {
+      if (_index[list].keys.contains(owner))
+        _dirty.insert(list);
+    }
+  }
+}
+
+void
+ConfigSearchIndex::onElementAdded(int idx) {
+  AbstractConfigObjectList *list = qobject_cast<AbstractConfigObjectList *>(sender());
+  if (nullptr == list)
+    return;
+  // The object may reuse the address of a deleted one, hence mark it as stale
+  if (ConfigObject *obj = list->get(idx))
+    _stale.insert(obj);
+  _dirty.insert(list);
+}
+
+void
+ConfigSearchIndex::onElementModified(int idx) {
+  AbstractConfigObjectList *list = qobject_cast<AbstractConfigObjectList *>(sender());
+  if (nullptr == list)
+    return;
+  if (ConfigObject *obj = list->get(idx)) {
+    _stale.insert(obj);
+    invalidateReferrers(obj);
+  }
+  _dirty.insert(list);
+}
+
+void
+ConfigSearchIndex::onElementRemoved(int idx) {
+  Q_UNUSED(idx);
+  AbstractConfigObjectList *list = qobject_cast<AbstractConfigObjectList *>(sender());
+  if (nullptr == list)
+    return;
+  _dirty.insert(list);
+}
+
+void
+ConfigSearchIndex::onElementsReset() {
+  AbstractConfigObjectList *list = qobject_cast<AbstractConfigObjectList *>(sender());
+  if (nullptr == list)
+    return;
+  // Any element may have been replaced or modified, re-index all of them
+  for (int i=0; i<list->count(); i++) {
+    _stale.insert(list->get(i));
+    invalidateReferrers(list->get(i));
+  }
+  _dirty.insert(list);
+}
@@ -0,0 +1,103 @@
+#ifndef CONFIGSEARCHINDEX_HH
+#define CONFIGSEARCHINDEX_HH
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+
+class Config;
+class ConfigObject;
+class AbstractConfigObjectList;
+
+/** Implements a full-text index over all objects of a codeplug configuration.
+ *
+ * The index contains the names of all objects, the names of the objects they reference (e.g., the
+ * contact, group list and scan list of a channel) as well as the DMR IDs of contacts and radio IDs
+ * and the RX and TX frequencies (in MHz) of channels. The keys are split into tri-grams, such that
+ * a sub-string search only needs to verify the few candidates sharing all tri-grams with the query
+ * instead of formatting and matching every object.
+ *
+ * Each list is indexed separately. Hence an object is always removed from the list it was indexed
+ * for, even if its address got reused by an object of another list in the meantime.
+ *
+ * The index follows the lists of the config incrementally. Added, removed or modified objects are
+ * only recorded and (re-)indexed with the next search. Hence bulk-modifications like reading a
+ * codeplug do not cause any indexing overhead.
+ *
+ * @ingroup conf */
+class ConfigSearchIndex: public QObject
+{
+  Q_OBJECT
+
+public:
+  /** Constructs a search index for the given config. */
+  explicit ConfigSearchIndex(Config *config, QObject *parent=nullptr);
+
+  /** Returns all objects matching the given query (case insensitive sub-string). The objects are
+   * ordered by list and their position within the list. */
+  QList<ConfigObject *> find(const QString &query);
+  /** Returns all objects of the specified list matching the given query, in list order. */
+  QList<ConfigObject *> find(const QString &query, const AbstractConfigObjectList *list);
+  /** Returns the indices of all objects of the specified list matching the given query. */
+  QList<int> indices(const QString &query, const AbstractConfigObjectList *list);
+  /** Returns all indexed objects referencing the given object, either directly (e.g., channels
+   * using a contact) or by a reference list (e.g., zones containing a channel). */
+  QList<ConfigObject *> referrers(ConfigObject *obj);
+  /** Returns the indexed list containing the given object or @c nullptr if the object is not
+   * indexed. */
+  AbstractConfigObjectList *listOf(ConfigObject *obj);
+
+  /** Returns @c true, if the given list is covered by this index. */
+  bool indexes(const AbstractConfigObjectList *list) const;
+
+protected:
+  /** Adds a list to the index. */
+  void watch(AbstractConfigObjectList *list);
+  /** Updates the index for all modified lists. */
+  void update();
+  /** Adds an object of the given list to the index. */
+  void insert(ConfigObject *obj, const AbstractConfigObjectList *list);
+  /** Removes an object of the given list from the index. The object is not dereferenced, it may
+   * be deleted already. */
+  void remove(ConfigObject *obj, const AbstractConfigObjectList *list);
+  /** Returns the set of objects of the given list matching the query. */
+  QSet<ConfigObject *> match(const QString &query, const AbstractConfigObjectList *list);
+  /** Marks all indexed objects referencing the given one as stale. Their keys contain the name of
+   * the referenced object. */
+  void invalidateReferrers(ConfigObject *obj);
+
+protected slots:
+  /** Gets called if an element was added to one of the indexed lists. */
+  void onElementAdded(int idx);
+  /** Gets called if an element of one of the indexed lists was modified. */
+  void onElementModified(int idx);
+  /** Gets called if an element was removed from one of the indexed lists. */
+  void onElementRemoved(int idx);
+  /** Gets called after a bulk update of one of the indexed lists. */
+  void onElementsReset();
+
+protected:
+  /** The index of a single list. */
+  struct ListIndex {
+    /** Maps each indexed object to its lower-case search keys. */
+    QHash<ConfigObject *, QStringList> keys;
+    /** Maps each indexed object to its references and reference lists. */
+    QHash<ConfigObject *, QList<const QObject *>> refs;
+    /** Maps each tri-gram to the set of objects containing it. */
+    QHash<quint64, QSet<ConfigObject *>> grams;
+  };
+
+  /** The indexed lists. */
+  QList<AbstractConfigObjectList *> _lists;
+  /** The index of each list. */
+  QHash<const AbstractConfigObjectList *, ListIndex> _index;
+  /** Maps the references and reference lists of all indexed objects to their owner. */
+  QHash<const QObject *, ConfigObject *> _owners;
+  /** The set of lists modified since the last update. */
+  QSet<const AbstractConfigObjectList *> _dirty;
+  /** The set of objects to (re-)index with the next update. */
+  QSet<ConfigObject *> _stale;
+};
+
+#endif // CONFIGSEARCHINDEX_HH
@@ -0,0 +1,780 @@
+#include "configsnapshot.hh"
+#include "config.hh"
+#include "logger.hh"
+
+#include <QDataStream>
+#include <QSaveFile>
+#include <QFile>
+#include <QMutex>
+#include <QPair>
+
+
+const quint32 ConfigSnapshot::Magic   = 0x51444d53; // "QDMS"
+const quint16 ConfigSnapshot::Version = 1;
+
+/** The data stream version used for all snapshots. */
+#define SNAPSHOT_STREAM_VERSION QDataStream::Qt_5_0
+
+
+/* ********************************************************************************************* *
+ * Property descriptors shared by writer and reader
+ * ********************************************************************************************* */
+namespace {
+
+/** Type tags of property records. */
+enum Tag : quint8 {
+  TagEnd = 0, TagNull, TagBool, TagInt, TagUInt, TagDouble, TagString, TagEnum,
+  TagReference, TagRefList, TagItem, TagList
+};
+
+/** Object IDs, the singletons get fixed IDs assigned. */
+enum ObjectId : qint32 {
+  NullId = -1, DefaultRadioIdId = 0, SelectedChannelId = 1, DefaultRoamingZoneId = 2,
+  FirstObjectId = 3
+};
+
+/** How a property gets serialized. */
+enum class Kind {
+  Basic, Reference, RefList, Item, List
+};
+
+/** Serialization descriptor of a single property. */
+struct Field {
+  /** The property. */
+  QMetaProperty prop;
+  /** How the property gets serialized. */
+  Kind kind;
+  /** The value tag for basic properties. */
+  Tag tag;
+};
+
+/** Caches the property descriptors of every class. */
+QHash<const QMetaObject *, QVector<Field>> _fieldCache;
+/** Guards the descriptor cache. */
+QMutex _fieldLock;
+
+/** Returns the property descriptors of the given class. The properties get classified only
+ * once per class. */
+QVector<Field>
+fields(const QMetaObject *meta) {
+  QMutexLocker locker(&_fieldLock);
+  if (_fieldCache.contains(meta))
+    return _fieldCache.value(meta);
+
+  QVector<Field> fields;
+  for (int p=QObject::staticMetaObject.propertyCount(); p<meta->propertyCount(); p++) {
+    QMetaProperty prop = meta->property(p);
+    if ((! prop.isValid()) || (! prop.isReadable()))
+      continue;
+
+    Field field = {prop, Kind::Basic, TagNull};
+    if (prop.isEnumType())
+      field.tag = TagEnum;
+    else if (QVariant::Bool == prop.type())
+      field.tag = TagBool;
+    else if (QVariant::Int == prop.type())
+      field.tag = TagInt;
+    else if (QVariant::UInt == prop.type())
+      field.tag = TagUInt;
+    else if (QVariant::Double == prop.type())
+      field.tag = TagDouble;
+    else if (QVariant::String == prop.type())
+      field.tag = TagString;
+
+    if (TagNull != field.tag) {
+      // Basic values are only stored if they can be restored
+      if (! prop.isWritable())
+        continue;
+    } else if (propIsInstance<ConfigObjectReference>(prop)) {
+      field.kind = Kind::Reference;
+    } else if (propIsInstance<ConfigObjectRefList>(prop)) {
+      field.kind = Kind::RefList;
+    } else if (propIsInstance<ConfigObjectList>(prop)) {
+      field.kind = Kind::List;
+    } else if (propIsInstance<ConfigItem>(prop)) {
+      field.kind = Kind::Item;
+    } else {
+      continue;
+    }
+    fields.append(field);
+  }
+
+  _fieldCache.insert(meta, fields);
+  return fields;
+}
+
+/** Returns the class for the given name. Besides the given @c hint, all classes that may be
+ * elements of a config object list are known. */
+const QMetaObject *
+findClass(const QString &className, const QMetaObject *hint) {
+  static const QMetaObject *classes[] = {
+    &DMRRadioID::staticMetaObject, &DTMFRadioID::staticMetaObject,
+    &DigitalContact::staticMetaObject, &DTMFContact::staticMetaObject,
+    &RXGroupList::staticMetaObject,
+    &DigitalChannel::staticMetaObject, &AnalogChannel::staticMetaObject,
+    &Zone::staticMetaObject, &ScanList::staticMetaObject,
+    &GPSSystem::staticMetaObject, &APRSSystem::staticMetaObject,
+    &RoamingZone::staticMetaObject,
+    &DMREncryptionKey::staticMetaObject, &AESEncryptionKey::staticMetaObject,
+    nullptr
+  };
+
+  if ((nullptr != hint) && (className == hint->className()))
+    return hint;
+  for (int i=0; nullptr != classes[i]; i++) {
+    if (className == classes[i]->className())
+      return classes[i];
+  }
+  return nullptr;
+}
+
+}
+
+
+/* ********************************************************************************************* *
+ * Snapshot writer
+ * ********************************************************************************************* */
+/** Serializes config items into the snapshot body and collects the string table. */
+class SnapshotWriter
+{
+public:
+  /** Constructor. */
+  SnapshotWriter()
+    : _body(), _stream(&_body, QIODevice::WriteOnly), _strings(), _stringIds(), _classes(),
+      _objects(), _nextId(FirstObjectId)
+  {
+    _stream.setVersion(SNAPSHOT_STREAM_VERSION);
+    _objects.insert(DefaultRadioID::get(), DefaultRadioIdId);
+    _objects.insert(SelectedChannel::get(), SelectedChannelId);
+    _objects.insert(DefaultRoamingZone::get(), DefaultRoamingZoneId);
+  }
+
+  /** Serializes the given item and all its children. */
+  bool writeItem(const ConfigItem *item, const ErrorStack &err) {
+    // Copy, the class table may grow while serializing children
+    const ClassInfo info = classInfo(item->metaObject());
+    const ConfigObject *obj = item->as<ConfigObject>();
+    _stream << info.className << ((nullptr != obj) ? object(obj) : qint32(NullId));
+
+    for (int i=0; i<info.fields.count(); i++) {
+      const Field &field = info.fields.at(i);
+      QVariant value = field.prop.read(item);
+      switch (field.kind) {
+      case Kind::Basic:
+        _stream << quint8(field.tag) << info.names.at(i);
+        writeBasic(field.tag, value);
+        break;
+
+      case Kind::Reference: {
+        ConfigObjectReference *ref = value.value<ConfigObjectReference *>();
+        if (nullptr == ref)
+          break;
+        _stream << quint8(TagReference) << info.names.at(i) << object(ref->as<ConfigObject>());
+      } break;
+
+      case Kind::RefList: {
+        ConfigObjectRefList *lst = value.value<ConfigObjectRefList *>();
+        if (nullptr == lst)
+          break;
+        _stream << quint8(TagRefList) << info.names.at(i) << quint32(lst->count());
+        for (int j=0; j<lst->count(); j++)
+          _stream << object(lst->get(j));
+      } break;
+
+      case Kind::List: {
+        ConfigObjectList *lst = value.value<ConfigObjectList *>();
+        if (nullptr == lst)
+          break;
+        _stream << quint8(TagList) << info.names.at(i) << quint32(lst->count());
+        for (int j=0; j<lst->count(); j++) {
+          if (! writeItem(lst->get(j), err)) {
+            errMsg(err) << "Cannot serialize element " << j << " of list '"
+                        << field.prop.name() << "' of " << item->metaObject()->className() << ".";
+            return false;
+          }
+        }
+      } break;
+
+      case Kind::Item: {
+        ConfigItem *child = value.value<ConfigItem *>();
+        if (nullptr == child) {
+          _stream << quint8(TagNull) << info.names.at(i);
+          break;
+        }
+        _stream << quint8(TagItem) << info.names.at(i);
+        if (! writeItem(child, err)) {
+          errMsg(err) << "Cannot serialize '" << field.prop.name() << "' of "
+                      << item->metaObject()->className() << ".";
+          return false;
+        }
+      } break;
+      }
+    }
+
+    writeState(item);
+    _stream << quint8(TagEnd);
+
+    return QDataStream::Ok == _stream.status();
+  }
+
+  /** Assembles the snapshot from the header, the string table and the body. */
+  void finish(QByteArray &data) {
+    data.clear();
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(SNAPSHOT_STREAM_VERSION);
+    out << ConfigSnapshot::Magic << ConfigSnapshot::Version << quint32(_strings.count());
+    foreach (const QString &str, _strings)
+      out << str;
+    out.writeRawData(_body.constData(), _body.size());
+  }
+
+protected:
+  /** Per-class serialization information. */
+  struct ClassInfo {
+    /** String ID of the class name. */
+    quint32 className;
+    /** The property descriptors. */
+    QVector<Field> fields;
+    /** String IDs of the property names. */
+    QVector<quint32> names;
+  };
+
+  /** Returns the serialization information for the given class. */
+  const ClassInfo &classInfo(const QMetaObject *meta) {
+    if (! _classes.contains(meta)) {
+      ClassInfo info;
+      info.className = string(meta->className());
+      info.fields = fields(meta);
+      foreach (const Field &field, info.fields)
+        info.names.append(string(field.prop.name()));
+      _classes.insert(meta, info);
+    }
+    return _classes[meta];
+  }
+
+  /** Interns the given string. */
+  quint32 string(const QString &str) {
+    QHash<QString, quint32>::const_iterator it = _stringIds.constFind(str);
+    if (_stringIds.constEnd() != it)
+      return it.value();
+    quint32 id = _strings.count();
+    _strings.append(str);
+    _stringIds.insert(str, id);
+    return id;
+  }
+
+  /** Returns the ID of the given object. IDs get assigned on first use, hence references may
+   * get serialized before the referenced object. */
+  qint32 object(const ConfigObject *obj) {
+    if (nullptr == obj)
+      return NullId;
+    QHash<const ConfigObject *, qint32>::const_iterator it = _objects.constFind(obj);
+    if (_objects.constEnd() != it)
+      return it.value();
+    qint32 id = _nextId++;
+    _objects.insert(obj, id);
+    return id;
+  }
+
+  /** Serializes a basic value. */
+  void writeBasic(Tag tag, const QVariant &value) {
+    switch (tag) {
+    case TagBool: _stream << quint8(value.toBool() ? 1 : 0); break;
+    case TagInt:
+    case TagEnum: _stream << qint32(value.toInt()); break;
+    case TagUInt: _stream << quint32(value.toUInt()); break;
+    case TagDouble: _stream << value.toDouble(); break;
+    case TagString: _stream << string(value.toString()); break;
+    default: break;
+    }
+  }
+
+  /** Serializes a named basic value. */
+  void writeState(const QString &name, Tag tag, const QVariant &value) {
+    _stream << quint8(tag) << string(name);
+    writeBasic(tag, value);
+  }
+
+  /** Serializes the state of some items, that is not accessible through properties. These
+   * records are marked by a leading '@' in their name. */
+  void writeState(const ConfigItem *item) {
+    if (const Channel *ch = item->as<Channel>()) {
+      writeState("@defaultPower", TagBool, ch->defaultPower());
+      writeState("@defaultTimeout", TagBool, ch->defaultTimeout());
+      writeState("@defaultVOX", TagBool, ch->defaultVOX());
+    }
+    if (const AnalogChannel *ach = item->as<AnalogChannel>()) {
+      writeState("@rxTone", TagInt, int(ach->rxTone()));
+      writeState("@txTone", TagInt, int(ach->txTone()));
+    }
+    if (const APRSSystem *sys = item->as<APRSSystem>()) {
+      writeState("@destination", TagString, sys->destination());
+      writeState("@destSSID", TagUInt, sys->destSSID());
+      writeState("@source", TagString, sys->source());
+      writeState("@srcSSID", TagUInt, sys->srcSSID());
+      writeState("@path", TagString, sys->path());
+    }
+    if (const Config *conf = item->as<Config>()) {
+      RadioIDList *ids = conf->radioIDs();
+      writeState("@defaultRadioId", TagInt,
+                 (nullptr != ids->defaultId()) ? ids->indexOf(ids->defaultId()) : -1);
+    }
+  }
+
+protected:
+  /** The serialized items. */
+  QByteArray _body;
+  /** Stream into the body. */
+  QDataStream _stream;
+  /** The string table. */
+  QVector<QString> _strings;
+  /** Maps strings to their IDs. */
+  QHash<QString, quint32> _stringIds;
+  /** Serialization information per class. */
+  QHash<const QMetaObject *, ClassInfo> _classes;
+  /** Maps objects to their IDs. */
+  QHash<const ConfigObject *, qint32> _objects;
+  /** The next free object ID. */
+  qint32 _nextId;
+};
+
+
+/* ********************************************************************************************* *
+ * Snapshot reader
+ * ********************************************************************************************* */
+/** Restores config items from a snapshot. References get resolved once all objects are
+ * restored. */
+class SnapshotReader
+{
+public:
+  /** Constructor. */
+  SnapshotReader(const QByteArray &data)
+    : _stream(data), _strings(), _properties(), _objects(), _references(), _refLists()
+  {
+    _stream.setVersion(SNAPSHOT_STREAM_VERSION);
+    _objects.insert(DefaultRadioIdId, DefaultRadioID::get());
+    _objects.insert(SelectedChannelId, SelectedChannel::get());
+    _objects.insert(DefaultRoamingZoneId, DefaultRoamingZone::get());
+  }
+
+  /** Reads the header and the string table. */
+  bool readHeader(const ErrorStack &err) {
+    quint32 magic; quint16 version; quint32 count;
+    _stream >> magic >> version;
+    if ((QDataStream::Ok != _stream.status()) || (ConfigSnapshot::Magic != magic)) {
+      errMsg(err) << "Not a config snapshot.";
+      return false;
+    }
+    if (ConfigSnapshot::Version < version) {
+      errMsg(err) << "Unsupported snapshot version " << version << ", expected version "
+                  << ConfigSnapshot::Version << " or older.";
+      return false;
+    }
+
+    _stream >> count;
+    _strings.reserve(count);
+    for (quint32 i=0; (i<count) && (QDataStream::Ok == _stream.status()); i++) {
+      QString str; _stream >> str;
+      _strings.append(str);
+    }
+    if (QDataStream::Ok != _stream.status()) {
+      errMsg(err) << "Cannot read string table: Snapshot truncated.";
+      return false;
+    }
+    return true;
+  }
+
+  /** Restores the given item. The class of the stored item must match. */
+  bool readItem(ConfigItem *item, const ErrorStack &err) {
+    quint32 className; qint32 id;
+    _stream >> className >> id;
+    if (string(className) != item->metaObject()->className()) {
+      errMsg(err) << "Cannot restore " << item->metaObject()->className() << " from "
+                  << string(className) << ".";
+      return false;
+    }
+    if ((NullId != id) && item->is<ConfigObject>())
+      _objects.insert(id, item->as<ConfigObject>());
+    return readProperties(item, err);
+  }
+
+  /** Instantiates and restores a stored item. The class gets determined by the stored class name,
+   * the @c hint is the type of the property holding the item. */
+  ConfigItem *readNewItem(const QMetaObject *hint, QObject *parent, const ErrorStack &err) {
+    quint32 className; qint32 id;
+    _stream >> className >> id;
+
+    const QMetaObject *meta = findClass(string(className), hint);
+    ConfigItem *item = nullptr;
+    if (nullptr != meta)
+      item = qobject_cast<ConfigItem *>(meta->newInstance(Q_ARG(QObject *, parent)));
+    if (nullptr == item) {
+      errMsg(err) << "Cannot instantiate " << string(className) << ".";
+      return nullptr;
+    }
+
+    if ((NullId != id) && item->is<ConfigObject>())
+      _objects.insert(id, item->as<ConfigObject>());
+    if (! readProperties(item, err)) {
+      delete item;
+      return nullptr;
+    }
+    return item;
+  }
+
+  /** Resolves all references. */
+  void resolve() {
+    foreach (const PendingReference &pending, _references) {
+      ConfigObject *obj = _objects.value(pending.second, nullptr);
+      if ((nullptr == obj) && (NullId != pending.second))
+        logWarn() << "Cannot resolve reference to object " << pending.second << ".";
+      if (nullptr == obj)
+        pending.first->clear();
+      else if (! pending.first->set(obj))
+        logWarn() << "Cannot restore reference to " << obj->name() << ".";
+    }
+    foreach (const PendingRefList &pending, _refLists) {
+      pending.first->clear();
+      foreach (qint32 id, pending.second) {
+        ConfigObject *obj = _objects.value(id, nullptr);
+        if (nullptr == obj)
+          logWarn() << "Cannot resolve reference to object " << id << ".";
+        else
+          pending.first->add(obj);
+      }
+    }
+  }
+
+  /** Returns @c true if the complete snapshot was read. */
+  bool atEnd() const {
+    return (QDataStream::Ok == _stream.status()) && _stream.atEnd();
+  }
+
+protected:
+  /** Returns the string for the given ID. */
+  QString string(quint32 id) const {
+    return (id < quint32(_strings.count())) ? _strings.at(id) : QString();
+  }
+
+  /** Returns the index of the named property of the given class. */
+  int propertyIndex(const QMetaObject *meta, quint32 name) {
+    QPair<const QMetaObject *, quint32> key(meta, name);
+    if (! _properties.contains(key))
+      _properties.insert(key, meta->indexOfProperty(string(name).toLocal8Bit().constData()));
+    return _properties.value(key);
+  }
+
+  /** Reads a basic value. */
+  QVariant readBasic(quint8 tag) {
+    switch (tag) {
+    case TagBool: { quint8 v; _stream >> v; return QVariant(0 != v); }
+    case TagInt:
+    case TagEnum: { qint32 v; _stream >> v; return QVariant(int(v)); }
+    case TagUInt: { quint32 v; _stream >> v; return QVariant(uint(v)); }
+    case TagDouble: { double v; _stream >> v; return QVariant(v); }
+    case TagString: { quint32 v; _stream >> v; return QVariant(string(v)); }
+    default: break;
+    }
+    return QVariant();
+  }
+
+  /** Skips a value of the given tag. */
+  bool skipValue(quint8 tag, const ErrorStack &err) {
+    switch (tag) {
+    case TagNull: return true;
+    case TagBool: case TagInt: case TagEnum: case TagUInt: case TagDouble: case TagString:
+      readBasic(tag);
+      return true;
+    case TagReference: { qint32 id; _stream >> id; } return true;
+    case TagRefList: {
+      quint32 count; _stream >> count;
+      for (quint32 i=0; (i<count) && (QDataStream::Ok == _stream.status()); i++) {
+        qint32 id; _stream >> id;
+      }
+    } return true;
+    case TagItem: return skipItem(err);
+    case TagList: {
+      quint32 count; _stream >> count;
+      for (quint32 i=0; (i<count) && (QDataStream::Ok == _stream.status()); i++) {
+        if (! skipItem(err))
+          return false;
+      }
+    } return true;
+    default: break;
+    }
+    errMsg(err) << "Unknown value tag " << int(tag) << ".";
+    return false;
+  }
+
+  /** Skips a complete item. */
+  bool skipItem(const ErrorStack &err) {
+    quint32 className; qint32 id;
+    _stream >> className >> id;
+    while (QDataStream::Ok == _stream.status()) {
+      quint8 tag; quint32 name;
+      _stream >> tag;
+      if (TagEnd == tag)
+        return true;
+      _stream >> name;
+      if (! skipValue(tag, err))
+        return false;
+    }
+    errMsg(err) << "Snapshot truncated.";
+    return false;
+  }
+
+  /** Reads all property records of the given item. */
+  bool readProperties(ConfigItem *item, const ErrorStack &err) {
+    const QMetaObject *meta = item->metaObject();
+    while (QDataStream::Ok == _stream.status()) {
+      quint8 tag; quint32 name;
+      _stream >> tag;
+      if (TagEnd == tag)
+        return true;
+      _stream >> name;
+
+      // Handle state that is not accessible through properties
+      if (string(name).startsWith('@')) {
+        if (! restoreState(item, string(name), readBasic(tag))) {
+          errMsg(err) << "Cannot restore " << string(name) << " of " << meta->className() << ".";
+          return false;
+        }
+        continue;
+      }
+
+      int idx = propertyIndex(meta, name);
+      if (0 > idx) {
+        logDebug() << "Skip unknown property '" << string(name) << "' of "
+                   << meta->className() << ".";
+        if (! skipValue(tag, err))
+          return false;
+        continue;
+      }
+
+      QMetaProperty prop = meta->property(idx);
+      switch (tag) {
+      case TagBool: case TagInt: case TagEnum: case TagUInt: case TagDouble: case TagString:
+        if (! prop.write(item, readBasic(tag))) {
+          errMsg(err) << "Cannot set property '" << prop.name() << "' of "
+                      << meta->className() << ".";
+          return false;
+        }
+        break;
+
+      case TagReference: {
+        qint32 id; _stream >> id;
+        if (ConfigObjectReference *ref = prop.read(item).value<ConfigObjectReference *>())
+          _references.append(PendingReference(ref, id));
+      } break;
+
+      case TagRefList: {
+        quint32 count; _stream >> count;
+        QVector<qint32> ids; ids.reserve(count);
+        for (quint32 i=0; (i<count) && (QDataStream::Ok == _stream.status()); i++) {
+          qint32 id; _stream >> id; ids.append(id);
+        }
+        if (ConfigObjectRefList *lst = prop.read(item).value<ConfigObjectRefList *>())
+          _refLists.append(PendingRefList(lst, ids));
+      } break;
+
+      case TagList: {
+        ConfigObjectList *lst = prop.read(item).value<ConfigObjectList *>();
+        if (nullptr == lst) {
+          errMsg(err) << "Cannot restore list '" << prop.name() << "' of "
+                      << meta->className() << ".";
+          return false;
+        }
+        quint32 count; _stream >> count;
+        for (quint32 i=0; i<count; i++) {
+          ConfigItem *element = readNewItem(nullptr, nullptr, err);
+          if ((nullptr == element) || (0 > lst->add(element->as<ConfigObject>()))) {
+            errMsg(err) << "Cannot restore element " << i << " of list '" << prop.name()
+                        << "' of " << meta->className() << ".";
+            if (element)
+              delete element;
+            return false;
+          }
+        }
+      } break;
+
+      case TagNull:
+        if (prop.isWritable() && (! prop.write(item, QVariant::fromValue<ConfigItem *>(nullptr)))) {
+          errMsg(err) << "Cannot delete item '" << prop.name() << "' of "
+                      << meta->className() << ".";
+          return false;
+        }
+        break;
+
+      case TagItem:
+        if (prop.isWritable()) {
+          // Owned items are instantiated and replaced
+          ConfigItem *child = readNewItem(QMetaType(prop.userType()).metaObject(), item, err);
+          if ((nullptr == child) || (! prop.write(item, QVariant::fromValue(child)))) {
+            errMsg(err) << "Cannot restore item '" << prop.name() << "' of "
+                        << meta->className() << ".";
+            if (child)
+              delete child;
+            return false;
+          }
+        } else {
+          // Fixed items are restored in place
+          ConfigItem *child = prop.read(item).value<ConfigItem *>();
+          if ((nullptr == child) || (! readItem(child, err))) {
+            errMsg(err) << "Cannot restore item '" << prop.name() << "' of "
+                        << meta->className() << ".";
+            return false;
+          }
+        }
+        break;
+
+      default:
+        errMsg(err) << "Unknown value tag " << int(tag) << " for property '" << prop.name()
+                    << "' of " << meta->className() << ".";
+        return false;
+      }
+    }
+
+    errMsg(err) << "Cannot restore " << meta->className() << ": Snapshot truncated.";
+    return false;
+  }
+
+  /** Restores the state of some items, that is not accessible through properties. Unknown
+   * records are ignored. */
+  bool restoreState(ConfigItem *item, const QString &name, const QVariant &value) {
+    if (Channel *ch = item->as<Channel>()) {
+      if (("@defaultPower" == name) && value.toBool())
+        ch->setDefaultPower();
+      else if (("@defaultTimeout" == name) && value.toBool())
+        ch->setDefaultTimeout();
+      else if (("@defaultVOX" == name) && value.toBool())
+        ch->setVOXDefault();
+    }
+    if (AnalogChannel *ach = item->as<AnalogChannel>()) {
+      if ("@rxTone" == name)
+        ach->setRXTone(Signaling::Code(value.toInt()));
+      else if ("@txTone" == name)
+        ach->setTXTone(Signaling::Code(value.toInt()));
+    }
+    if (APRSSystem *sys = item->as<APRSSystem>()) {
+      if ("@destination" == name)
+        sys->setDestination(value.toString(), sys->destSSID());
+      else if ("@destSSID" == name)
+        sys->setDestination(sys->destination(), value.toUInt());
+      else if ("@source" == name)
+        sys->setSource(value.toString(), sys->srcSSID());
+      else if ("@srcSSID" == name)
+        sys->setSource(sys->source(), value.toUInt());
+      else if ("@path" == name)
+        sys->setPath(value.toString());
+    }
+    if (Config *conf = item->as<Config>()) {
+      if ("@defaultRadioId" == name)
+        return conf->radioIDs()->setDefaultId(value.toInt());
+    }
+    return true;
+  }
+
+protected:
+  /** A reference to resolve. */
+  typedef QPair<ConfigObjectReference *, qint32> PendingReference;
+  /** A reference list to resolve. */
+  typedef QPair<ConfigObjectRefList *, QVector<qint32>> PendingRefList;
+
+  /** The snapshot stream. */
+  QDataStream _stream;
+  /** The string table. */
+  QVector<QString> _strings;
+  /** Caches property indices per class and name. */
+  QHash<QPair<const QMetaObject *, quint32>, int> _properties;
+  /** Maps IDs to restored objects. */
+  QHash<qint32, ConfigObject *> _objects;
+  /** References to resolve. */
+  QList<PendingReference> _references;
+  /** Reference lists to resolve. */
+  QList<PendingRefList> _refLists;
+};
+
+
+/* ********************************************************************************************* *
+ * Implementation of ConfigSnapshot
+ * ********************************************************************************************* */
+bool
+ConfigSnapshot::save(const Config *config, QByteArray &data, const ErrorStack &err) {
+  SnapshotWriter writer;
+  if (! writer.writeItem(config, err)) {
+    errMsg(err) << "Cannot take snapshot of config.";
+    return false;
+  }
+  writer.finish(data);
+  return true;
+}
+
+bool
+ConfigSnapshot::load(Config *config, const QByteArray &data, const ErrorStack &err) {
+  SnapshotReader reader(data);
+  if (! reader.readHeader(err)) {
+    errMsg(err) << "Cannot restore config from snapshot.";
+    return false;
+  }
+
+  config->clear();
+  if (! reader.readItem(config, err)) {
+    errMsg(err) << "Cannot restore config from snapshot.";
+    config->clear();
+    return false;
+  }
+  reader.resolve();
+
+  if (! reader.atEnd())
+    logWarn() << "Ignore trailing data in config snapshot.";
+
+  return true;
+}
+
+bool
+ConfigSnapshot::write(const QByteArray &data, const QString &filename, const ErrorStack &err) {
+  QSaveFile file(filename);
+  if (! file.open(QIODevice::WriteOnly)) {
+    errMsg(err) << "Cannot open snapshot file '" << filename << "': " << file.errorString();
+    return false;
+  }
+  if (data.size() != file.write(data)) {
+    errMsg(err) << "Cannot write snapshot file '" << filename << "': " << file.errorString();
+    file.cancelWriting();
+    return false;
+  }
+  if (! file.commit()) {
+    errMsg(err) << "Cannot write snapshot file '" << filename << "': " << file.errorString();
+    return false;
+  }
+  return true;
+}
+
+bool
+ConfigSnapshot::write(const Config *config, const QString &filename, const ErrorStack &err) {
+  QByteArray data;
+  if (! save(config, data, err))
+    return false;
+  return write(data, filename, err);
+}
+
+bool
+ConfigSnapshot::read(Config *config, const QString &filename, const ErrorStack &err) {
+  QFile file(filename);
+  if (! file.open(QIODevice::ReadOnly)) {
+    errMsg(err) << "Cannot open snapshot file '" << filename << "': " << file.errorString();
+    return false;
+  }
+  QByteArray data = file.readAll();
+  file.close();
+  return load(config, data, err);
+}
+
+bool
+ConfigSnapshot::isSnapshot(const QByteArray &data) {
+  QDataStream stream(data);
+  stream.setVersion(SNAPSHOT_STREAM_VERSION);
+  quint32 magic = 0;
+  stream >> magic;
+  return (QDataStream::Ok == stream.status()) && (Magic == magic);
+}
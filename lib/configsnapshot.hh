@@ -0,0 +1,56 @@
+#ifndef CONFIGSNAPSHOT_HH
+#define CONFIGSNAPSHOT_HH
+
+#include <QByteArray>
+#include <QString>
+#include "errorstack.hh"
+
+class Config;
+
+
+/** Compact, versioned binary snapshot of a @c Config.
+ *
+ * While YAML remains the interchange format for codeplugs, serializing and parsing YAML is far
+ * too slow to be done frequently. A snapshot is a binary image of the complete configuration
+ * that can be taken and restored cheaply, e.g., for autosave, crash recovery, undo or to pass a
+ * configuration between processes.
+ *
+ * A snapshot starts with a magic number and the format version, followed by a table of all
+ * strings used (class names, property names and string values). Each config item is then
+ * stored as a record of its class name and its properties, where each property value is tagged
+ * with its type. References to config objects are stored as integer object IDs, which get
+ * resolved once all objects are restored. Unknown properties are skipped when reading,
+ * snapshots of newer format versions are rejected.
+ *
+ * Taking a snapshot must happen in the thread owning the config. The resulting data, however,
+ * can be written to a file in any thread (see @c write).
+ *
+ * @ingroup conf */
+class ConfigSnapshot
+{
+public:
+  /** The magic number of snapshot files. */
+  static const quint32 Magic;
+  /** The current format version. */
+  static const quint16 Version;
+
+public:
+  /** Serializes the given configuration into @c data. */
+  static bool save(const Config *config, QByteArray &data, const ErrorStack &err=ErrorStack());
+  /** Clears the given configuration and restores it from the given snapshot @c data. */
+  static bool load(Config *config, const QByteArray &data, const ErrorStack &err=ErrorStack());
+
+  /** Writes the given snapshot data into the specified file. The file gets replaced atomically,
+   * hence a crash during writing does not destroy a previous snapshot. This function does not
+   * access the config and can be called from any thread. */
+  static bool write(const QByteArray &data, const QString &filename, const ErrorStack &err=ErrorStack());
+  /** Serializes the given configuration into the specified file. */
+  static bool write(const Config *config, const QString &filename, const ErrorStack &err=ErrorStack());
+  /** Restores the given configuration from the specified snapshot file. */
+  static bool read(Config *config, const QString &filename, const ErrorStack &err=ErrorStack());
+
+  /** Returns @c true if the given data starts with a snapshot header. */
+  static bool isSnapshot(const QByteArray &data);
+};
+
+#endif // CONFIGSNAPSHOT_HH
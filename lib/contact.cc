@@ -203,7 +203,8 @@ DigitalContact::setOpenGD77ContactExtension(OpenGD77ContactExtension *ext) {
  * Implementation of ContactList
  * ********************************************************************************************* */
 ContactList::ContactList(QObject *parent)
-  : ConfigObjectList(Contact::staticMetaObject, parent)
+  : ConfigObjectList(Contact::staticMetaObject, parent), _indexValid(false), _digital(), _dtmf(),
+    _typedIndex(), _numbers(), _numberKeys()
 {
   // pass...
 }
@@ -217,45 +218,33 @@ ContactList::add(ConfigObject *obj, int row) {
 
 int
 ContactList::digitalCount() const {
-  int c=0;
-  for (int i=0; i<_items.size(); i++)
-    if (_items.at(i)->is<DigitalContact>())
-      c++;
-  return c;
+  updateIndex();
+  return _digital.size();
 }
 
 int
 ContactList::dtmfCount() const {
-  int c=0;
-  for (int i=0; i<_items.size(); i++)
-    if (_items.at(i)->is<DTMFContact>())
-      c++;
-  return c;
+  updateIndex();
+  return _dtmf.size();
 }
 
 
 int
 ContactList::indexOfDigital(DigitalContact *contact) const {
-  int idx = 0;
-  for (int i=0; i<_items.size(); i++) {
-    if (_items.at(i) == contact)
-      return idx;
-    else if (_items.at(i)->is<DigitalContact>())
-      idx++;
-  }
-  return -1;
+  updateIndex();
+  int idx = _typedIndex.value(contact, -1);
+  if ((0 > idx) || (_digital.value(idx) != contact))
+    return -1;
+  return idx;
 }
 
 int
 ContactList::indexOfDTMF(DTMFContact *contact) const {
-  int idx = 0;
-  for (int i=0; i<_items.size(); i++) {
-    if (_items.at(i) == contact)
-      return idx;
-    else if (_items.at(i)->is<DTMFContact>())
-      idx++;
-  }
-  return -1;
+  updateIndex();
+  int idx = _typedIndex.value(contact, -1);
+  if ((0 > idx) || (_dtmf.value(idx) != contact))
+    return -1;
+  return idx;
 }
 
 Contact *
@@ -267,39 +256,122 @@ ContactList::contact(int idx) const {
 
 DigitalContact *
 ContactList::digitalContact(int idx) const {
-  for (int i=0; i<_items.size(); i++) {
-    if (_items.at(i)->is<DigitalContact>()) {
-      if (0 == idx)
-        return _items.at(i)->as<DigitalContact>();
-      else
-        idx--;
-    }
-  }
-  return nullptr;
+  updateIndex();
+  return _digital.value(idx, nullptr);
 }
 
 DigitalContact *
 ContactList::findDigitalContact(unsigned number) const {
-  for (int i=0; i<_items.size(); i++) {
-    if (! _items.at(i)->is<DigitalContact>())
-      continue;
-    if (_items.at(i)->as<DigitalContact>()->number() == number)
-      return _items.at(i)->as<DigitalContact>();
+  updateIndex();
+  // If there are several contacts with the same number, return the first one
+  DigitalContact *match = nullptr;
+  foreach (DigitalContact *contact, _numbers.values(number)) {
+    if ((nullptr == match) || (_typedIndex.value(contact) < _typedIndex.value(match)))
+      match = contact;
   }
-  return nullptr;
+  return match;
 }
 
 DTMFContact *
 ContactList::dtmfContact(int idx) const {
-  for (int i=0; i<_items.size(); i++) {
-    if (_items.at(i)->is<DTMFContact>()) {
-      if (0 == idx)
-        return _items.at(i)->as<DTMFContact>();
-      else
-        idx--;
-    }
+  updateIndex();
+  return _dtmf.value(idx, nullptr);
+}
+
+bool
+ContactList::moveUp(int idx) {
+  _indexValid = false;
+  return ConfigObjectList::moveUp(idx);
+}
+
+bool
+ContactList::moveUp(int first, int last) {
+  _indexValid = false;
+  return ConfigObjectList::moveUp(first, last);
+}
+
+bool
+ContactList::moveDown(int idx) {
+  _indexValid = false;
+  return ConfigObjectList::moveDown(idx);
+}
+
+bool
+ContactList::moveDown(int first, int last) {
+  _indexValid = false;
+  return ConfigObjectList::moveDown(first, last);
+}
+
+void
+ContactList::updateIndex() const {
+  if (_indexValid)
+    return;
+  _digital.clear(); _dtmf.clear();
+  _typedIndex.clear();
+  _numbers.clear(); _numberKeys.clear();
+  for (int i=0; i<_items.size(); i++)
+    indexContact(_items.at(i)->as<Contact>());
+  _indexValid = true;
+}
+
+void
+ContactList::indexContact(Contact *contact) const {
+  if (DigitalContact *digi = contact->as<DigitalContact>()) {
+    _typedIndex.insert(digi, _digital.size());
+    _digital.append(digi);
+    _numbers.insert(digi->number(), digi);
+    _numberKeys.insert(digi, digi->number());
+  } else if (DTMFContact *dtmf = contact->as<DTMFContact>()) {
+    _typedIndex.insert(dtmf, _dtmf.size());
+    _dtmf.append(dtmf);
   }
-  return nullptr;
+}
+
+void
+ContactList::signalAdded(int idx) {
+  // Keep the index up-to-date, also during bulk updates
+  onContactAdded(idx);
+  ConfigObjectList::signalAdded(idx);
+}
+
+void
+ContactList::signalModified(int idx) {
+  onContactModified(idx);
+  ConfigObjectList::signalModified(idx);
+}
+
+void
+ContactList::signalRemoved(int idx) {
+  onContactRemoved(idx);
+  ConfigObjectList::signalRemoved(idx);
+}
+
+void
+ContactList::onContactAdded(int idx) {
+  // Appended contacts can be indexed directly, all others shift the indices of the following.
+  if (_indexValid && ((idx+1) == count()))
+    indexContact(contact(idx));
+  else
+    _indexValid = false;
+}
+
+void
+ContactList::onContactModified(int idx) {
+  if (! _indexValid)
+    return;
+  DigitalContact *digi = (nullptr != contact(idx)) ? contact(idx)->as<DigitalContact>() : nullptr;
+  if ((nullptr == digi) || (_numberKeys.value(digi) == digi->number()))
+    return;
+  _numbers.remove(_numberKeys.value(digi), digi);
+  _numbers.insert(digi->number(), digi);
+  _numberKeys.insert(digi, digi->number());
+}
+
+void
+ContactList::onContactRemoved(int idx) {
+  Q_UNUSED(idx);
+  // The removed contact may be deleted already, rebuild the index with the next access.
+  _indexValid = false;
 }
 
 ConfigItem *
@@ -77,7 +77,7 @@ class DTMFContact: public Contact
 
 public:
   /** Default constructor. */
-  explicit DTMFContact(QObject *parent=nullptr);
+  Q_INVOKABLE explicit DTMFContact(QObject *parent=nullptr);
   /** Constructs a DTMF (analog) contact.
    * @param name   Specifies the contact name.
    * @param number Specifies the DTMF number (0-9,A,B,C,D,*,#).
@@ -127,7 +127,7 @@ public:
 
 public:
   /** Default constructor. */
-  explicit DigitalContact(QObject *parent=nullptr);
+  Q_INVOKABLE explicit DigitalContact(QObject *parent=nullptr);
   /** Constructs a DMR (digital) contact.
    * @param type   Specifies the call type (private, group, all-call).
    * @param name   Specifies the contact name.
@@ -206,8 +206,44 @@ public:
   /** Returns the index of the given DTMF contact within DTMF contacts. */
   int indexOfDTMF(DTMFContact *contact) const;
 
+  bool moveUp(int idx);
+  bool moveUp(int first, int last);
+  bool moveDown(int idx);
+  bool moveDown(int first, int last);
+
 public:
   ConfigItem *allocateChild(const YAML::Node &node, ConfigItem::Context &ctx, const ErrorStack &err=ErrorStack());
+
+protected:
+  /** Rebuilds the contact index if needed. */
+  void updateIndex() const;
+  /** Appends the given contact to the contact index. */
+  void indexContact(Contact *contact) const;
+
+  void signalAdded(int idx);
+  void signalModified(int idx);
+  void signalRemoved(int idx);
+
+  /** Updates the contact index if a contact was added. */
+  void onContactAdded(int idx);
+  /** Updates the contact index if a contact was modified. */
+  void onContactModified(int idx);
+  /** Invalidates the contact index if a contact was removed. */
+  void onContactRemoved(int idx);
+
+protected:
+  /** If @c false, the contact index gets rebuilt with the next access. */
+  mutable bool _indexValid;
+  /** All digital contacts in list order. */
+  mutable QVector<DigitalContact *> _digital;
+  /** All DTMF contacts in list order. */
+  mutable QVector<DTMFContact *> _dtmf;
+  /** The index of each contact within @c _digital or @c _dtmf. */
+  mutable QHash<Contact *, int> _typedIndex;
+  /** Maps DMR numbers to digital contacts. */
+  mutable QMultiHash<unsigned, DigitalContact *> _numbers;
+  /** The number under which each digital contact is indexed. */
+  mutable QHash<DigitalContact *, unsigned> _numberKeys;
 };
 
 #endif // CONTACT_HH
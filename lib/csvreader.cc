@@ -3,31 +3,30 @@
 #include "utils.hh"
 #include "logger.hh"
 
-#include <QRegExp>
 #include <QDebug>
 
-QVector< QPair<QRegExp, CSVLexer::Token::TokenType> > CSVLexer::_pattern = {
-  { QRegExp("^n([0-9]{3})"),                     CSVLexer::Token::T_DCS_N },
-  { QRegExp("^i([0-9]{3})"),                     CSVLexer::Token::T_DCS_I },
-  { QRegExp("^([a-zA-Z0-9]{1,6}-[0-9]{1,2})"),   CSVLexer::Token::T_APRSCALL },
-  { QRegExp("^([a-zA-Z_][a-zA-Z0-9_]*)"),        CSVLexer::Token::T_KEYWORD },
-  { QRegExp("^\"([^\"\r\n]*)\""),                CSVLexer::Token::T_STRING },
-  { QRegExp("^([+-]?[0-9]+(\\.[0-9]*)?)"),       CSVLexer::Token::T_NUMBER },
-  { QRegExp("^(:)"),                             CSVLexer::Token::T_COLON },
-  { QRegExp("^(-)"),                             CSVLexer::Token::T_NOT_SET },
-  { QRegExp("^(\\+)"),                           CSVLexer::Token::T_ENABLED },
-  { QRegExp("^(,)"),                             CSVLexer::Token::T_COMMA },
-  { QRegExp("^([ \t]+)"),                        CSVLexer::Token::T_WHITESPACE },
-  { QRegExp("^(\r?\n)"),                         CSVLexer::Token::T_NEWLINE},
-  { QRegExp("^(#[^\n\r]*)"),                     CSVLexer::Token::T_COMMENT},
-};
+/** Returns @c true if the given char is an ASCII digit. */
+inline bool isDigitChar(QChar c) {
+  return (c >= QLatin1Char('0')) && (c <= QLatin1Char('9'));
+}
+
+/** Returns @c true if the given char is an ASCII letter. */
+inline bool isAlphaChar(QChar c) {
+  return ((c >= QLatin1Char('a')) && (c <= QLatin1Char('z'))) ||
+      ((c >= QLatin1Char('A')) && (c <= QLatin1Char('Z')));
+}
+
+/** Returns @c true if the given char is an ASCII letter or digit. */
+inline bool isAlnumChar(QChar c) {
+  return isAlphaChar(c) || isDigitChar(c);
+}
 
 
 /* ********************************************************************************************* *
  * Implementation of CSVLexer
  * ********************************************************************************************* */
 CSVLexer::CSVLexer(QTextStream &stream, QObject *parent)
-  : QObject(parent), _errorMessage(), _stream(stream), _stack(), _currentLine()
+  : QObject(parent), _errorMessage(), _stream(stream), _stack(), _currentLine(), _pos(0)
 {
   _stream.seek(0);
   _stack.reserve(10);
@@ -50,28 +49,129 @@ CSVLexer::next() {
 
 CSVLexer::Token
 CSVLexer::lex() {
-  if (_currentLine.isEmpty() && _stream.atEnd()) {
+  if ((_pos >= _currentLine.size()) && _stream.atEnd()) {
     return {Token::T_END_OF_STREAM, "", _stack.back().line, _stack.back().column };
-  } else if (_currentLine.isEmpty()) {
+  } else if (_pos >= _currentLine.size()) {
     Token token = {Token::T_NEWLINE, "", _stack.back().line, _stack.back().column };
     _stack.back().offset = _stream.pos();
     _currentLine = _stream.readLine();
+    _pos = 0;
     _stack.back().line++;
     _stack.back().column = 1;
     return token;
   }
-  foreach (auto pattern, _pattern) {
-    if (0 == pattern.first.indexIn(_currentLine)) {
-      Token token = {pattern.second, pattern.first.cap(1), _stack.back().line, _stack.back().column};
-      _stack.back().offset += pattern.first.matchedLength();
-      _stack.back().column += token.value.size();
-      _currentLine = _currentLine.mid(pattern.first.matchedLength());
-      return token;
+
+  // Single pass over the current line. The rules are checked in the order of precedence of the
+  // former pattern table:
+  //   n[0-9]{3}, i[0-9]{3}, [a-zA-Z0-9]{1,6}-[0-9]{1,2}, [a-zA-Z_][a-zA-Z0-9_]*, "[^"\r\n]*",
+  //   [+-]?[0-9]+(\.[0-9]*)?, ":", "-", "+", ",", [ \t]+, \r?\n, #[^\r\n]*
+  const QChar *str = _currentLine.constData() + _pos;
+  const int n = _currentLine.size() - _pos;
+  QChar c = str[0];
+
+  // Token type, offset and length of the value and the length of the complete match
+  Token::TokenType type = Token::T_ERROR;
+  int valueStart = 0, valueLength = 0, matched = 0;
+
+  if (((QLatin1Char('n') == c) || (QLatin1Char('i') == c)) && (n >= 4) &&
+      isDigitChar(str[1]) && isDigitChar(str[2]) && isDigitChar(str[3])) {
+    type = (QLatin1Char('n') == c) ? Token::T_DCS_N : Token::T_DCS_I;
+    valueStart = 1; valueLength = 3; matched = 4;
+  }
+
+  if ((Token::T_ERROR == type) && isAlnumChar(c)) {
+    int alnum = 1;
+    while ((alnum < n) && isAlnumChar(str[alnum]))
+      alnum++;
+    if ((alnum <= 6) && ((alnum+1) < n) && (QLatin1Char('-') == str[alnum]) &&
+        isDigitChar(str[alnum+1])) {
+      type = Token::T_APRSCALL;
+      matched = alnum+2;
+      if ((matched < n) && isDigitChar(str[matched]))
+        matched++;
+      valueLength = matched;
+    }
+  }
+
+  if ((Token::T_ERROR == type) && (isAlphaChar(c) || (QLatin1Char('_') == c))) {
+    matched = 1;
+    while ((matched < n) && (isAlnumChar(str[matched]) || (QLatin1Char('_') == str[matched])))
+      matched++;
+    type = Token::T_KEYWORD;
+    valueLength = matched;
+  }
+
+  if ((Token::T_ERROR == type) && (QLatin1Char('"') == c)) {
+    int end = 1;
+    while ((end < n) && (QLatin1Char('"') != str[end]) && (QLatin1Char('\r') != str[end]) &&
+           (QLatin1Char('\n') != str[end]))
+      end++;
+    if ((end < n) && (QLatin1Char('"') == str[end])) {
+      type = Token::T_STRING;
+      valueStart = 1; valueLength = end-1; matched = end+1;
+    }
+  }
+
+  if (Token::T_ERROR == type) {
+    int i = ((QLatin1Char('+') == c) || (QLatin1Char('-') == c)) ? 1 : 0;
+    if ((i < n) && isDigitChar(str[i])) {
+      while ((i < n) && isDigitChar(str[i]))
+        i++;
+      if ((i < n) && (QLatin1Char('.') == str[i])) {
+        i++;
+        while ((i < n) && isDigitChar(str[i]))
+          i++;
+      }
+      type = Token::T_NUMBER;
+      valueLength = matched = i;
+    }
+  }
+
+  if (Token::T_ERROR == type) {
+    switch (c.unicode()) {
+    case ':': type = Token::T_COLON; break;
+    case '-': type = Token::T_NOT_SET; break;
+    case '+': type = Token::T_ENABLED; break;
+    case ',': type = Token::T_COMMA; break;
+    default: break;
     }
+    if (Token::T_ERROR != type)
+      valueLength = matched = 1;
+  }
+
+  if ((Token::T_ERROR == type) && ((QLatin1Char(' ') == c) || (QLatin1Char('\t') == c))) {
+    matched = 1;
+    while ((matched < n) && ((QLatin1Char(' ') == str[matched]) || (QLatin1Char('\t') == str[matched])))
+      matched++;
+    type = Token::T_WHITESPACE;
+    valueLength = matched;
+  }
+
+  if ((Token::T_ERROR == type) && ((QLatin1Char('\n') == c) ||
+                                   ((QLatin1Char('\r') == c) && (n > 1) && (QLatin1Char('\n') == str[1])))) {
+    type = Token::T_NEWLINE;
+    valueLength = matched = (QLatin1Char('\n') == c) ? 1 : 2;
+  }
+
+  if ((Token::T_ERROR == type) && (QLatin1Char('#') == c)) {
+    matched = 1;
+    while ((matched < n) && (QLatin1Char('\r') != str[matched]) && (QLatin1Char('\n') != str[matched]))
+      matched++;
+    type = Token::T_COMMENT;
+    valueLength = matched;
   }
-  _errorMessage = tr("Lexer error %1,%2: Unexpected char '%3'.").arg(_stack.back().line)
-      .arg(_stack.back().column).arg(_currentLine.at(0));
-  return {Token::T_ERROR, _errorMessage, _stack.back().line, _stack.back().column};
+
+  if (Token::T_ERROR == type) {
+    _errorMessage = tr("Lexer error %1,%2: Unexpected char '%3'.").arg(_stack.back().line)
+        .arg(_stack.back().column).arg(c);
+    return {Token::T_ERROR, _errorMessage, _stack.back().line, _stack.back().column};
+  }
+
+  Token token = {type, QString(str+valueStart, valueLength), _stack.back().line, _stack.back().column};
+  _stack.back().offset += matched;
+  _stack.back().column += valueLength;
+  _pos += matched;
+  return token;
 }
 
 void
@@ -86,6 +186,7 @@ CSVLexer::pop() {
   _stack.pop_back();
   _stream.seek(_stack.back().offset);
   _currentLine = QString();
+  _pos = 0;
 }
 
 /* ********************************************************************************************* *
@@ -93,10 +93,10 @@ protected:
   QTextStream &_stream;
   /// The stack of saved lexer states
   QVector<State> _stack;
-  /// The current line count
+  /// The current line
   QString _currentLine;
-  /// The list of patterns to match
-  static QVector< QPair<QRegExp, Token::TokenType> > _pattern;
+  /// The position of the next token within the current line
+  int _pos;
 };
 
 
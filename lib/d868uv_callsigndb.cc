@@ -154,12 +154,7 @@ bool D868UVCallsignDB::encode(UserDatabase *db, const Selection &selection, cons
     n = std::min(n, (qint64)selection.countLimit());
 
   // Select n users and sort them in ascending order of their IDs
-  QVector<UserDatabase::User> users;
-  users.reserve(n);
-  for (unsigned i=0; i<n; i++)
-    users.append(db->user(i));
-  std::sort(users.begin(), users.end(),
-            [](const UserDatabase::User &a, const UserDatabase::User &b) { return a.id < b.id; });
+  const QVector<UserDatabase::User> users = db->selectSortedById(selection.preferredIds(), n);
 
   // Compute total size of callsign db entries
   size_t dbSize = 0;
@@ -637,7 +637,14 @@ D868UVCodeplug::encode(Config *config, const Flags &flags, const ErrorStack &err
 bool D868UVCodeplug::decode(Config *config, const ErrorStack &err) {
   // Maps code-plug indices to objects
   Context ctx(config);
-  return decodeElements(ctx, err);
+  // The lists get notified once all elements are decoded
+  config->beginUpdate();
+  bool ok = decodeElements(ctx, err);
+  // Drop the partially decoded config at once on failure
+  if (! ok)
+    config->clear();
+  config->endUpdate();
+  return ok;
 }
 
 bool
@@ -766,18 +773,21 @@ D868UVCodeplug::encodeChannels(const Flags &flags, Context &ctx, const ErrorStac
 bool
 D868UVCodeplug::createChannels(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
-  // Create channels
+  // Create channels concurrently, add them in index order
   uint8_t *channel_bitmap = data(CHANNEL_BITMAP);
-  for (uint16_t i=0; i<NUM_CHANNELS; i++) {
+  createConcurrent<Channel>(NUM_CHANNELS, [this, channel_bitmap, &ctx](unsigned i) -> Channel * {
     // Check if channel is enabled:
     uint16_t  bit = i%8, byte = i/8, bank = i/128, idx = i%128;
     if (0 == ((channel_bitmap[byte]>>bit) & 0x01))
-      continue;
+      return nullptr;
     ChannelElement ch(data(CHANNEL_BANK_0 + bank*CHANNEL_BANK_OFFSET + idx*CHANNEL_SIZE));
-    if (Channel *obj = ch.toChannelObj(ctx)) {
-      ctx.config()->channelList()->add(obj); ctx.add(obj, i);
-    }
-  }
+    return ch.toChannelObj(ctx);
+  }, [&ctx](unsigned i, Channel *obj) {
+    ctx.config()->channelList()->add(obj); ctx.add(obj, i);
+  }, [&ctx](unsigned n) {
+    ctx.config()->channelList()->reserve(ctx.config()->channelList()->count()+n);
+    ctx.reserve(&Channel::staticMetaObject, NUM_CHANNELS);
+  });
   return true;
 }
 
@@ -785,16 +795,20 @@ bool
 D868UVCodeplug::linkChannels(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
 
-  // Link channel objects
-  for (uint16_t i=0; i<NUM_CHANNELS; i++) {
+  // Link channel objects concurrently, each channel is only touched once.
+  uint8_t *channel_bitmap = data(CHANNEL_BITMAP);
+  linkConcurrent<Channel>(NUM_CHANNELS, [channel_bitmap, &ctx](unsigned i) -> Channel * {
     // Check if channel is enabled:
-    uint16_t  bit = i%8, byte = i/8, bank = i/128, idx = i%128;
-    if (0 == (((*data(CHANNEL_BITMAP+byte))>>bit) & 0x01))
-      continue;
+    uint16_t  bit = i%8, byte = i/8;
+    if ((0 == ((channel_bitmap[byte]>>bit) & 0x01)) || (! ctx.has<Channel>(i)))
+      return nullptr;
+    return ctx.get<Channel>(i);
+  }, [this, &ctx](unsigned i, Channel *obj) -> bool {
+    uint16_t bank = i/128, idx = i%128;
     ChannelElement ch(data(CHANNEL_BANK_0 + bank*CHANNEL_BANK_OFFSET + idx*CHANNEL_SIZE));
-    if (ctx.has<Channel>(i))
-      ch.linkChannelObj(ctx.get<Channel>(i), ctx);
-  }
+    ch.linkChannelObj(obj, ctx);
+    return true;
+  });
   return true;
 }
 
@@ -863,18 +877,21 @@ bool
 D868UVCodeplug::createContacts(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
 
-  // Create digital contacts
+  // Create digital contacts concurrently, add them in index order
   uint8_t *contact_bitmap = data(CONTACTS_BITMAP);
-  for (uint16_t i=0; i<NUM_CONTACTS; i++) {
+  createConcurrent<DigitalContact>(NUM_CONTACTS, [this, contact_bitmap, &ctx](unsigned i) -> DigitalContact * {
     // Check if contact is enabled:
     uint16_t  bit = i%8, byte = i/8;
     if (1 == ((contact_bitmap[byte]>>bit) & 0x01))
-      continue;
+      return nullptr;
     ContactElement con(data(CONTACT_BANK_0+i*CONTACT_SIZE));
-    if (DigitalContact *obj = con.toContactObj(ctx)) {
-      ctx.config()->contacts()->add(obj); ctx.add(obj, i);
-    }
-  }
+    return con.toContactObj(ctx);
+  }, [&ctx](unsigned i, DigitalContact *obj) {
+    ctx.config()->contacts()->add(obj); ctx.add(obj, i);
+  }, [&ctx](unsigned n) {
+    ctx.config()->contacts()->reserve(ctx.config()->contacts()->count()+n);
+    ctx.reserve(&DigitalContact::staticMetaObject, NUM_CONTACTS);
+  });
   return true;
 }
 
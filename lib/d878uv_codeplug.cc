@@ -2248,18 +2248,21 @@ bool
 D878UVCodeplug::createChannels(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
 
-  // Create channels
+  // Create channels concurrently, add them in index order
   uint8_t *channel_bitmap = data(CHANNEL_BITMAP);
-  for (uint16_t i=0; i<NUM_CHANNELS; i++) {
+  createConcurrent<Channel>(NUM_CHANNELS, [this, channel_bitmap, &ctx](unsigned i) -> Channel * {
     // Check if channel is enabled:
     uint16_t  bit = i%8, byte = i/8, bank = i/128, idx = i%128;
     if (0 == ((channel_bitmap[byte]>>bit) & 0x01))
-      continue;
+      return nullptr;
     ChannelElement ch(data(CHANNEL_BANK_0 + bank*CHANNEL_BANK_OFFSET + idx*CHANNEL_SIZE));
-    if (Channel *obj = ch.toChannelObj(ctx)) {
-      ctx.config()->channelList()->add(obj); ctx.add(obj, i);
-    }
-  }
+    return ch.toChannelObj(ctx);
+  }, [&ctx](unsigned i, Channel *obj) {
+    ctx.config()->channelList()->add(obj); ctx.add(obj, i);
+  }, [&ctx](unsigned n) {
+    ctx.config()->channelList()->reserve(ctx.config()->channelList()->count()+n);
+    ctx.reserve(&Channel::staticMetaObject, NUM_CHANNELS);
+  });
   return true;
 }
 
@@ -2267,16 +2270,20 @@ bool
 D878UVCodeplug::linkChannels(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
 
-  // Link channel objects
-  for (uint16_t i=0; i<NUM_CHANNELS; i++) {
+  // Link channel objects concurrently, each channel is only touched once.
+  uint8_t *channel_bitmap = data(CHANNEL_BITMAP);
+  linkConcurrent<Channel>(NUM_CHANNELS, [channel_bitmap, &ctx](unsigned i) -> Channel * {
     // Check if channel is enabled:
-    uint16_t  bit = i%8, byte = i/8, bank = i/128, idx = i%128;
-    if (0 == (((*data(CHANNEL_BITMAP+byte))>>bit) & 0x01))
-      continue;
+    uint16_t  bit = i%8, byte = i/8;
+    if ((0 == ((channel_bitmap[byte]>>bit) & 0x01)) || (! ctx.has<Channel>(i)))
+      return nullptr;
+    return ctx.get<Channel>(i);
+  }, [this, &ctx](unsigned i, Channel *obj) -> bool {
+    uint16_t bank = i/128, idx = i%128;
     ChannelElement ch(data(CHANNEL_BANK_0 + bank*CHANNEL_BANK_OFFSET + idx*CHANNEL_SIZE));
-    if (ctx.has<Channel>(i))
-      ch.linkChannelObj(ctx.get<Channel>(i), ctx);
-  }
+    ch.linkChannelObj(obj, ctx);
+    return true;
+  });
   return true;
 }
 
@@ -0,0 +1,185 @@
+#include "databasefetcher.hh"
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QSettings>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include "logger.hh"
+
+
+/* ********************************************************************************************* *
+ * Implementation of DatabaseFetcher
+ * ********************************************************************************************* */
+DatabaseFetcher::DatabaseFetcher(const QUrl &url, const QString &filename, QObject *parent)
+  : QObject(parent), _url(url), _filename(filename), _network(), _reply(nullptr), _file(nullptr)
+{
+  // pass...
+}
+
+const QUrl &
+DatabaseFetcher::url() const {
+  return _url;
+}
+
+const QString &
+DatabaseFetcher::filename() const {
+  return _filename;
+}
+
+unsigned
+DatabaseFetcher::age() const {
+  QFileInfo info(_filename);
+  if (! info.exists())
+    return -1;
+  QDateTime checked = QSettings(metaFilename(), QSettings::IniFormat).value(
+        "checked", info.lastModified()).toDateTime();
+  return checked.daysTo(QDateTime::currentDateTime());
+}
+
+bool
+DatabaseFetcher::isRunning() const {
+  return nullptr != _reply;
+}
+
+void
+DatabaseFetcher::fetch(bool conditional) {
+  if (isRunning())
+    return;
+
+  QFileInfo info(_filename);
+  QDir directory;
+  if ((! directory.exists(info.absolutePath())) && (! directory.mkpath(info.absolutePath()))) {
+    QString msg = QString("Cannot create path '%1'.").arg(info.absolutePath());
+    logError() << msg;
+    emit error(msg);
+    return;
+  }
+
+  _file = new QSaveFile(_filename, this);
+  if (! _file->open(QIODevice::WriteOnly)) {
+    QString msg = QString("Cannot save database at '%1': %2").arg(_filename).arg(_file->errorString());
+    logError() << msg;
+    cleanup();
+    emit error(msg);
+    return;
+  }
+
+  // Do not set the Accept-Encoding header here, otherwise QNetworkAccessManager will not
+  // decompress the response transparently.
+  QNetworkRequest request(_url);
+  if (conditional && info.exists()) {
+    QSettings meta(metaFilename(), QSettings::IniFormat);
+    if (meta.contains("etag"))
+      request.setRawHeader("If-None-Match", meta.value("etag").toByteArray());
+    if (meta.contains("lastModified"))
+      request.setRawHeader("If-Modified-Since", meta.value("lastModified").toByteArray());
+  }
+
+  logDebug() << "Fetch database from " << _url.toString() << ".";
+  _reply = _network.get(request);
+  connect(_reply, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
+  connect(_reply, SIGNAL(finished()), this, SLOT(onFinished()));
+}
+
+void
+DatabaseFetcher::abort() {
+  if (isRunning())
+    _reply->abort();
+}
+
+void
+DatabaseFetcher::onReadyRead() {
+  if ((nullptr == _reply) || (nullptr == _file))
+    return;
+
+  QByteArray data = _reply->readAll();
+  // Only the body of a successful response gets stored
+  if (data.isEmpty() || (200 != _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()))
+    return;
+  _file->write(data);
+  emit received(data);
+}
+
+void
+DatabaseFetcher::onFinished() {
+  if (nullptr == _reply)
+    return;
+
+  if (QNetworkReply::NoError != _reply->error()) {
+    QString msg = QString("Cannot download database from '%1': %2")
+        .arg(_url.toString()).arg(_reply->errorString());
+    logError() << msg;
+    cleanup();
+    emit error(msg);
+    return;
+  }
+
+  int status = _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+  if (304 == status) {
+    logDebug() << "Database at '" << _filename << "' is up-to-date.";
+    storeValidators(_reply);
+    cleanup();
+    emit unchanged();
+    return;
+  }
+
+  if (200 != status) {
+    QString msg = QString("Cannot download database from '%1': Unexpected response %2.")
+        .arg(_url.toString()).arg(status);
+    logError() << msg;
+    cleanup();
+    emit error(msg);
+    return;
+  }
+
+  onReadyRead();
+  // Replace the local copy atomically
+  if (! _file->commit()) {
+    QString msg = QString("Cannot save database at '%1': %2").arg(_filename).arg(_file->errorString());
+    logError() << msg;
+    cleanup();
+    emit error(msg);
+    return;
+  }
+
+  logDebug() << "Updated database at '" << _filename << "'.";
+  storeValidators(_reply);
+  cleanup();
+  emit updated();
+}
+
+QString
+DatabaseFetcher::metaFilename() const {
+  return _filename + ".meta";
+}
+
+void
+DatabaseFetcher::storeValidators(QNetworkReply *reply) {
+  QSettings meta(metaFilename(), QSettings::IniFormat);
+  meta.setValue("checked", QDateTime::currentDateTime());
+  // A "304 Not Modified" response may omit the validators, keep the stored ones then.
+  if (reply->hasRawHeader("ETag"))
+    meta.setValue("etag", reply->rawHeader("ETag"));
+  else if (304 != reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt())
+    meta.remove("etag");
+  if (reply->hasRawHeader("Last-Modified"))
+    meta.setValue("lastModified", reply->rawHeader("Last-Modified"));
+  else if (304 != reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt())
+    meta.remove("lastModified");
+}
+
+void
+DatabaseFetcher::cleanup() {
+  if (_file) {
+    // Discards the temporary file, if not committed yet
+    _file->cancelWriting();
+    _file->deleteLater();
+    _file = nullptr;
+  }
+  if (_reply) {
+    _reply->deleteLater();
+    _reply = nullptr;
+  }
+}
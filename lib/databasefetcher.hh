@@ -0,0 +1,94 @@
+#ifndef DATABASEFETCHER_HH
+#define DATABASEFETCHER_HH
+
+#include <QObject>
+#include <QUrl>
+#include <QNetworkAccessManager>
+
+class QNetworkReply;
+class QSaveFile;
+
+
+/** Keeps a local copy of a remote database file up-to-date.
+ *
+ * The user, talk group and repeater databases are large JSON files that rarely change. This class
+ * implements the download shared by all of them. To avoid downloading the same file again and
+ * again, the validators received with the last download (@c ETag and @c Last-Modified) are kept
+ * next to the local file and sent with the next request. If the server responds with
+ * "304 Not Modified", the local file is kept and only the time of the check gets updated.
+ *
+ * The response gets compressed by the server if possible, as @c QNetworkAccessManager requests
+ * gzip/deflate encoded responses and decompresses them transparently. The body is streamed into a
+ * temporary file as it arrives and replaces the local file atomically once the download is
+ * complete. Hence a failed or aborted download never destroys the local copy.
+ *
+ * @ingroup util */
+class DatabaseFetcher : public QObject
+{
+  Q_OBJECT
+
+public:
+  /** Constructs a fetcher for the given remote @c url, keeping the local copy at @c filename. */
+  DatabaseFetcher(const QUrl &url, const QString &filename, QObject *parent=nullptr);
+
+  /** Returns the URL of the remote database. */
+  const QUrl &url() const;
+  /** Returns the path to the local copy. */
+  const QString &filename() const;
+
+  /** Returns the number of days since the local copy was checked to be up-to-date the last time.
+   * If there is no local copy, -1 is returned. */
+  unsigned age() const;
+  /** Returns @c true while a download is running. */
+  bool isRunning() const;
+
+public slots:
+  /** Checks for a new version of the database and downloads it if needed.
+   *
+   * If @c conditional is @c false, the stored validators are not sent and the database gets
+   * downloaded in any case. This is needed if the local copy exists but cannot be used, as the
+   * server would otherwise answer with "304 Not Modified". */
+  void fetch(bool conditional=true);
+  /** Aborts a running download, the local copy is kept. */
+  void abort();
+
+signals:
+  /** Gets emitted once a new version of the database got stored. */
+  void updated();
+  /** Gets emitted if the local copy is still up-to-date. */
+  void unchanged();
+  /** Gets emitted if the download failed. */
+  void error(const QString &msg);
+  /** Gets emitted for every chunk of the new version as it arrives. This allows to process the
+   * database while it is still downloading. The chunks are only valid if the download finishes
+   * with @c updated. */
+  void received(const QByteArray &data);
+
+private slots:
+  /** Stores received data. */
+  void onReadyRead();
+  /** Finishes the download. */
+  void onFinished();
+
+private:
+  /** Returns the path to the file holding the validators of the local copy. */
+  QString metaFilename() const;
+  /** Records the time of the last check and the validators of the given reply. */
+  void storeValidators(QNetworkReply *reply);
+  /** Drops the running download. */
+  void cleanup();
+
+private:
+  /** The remote URL. */
+  QUrl _url;
+  /** The path to the local copy. */
+  QString _filename;
+  /** The network access. */
+  QNetworkAccessManager _network;
+  /** The running request. */
+  QNetworkReply *_reply;
+  /** The temporary file, the response is written to. */
+  QSaveFile *_file;
+};
+
+#endif // DATABASEFETCHER_HH
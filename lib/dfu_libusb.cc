@@ -125,6 +125,14 @@ DFUDevice::DFUDevice(const USBDeviceDescriptor &descr, const ErrorStack &err, QO
     return;
   }
 
+  libusb_device_descriptor usb_descr;
+  unsigned char serial[128];
+  if ((0 == libusb_get_device_descriptor(libusb_get_device(_dev), &usb_descr)) && usb_descr.iSerialNumber) {
+    int len = libusb_get_string_descriptor_ascii(_dev, usb_descr.iSerialNumber, serial, sizeof(serial));
+    if (0 < len)
+      _serial = QString::fromLatin1((const char *)serial, len);
+  }
+
   logDebug() << "Connected to DFU device " << descr.description() << ".";
 }
 
@@ -190,6 +198,11 @@ DFUDevice::close() {
   _dev = nullptr;
 }
 
+const QString &
+DFUDevice::serialNumber() const {
+  return _serial;
+}
+
 
 int
 DFUDevice::download(unsigned block, uint8_t *data, unsigned len, const ErrorStack &err) {
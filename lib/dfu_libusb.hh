@@ -45,6 +45,8 @@ public:
   bool isOpen() const;
   /** Closes the DFU iterface. */
   void close();
+  /** Returns the USB serial number of the device, if reported. */
+  const QString &serialNumber() const;
 
   /** Downloads some data to the device. */
   int download(unsigned block, uint8_t *data, unsigned len, const ErrorStack &err=ErrorStack());
@@ -76,6 +78,8 @@ protected:
 	libusb_device_handle *_dev;
   /** Device status. */
 	status_t _status;
+  /** USB serial number of the device, empty if not reported. */
+  QString _serial;
 };
 
 #endif // DFU_LIBUSB_HH
@@ -38,6 +38,16 @@ GD77::codeplug() {
   return _codeplug;
 }
 
+const CallsignDB *
+GD77::callsignDB() const {
+  return &_callsigns;
+}
+
+CallsignDB *
+GD77::callsignDB() {
+  return &_callsigns;
+}
+
 RadioInfo
 GD77::defaultRadioInfo() {
   return RadioInfo(
@@ -55,9 +65,9 @@ GD77::startUploadCallsignDB(UserDatabase *db, bool blocking, const CallsignDB::S
     return false;
   }
 
-  // Assemble call-sign db from user DB
-  logDebug() << "Encode call-signs into db.";
-  _callsigns.encode(db, selection);
+  // Call-sign db gets assembled from user DB within the radio thread
+  _userDB = db;
+  _selection = selection;
 
   _task = StatusUploadCallsigns;
   if (blocking) {
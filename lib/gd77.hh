@@ -31,6 +31,9 @@ public:
   const Codeplug &codeplug() const;
   Codeplug &codeplug();
 
+  const CallsignDB *callsignDB() const;
+  CallsignDB *callsignDB();
+
   /** Returns the default radio information. The actual instance may have different properties
    * due to variants of the same radio. */
   static RadioInfo defaultRadioInfo();
@@ -93,14 +93,9 @@ GD77CallsignDB::encode(UserDatabase *calldb, const Selection &selection, const E
   if (0 == n)
     return true;
 
-  // Select first n entries and sort them in ascending order of their IDs
-  logDebug() << "Select first " << n << " entries out off " << calldb->count() << ".";
-  QVector<UserDatabase::User> users;
-  for (unsigned i=0; i<n; i++)
-    users.append(calldb->user(i));
-  logDebug() << "Sort selected w.r.t their ID in ascending order.";
-  std::sort(users.begin(), users.end(),
-            [](const UserDatabase::User &a, const UserDatabase::User &b) { return a.id < b.id; });
+  // Select n entries closest to the preferred IDs and sort them in ascending order of their IDs
+  logDebug() << "Select " << n << " entries out off " << calldb->count() << ".";
+  const QVector<UserDatabase::User> users = calldb->selectSortedById(selection.preferredIds(), n);
 
   // Allocate segment for user db if requested
   unsigned size = align_size(sizeof(userdb_t)+n*sizeof(userdb_entry_t), BLOCK_SIZE);
@@ -111,9 +106,12 @@ GD77CallsignDB::encode(UserDatabase *calldb, const Selection &selection, const E
   userdb_t *userdb = (userdb_t *)this->data(OFFSET_USERDB);
   userdb->clear(); userdb->setSize(n);
   userdb_entry_t *db = (userdb_entry_t *)this->data(OFFSET_USERDB+sizeof(userdb_t));
-  for (unsigned i=0; i<n; i++) {
-    db[i].fromEntry(users[i]);
-  }
+  memset(db, 0, n*sizeof(userdb_entry_t));
+  // Encode IDs and calls of all entries at once
+  encode_dmr_ids_bcd_le((uint8_t *)&(db[0].number), sizeof(userdb_entry_t),
+                        (const uint32_t *)&(users[0].id), sizeof(UserDatabase::User), n);
+  encode_ascii_n((uint8_t *)(db[0].name), sizeof(userdb_entry_t),
+                 &(users[0].call), sizeof(UserDatabase::User), n, 7, 0x00);
 
   return true;
 }
@@ -98,6 +98,15 @@ HIDevice::HIDevice(const USBDeviceDescriptor &descr, const ErrorStack &err, QObj
     libusb_exit(_ctx);
     _dev = nullptr;
     _ctx = nullptr;
+    return;
+  }
+
+  libusb_device_descriptor usb_descr;
+  unsigned char serial[128];
+  if ((0 == libusb_get_device_descriptor(libusb_get_device(_dev), &usb_descr)) && usb_descr.iSerialNumber) {
+    int len = libusb_get_string_descriptor_ascii(_dev, usb_descr.iSerialNumber, serial, sizeof(serial));
+    if (0 < len)
+      _serial = QString::fromLatin1((const char *)serial, len);
   }
 }
 
@@ -151,6 +160,11 @@ HIDevice::isOpen() const {
   return (nullptr != _ctx) && (nullptr != _dev);
 }
 
+const QString &
+HIDevice::serialNumber() const {
+  return _serial;
+}
+
 void
 HIDevice::close() {
   if (nullptr == _ctx)
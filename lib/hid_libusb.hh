@@ -41,6 +41,8 @@ public:
 
   /** Close connection to device. */
 	void close();
+  /** Returns the USB serial number of the device, if reported. */
+  const QString &serialNumber() const;
 
 public:
   /** Finds all HID interfaces with the specified VID/PID combination. */
@@ -66,6 +68,8 @@ protected:
 	volatile int _nbytes_received;
   /** Internal used error stack for the static callback function. */
   ErrorStack _cbError;
+  /** USB serial number of the device, empty if not reported. */
+  QString _serial;
 };
 
 #endif // HID_MACOS_HH
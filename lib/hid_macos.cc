@@ -154,6 +154,11 @@ HIDevice::isOpen() const {
   return nullptr != _dev;
 }
 
+const QString &
+HIDevice::serialNumber() const {
+  return _serial;
+}
+
 //
 // Send a request to the device.
 // Store the reply into the rdata[] array.
@@ -279,6 +284,10 @@ HIDevice::callback_open(void *context, IOReturn result, void *sender, IOHIDDevic
   IOHIDDeviceRegisterInputReportCallback(deviceRef, self->_transfer_buf, sizeof(self->_transfer_buf),
                                          callback_input, self);
 
+  CFTypeRef serial = IOHIDDeviceGetProperty(deviceRef, CFSTR(kIOHIDSerialNumberKey));
+  if (serial && (CFStringGetTypeID() == CFGetTypeID(serial)))
+    self->_serial = QString::fromCFString((CFStringRef)serial);
+
   self->_dev = deviceRef;
 }
 
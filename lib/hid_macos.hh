@@ -42,6 +42,8 @@ public:
 
   /** Close connection to device. */
 	void close();
+  /** Returns the USB serial number of the device, if reported. */
+  const QString &serialNumber() const;
 
 public:
   /** Finds all HID interfaces with the specified VID/PID combination. */
@@ -67,6 +69,8 @@ protected:
 	unsigned char _receive_buf[42];
 	/** Receive result. */
 	volatile int _nbytes_received = 0;
+  /** USB serial number of the device, empty if not reported. */
+  QString _serial;
 };
 
 #endif // HID_MACOS_HH
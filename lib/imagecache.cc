@@ -0,0 +1,211 @@
+#include "imagecache.hh"
+#include "dfufile.hh"
+#include "logger.hh"
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <QByteArray>
+
+// Number of blocks spread over each image that get compared in addition to the first block of
+// every element.
+#define FINGERPRINT_BLOCKS 16
+
+
+/** A copy of a single element of a cached image. */
+struct CachedElement {
+  uint32_t address;
+  QByteArray data;
+};
+
+/** A copy of all images of a codeplug. */
+typedef QVector<QVector<CachedElement>> CachedImage;
+
+static QMutex cacheLock;
+static QHash<QString, CachedImage> cache;
+
+
+/** Returns @c true if the memory layout of the cached image matches the given codeplug. */
+static bool
+matchesLayout(const CachedImage &cached, const DFUFile &codeplug) {
+  if (cached.count() != codeplug.numImages())
+    return false;
+  for (int i=0; i<codeplug.numImages(); i++) {
+    const DFUFile::Image &image = codeplug.image(i);
+    if (cached[i].count() != image.numElements())
+      return false;
+    for (int n=0; n<image.numElements(); n++) {
+      if ((cached[i][n].address != image.element(n).address()) ||
+          (cached[i][n].data.size() != image.element(n).data().size()))
+        return false;
+    }
+  }
+  return true;
+}
+
+/** Reads the specified region block by block using @c read. */
+static bool
+readRegion(const ImageCache::BlockReader &read, const ImageCache::Region &region, uint8_t *data,
+           unsigned blockSize, const ErrorStack &err)
+{
+  for (uint32_t offset=0; offset<region.size; offset+=blockSize) {
+    if (! read(region.image, region.address+offset, data+offset, err))
+      return false;
+  }
+  return true;
+}
+
+/** Collects the fingerprint blocks of the given image. */
+static QList<ImageCache::Region>
+fingerprint(int img, const QVector<CachedElement> &image, unsigned blockSize) {
+  QList<ImageCache::Region> blocks;
+  unsigned total = 0;
+  foreach (const CachedElement &el, image) {
+    if (el.data.size() >= int(blockSize))
+      blocks.append({img, el.address, blockSize});
+    total += el.data.size()/blockSize;
+  }
+  if (0 == total)
+    return blocks;
+
+  // Spread some more blocks evenly over the entire image
+  unsigned step = std::max(1u, total/FINGERPRINT_BLOCKS);
+  for (unsigned b=step/2, offset=0, n=0; (b<total) && (n<unsigned(image.count())); ) {
+    unsigned nb = image[n].data.size()/blockSize;
+    if (b >= (offset+nb)) {
+      offset += nb; n++;
+      continue;
+    }
+    uint32_t addr = image[n].address + (b-offset)*blockSize;
+    if (addr != image[n].address)
+      blocks.append({img, addr, blockSize});
+    b += step;
+  }
+  return blocks;
+}
+
+
+QString
+ImageCache::key(const QString &model, const QString &serial) {
+  if (serial.isEmpty())
+    return model;
+  return model + " #" + serial;
+}
+
+void
+ImageCache::store(const QString &key, const DFUFile &codeplug) {
+  CachedImage cached(codeplug.numImages());
+  for (int i=0; i<codeplug.numImages(); i++) {
+    const DFUFile::Image &image = codeplug.image(i);
+    cached[i].reserve(image.numElements());
+    for (int n=0; n<image.numElements(); n++)
+      cached[i].append({image.element(n).address(), image.element(n).data()});
+  }
+
+  QMutexLocker locker(&cacheLock);
+  cache.insert(key, cached);
+  logDebug() << "Cached codeplug image of '" << key << "'.";
+}
+
+void
+ImageCache::invalidate(const QString &key) {
+  QMutexLocker locker(&cacheLock);
+  cache.remove(key);
+}
+
+void
+ImageCache::clear() {
+  QMutexLocker locker(&cacheLock);
+  cache.clear();
+}
+
+bool
+ImageCache::restore(const QString &key, DFUFile &codeplug, unsigned blockSize,
+                    const QList<Region> &volatileRegions, const BlockReader &read)
+{
+  QMutexLocker locker(&cacheLock);
+  if (! cache.contains(key))
+    return false;
+  // Implicitly shared, hence cheap. Only accessed read-only to avoid a deep copy.
+  const CachedImage cached = cache.value(key);
+  locker.unlock();
+
+  if (! matchesLayout(cached, codeplug)) {
+    logDebug() << "Cached image of '" << key << "' does not match codeplug layout.";
+    return false;
+  }
+
+  // Compare fingerprint blocks with the device
+  QByteArray buffer(blockSize, 0);
+  for (int i=0; i<cached.count(); i++) {
+    foreach (const Region &block, fingerprint(i, cached[i], blockSize)) {
+      ErrorStack err;
+      if (! read(block.image, block.address, (uint8_t *)buffer.data(), err)) {
+        logWarn() << "Cannot read fingerprint block at 0x" << QString::number(block.address, 16)
+                  << ": Ignore cached image:\n  " << err.format("  ");
+        return false;
+      }
+      const CachedElement *el = nullptr;
+      for (const CachedElement &e: cached[i]) {
+        if ((e.address <= block.address) && ((block.address+block.size) <= (e.address+e.data.size())))
+          el = &e;
+      }
+      if ((nullptr == el) ||
+          (0 != memcmp(buffer.constData(), el->data.constData()+(block.address-el->address), block.size)))
+      {
+        logDebug() << "Fingerprint of '" << key << "' does not match at 0x"
+                   << QString::number(block.address, 16) << ": Read entire codeplug.";
+        return false;
+      }
+    }
+  }
+
+  // Restore cached image
+  for (int i=0; i<cached.count(); i++) {
+    DFUFile::Image &image = codeplug.image(i);
+    for (int n=0; n<image.numElements(); n++)
+      image.element(n).data() = cached[i][n].data;
+  }
+
+  // Read regions modified by the radio itself
+  foreach (const Region &region, volatileRegions) {
+    if (nullptr == codeplug.data(region.address, region.image))
+      continue;
+    ErrorStack err;
+    if (! readRegion(read, region, codeplug.data(region.address, region.image), blockSize, err)) {
+      logWarn() << "Cannot read region at 0x" << QString::number(region.address, 16)
+                << ": Ignore cached image:\n  " << err.format("  ");
+      return false;
+    }
+  }
+
+  logDebug() << "Restored codeplug of '" << key << "' from cache.";
+  return true;
+}
+
+bool
+ImageCache::restoreOrRead(const QString &key, DFUFile &codeplug, unsigned blockSize,
+                          const QList<Region> &volatileRegions, const BlockReader &read,
+                          const Progress &progress, const ErrorStack &err)
+{
+  if (restore(key, codeplug, blockSize, volatileRegions, read))
+    return true;
+
+  size_t total = codeplug.memSize(), count = 0;
+  for (int i=0; i<codeplug.numImages(); i++) {
+    DFUFile::Image &image = codeplug.image(i);
+    for (int n=0; n<image.numElements(); n++) {
+      uint32_t b0 = image.element(n).address()/blockSize;
+      uint32_t nb = image.element(n).data().size()/blockSize;
+      for (uint32_t b=b0; b<(b0+nb); b++, count+=blockSize) {
+        if (! read(i, b*blockSize, codeplug.data(b*blockSize, i), err)) {
+          errMsg(err) << "Cannot read block " << b << " of image " << i << ".";
+          return false;
+        }
+        progress(count+blockSize, total);
+      }
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,74 @@
+#ifndef IMAGECACHE_HH
+#define IMAGECACHE_HH
+
+#include <QString>
+#include <QList>
+#include <functional>
+#include <inttypes.h>
+#include "errorstack.hh"
+
+class DFUFile;
+
+
+/** Process-wide cache of the last codeplug image read from or written to each radio.
+ *
+ * Before a codeplug gets uploaded, the current codeplug is read back from the device to maintain
+ * all settings not managed by qdmr. This doubles the transfer time. If the same radio was read or
+ * written before, the cached image is used instead. To ensure that the radio still holds the
+ * cached image, a small set of fingerprint blocks gets read from the device and compared to the
+ * cached image. Regions that are changed by the radio itself (e.g., VFO and boot settings) are
+ * always read from the device.
+ *
+ * The cache is kept in memory only and is shared among all radio instances, as a new radio
+ * instance is created for every transfer.
+ *
+ * @ingroup util */
+class ImageCache
+{
+public:
+  /** A memory region within an image of a codeplug. */
+  struct Region {
+    int image;         ///< Index of the image.
+    uint32_t address;  ///< Start address of the region.
+    uint32_t size;     ///< Size of the region in bytes.
+  };
+
+  /** Reads a single block of the given image at the specified address from the device into
+   * @c data. */
+  typedef std::function<bool(int image, uint32_t address, uint8_t *data, const ErrorStack &err)> BlockReader;
+  /** Gets called after each block read with the number of bytes read so far and the total number
+   * of bytes to read. */
+  typedef std::function<void(size_t count, size_t total)> Progress;
+
+public:
+  /** Assembles the key identifying a radio from its model name and the serial number reported by
+   * the device. If the device does not report a serial number, the model name alone is used and
+   * the fingerprint blocks are the only means to tell two radios of the same model apart. */
+  static QString key(const QString &model, const QString &serial);
+
+  /** Stores a copy of the given codeplug as the current image of the radio identified by
+   * @c key. */
+  static void store(const QString &key, const DFUFile &codeplug);
+  /** Drops the cached image of the radio identified by @c key. */
+  static void invalidate(const QString &key);
+  /** Drops all cached images. */
+  static void clear();
+
+  /** Restores the given codeplug from the cached image of the radio identified by @c key.
+   *
+   * The cached image is only used if its memory layout matches the layout of the given codeplug
+   * and the fingerprint blocks of @c blockSize bytes read from the device using @c read match the
+   * cached image. The given volatile regions get read from the device in any case. Returns
+   * @c false if the cached image cannot be used, the codeplug must then be read entirely. */
+  static bool restore(const QString &key, DFUFile &codeplug, unsigned blockSize,
+                      const QList<Region> &volatileRegions, const BlockReader &read);
+
+  /** Restores the given codeplug from the cached image of the radio identified by @c key (see
+   * @c restore) or, if the cached image cannot be used, reads all elements of the codeplug block
+   * by block from the device using @c read. Returns @c false if the codeplug cannot be read. */
+  static bool restoreOrRead(const QString &key, DFUFile &codeplug, unsigned blockSize,
+                            const QList<Region> &volatileRegions, const BlockReader &read,
+                            const Progress &progress, const ErrorStack &err=ErrorStack());
+};
+
+#endif // IMAGECACHE_HH
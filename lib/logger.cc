@@ -2,27 +2,31 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QDateTime>
+#include <QMutexLocker>
+#include <algorithm>
 
 
 /* ********************************************************************************************* *
  * Implementation of LogMessage
  * ********************************************************************************************* */
 LogMessage::LogMessage(Level level, const QString &file, int line, const QString &message)
-  : QTextStream(), _level(level), _file(file), _line(line), _message(message)
+  : QTextStream(), _level(level), _file(file), _line(line), _message(message), _forward(true)
 {
   this->setString(&_message);
   this->seek(_message.size());
 }
 
 LogMessage::LogMessage(const LogMessage &other)
-  : QTextStream(), _level(other._level), _file(other._file), _line(other._line), _message(other._message)
+  : QTextStream(), _level(other._level), _file(other._file), _line(other._line),
+    _message(other._message), _forward(other._forward)
 {
   this->setString(&_message);
   this->seek(_message.size());
 }
 
 LogMessage::~LogMessage() {
-  Logger::get().log(*this);
+  if (_forward && Logger::isEnabled(_level))
+    Logger::get().log(*this);
 }
 
 LogMessage::Level
@@ -59,14 +63,25 @@ LogHandler::~LogHandler() {
   // pass...
 }
 
+LogMessage::Level
+LogHandler::minLevel() const {
+  return LogMessage::DEBUG;
+}
+
+void
+LogHandler::flush() {
+  // pass...
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of Logger
  * ********************************************************************************************* */
 Logger *Logger::_instance = nullptr;
+std::atomic<int> Logger::_minLevel(LogMessage::FATAL+1);
 
 Logger::Logger()
-  : QObject(nullptr), _handler()
+  : QObject(nullptr), _handler(), _lock(QMutex::Recursive)
 {
   // pass...
 }
@@ -77,6 +92,7 @@ Logger::~Logger() {
 
 void
 Logger::log(const LogMessage &msg) {
+  QMutexLocker locker(&_lock);
   foreach (LogHandler *handler, _handler) {
     handler->handle(msg);
   }
@@ -86,25 +102,46 @@ void
 Logger::addHandler(LogHandler *handler) {
   if (nullptr == handler)
     return;
+  QMutexLocker locker(&_lock);
   if (_handler.contains(handler))
     return;
   handler->setParent(this);
   _handler.append(handler);
   connect(handler, SIGNAL(destroyed(QObject*)), this, SLOT(onHandlerDeleted(QObject*)));
+  connect(handler, SIGNAL(minLevelChanged()), this, SLOT(updateMinLevel()));
+  updateMinLevel();
 }
 
 void
 Logger::remHandler(LogHandler *handler) {
+  QMutexLocker locker(&_lock);
   if (_handler.contains(handler)) {
     handler->setParent(nullptr);
     disconnect(handler, SIGNAL(destroyed(QObject*)), this, SLOT(onHandlerDeleted(QObject*)));
+    disconnect(handler, SIGNAL(minLevelChanged()), this, SLOT(updateMinLevel()));
   }
   _handler.removeAll(handler);
+  updateMinLevel();
 }
 
 void
 Logger::onHandlerDeleted(QObject *obj) {
-  _handler.removeAll(dynamic_cast<LogHandler*>(obj));
+  QMutexLocker locker(&_lock);
+  // The handler is already destructed down to its QObject base, compare addresses only
+  for (int i=_handler.size()-1; i>=0; i--) {
+    if (static_cast<QObject *>(_handler.at(i)) == obj)
+      _handler.removeAt(i);
+  }
+  updateMinLevel();
+}
+
+void
+Logger::updateMinLevel() {
+  QMutexLocker locker(&_lock);
+  int level = LogMessage::FATAL+1;
+  foreach (LogHandler *handler, _handler)
+    level = std::min(level, int(handler->minLevel()));
+  _minLevel = level;
 }
 
 Logger &
@@ -120,7 +157,7 @@ Logger::get() {
  * Implementation of StreamLogHandler
  * ********************************************************************************************* */
 StreamLogHandler::StreamLogHandler(QTextStream &stream, LogMessage::Level minLevel, bool color, QObject *parent)
-  : LogHandler(parent), _stream(stream), _minLevel(minLevel), _color(color)
+  : LogHandler(parent), _stream(stream), _minLevel(minLevel), _color(color), _autoFlush(true)
 {
   // pass...
 }
@@ -133,6 +170,17 @@ StreamLogHandler::minLevel() const {
 void
 StreamLogHandler::setMinLevel(LogMessage::Level minLevel) {
   _minLevel = minLevel;
+  emit minLevelChanged();
+}
+
+bool
+StreamLogHandler::autoFlush() const {
+  return _autoFlush;
+}
+
+void
+StreamLogHandler::setAutoFlush(bool enable) {
+  _autoFlush = enable;
 }
 
 void
@@ -171,6 +219,12 @@ StreamLogHandler::handle(const LogMessage &message) {
           << ": " << message.message() << "\n";
   if (_color)
     _stream << "\033[39m";
+  if (_autoFlush)
+    _stream.flush();
+}
+
+void
+StreamLogHandler::flush() {
   _stream.flush();
 }
 
@@ -217,6 +271,7 @@ FileLogHandler::minLevel() const {
 void
 FileLogHandler::setMinLevel(LogMessage::Level minLevel) {
   _minLevel = minLevel;
+  emit minLevelChanged();
 }
 
 void
@@ -238,3 +293,100 @@ FileLogHandler::handle(const LogMessage &message) {
   _stream << "in " << message.file() << "@" << message.line()
           << ": " << message.message() << "\n";
 }
+
+void
+FileLogHandler::flush() {
+  if (_file.isOpen())
+    _stream.flush();
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of AsyncLogHandler
+ * ********************************************************************************************* */
+AsyncLogHandler::AsyncLogHandler(LogHandler *handler, unsigned capacity, QObject *parent)
+  : LogHandler(parent), _handler(handler), _buffer(std::max(1u, capacity)), _head(0), _count(0),
+    _stop(false), _busy(0), _lock(), _notEmpty(), _notFull(), _thread()
+{
+  _handler->setParent(this);
+  connect(_handler, SIGNAL(minLevelChanged()), this, SIGNAL(minLevelChanged()));
+  _thread = std::thread(&AsyncLogHandler::run, this);
+}
+
+AsyncLogHandler::~AsyncLogHandler() {
+  _lock.lock();
+  _stop = true;
+  _notEmpty.wakeAll();
+  _lock.unlock();
+  // The background thread writes all pending messages before it stops
+  _thread.join();
+}
+
+LogMessage::Level
+AsyncLogHandler::minLevel() const {
+  return _handler->minLevel();
+}
+
+void
+AsyncLogHandler::handle(const LogMessage &message) {
+  if (message.level() < _handler->minLevel())
+    return;
+
+  QMutexLocker locker(&_lock);
+  // Wait for free space, this only happens if messages are logged faster than they get written
+  while (_count == _buffer.size())
+    _notFull.wait(&_lock);
+
+  Entry &entry = _buffer[(_head+_count) % _buffer.size()];
+  entry.level = message.level();
+  entry.file = message.file();
+  entry.line = message.line();
+  entry.message = message.message();
+  _count++;
+  _notEmpty.wakeOne();
+}
+
+void
+AsyncLogHandler::flush() {
+  // Wait until all queued messages are written
+  QMutexLocker locker(&_lock);
+  while (_count || _busy)
+    _notFull.wait(&_lock);
+}
+
+void
+AsyncLogHandler::run() {
+  QVector<Entry> batch;
+  batch.reserve(_buffer.size());
+
+  QMutexLocker locker(&_lock);
+  while (true) {
+    while ((0 == _count) && (! _stop))
+      _notEmpty.wait(&_lock);
+    if ((0 == _count) && _stop)
+      break;
+
+    // Take all queued messages at once
+    batch.clear();
+    for (; _count; _count--, _head = (_head+1) % _buffer.size()) {
+      batch.append(_buffer[_head]);
+      _buffer[_head].file.clear();
+      _buffer[_head].message.clear();
+    }
+    _busy++;
+    _notFull.wakeAll();
+
+    // Write the batch without holding the lock
+    locker.unlock();
+    foreach (const Entry &entry, batch) {
+      LogMessage msg(entry.level, entry.file, entry.line, entry.message);
+      msg._forward = false;
+      _handler->handle(msg);
+    }
+    _handler->flush();
+    locker.relock();
+
+    _busy--;
+    _notFull.wakeAll();
+  }
+}
@@ -6,17 +6,26 @@
 #include <QFile>
 #include <QTextStream>
 #include <QList>
-
+#include <QMutex>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+#include <thread>
+
+/** Constructs a message of the given level, if any handler accepts that level. Otherwise, the
+ * message is neither constructed nor are the streamed values evaluated and formatted. */
+#define logMessage(level) \
+  (! Logger::isEnabled(level)) ? (void)0 : LogMessageVoidify() & LogMessage(level, __FILE__, __LINE__)
 /** Constructs a debug message. */
-#define logDebug() LogMessage(LogMessage::DEBUG, __FILE__, __LINE__)
+#define logDebug() logMessage(LogMessage::DEBUG)
 /** Constructs an info message. */
-#define logInfo()  LogMessage(LogMessage::INFO, __FILE__, __LINE__)
+#define logInfo()  logMessage(LogMessage::INFO)
 /** Constructs a warning message. */
-#define logWarn()  LogMessage(LogMessage::WARNING, __FILE__, __LINE__)
+#define logWarn()  logMessage(LogMessage::WARNING)
 /** Constructs an error message. */
-#define logError() LogMessage(LogMessage::ERROR, __FILE__, __LINE__)
+#define logError() logMessage(LogMessage::ERROR)
 /** Constructs a fatal error message. */
-#define logFatal() LogMessage(LogMessage::FATAL, __FILE__, __LINE__)
+#define logFatal() logMessage(LogMessage::FATAL)
 
 
 /** Implements a log-message.
@@ -65,6 +74,22 @@ protected:
   int _line;
   /** The log message content. */
   QString _message;
+  /** If @c false, the message is not forwarded to the logger on destruction. This is used by
+   * handlers, that replay messages later. */
+  bool _forward;
+
+  friend class AsyncLogHandler;
+};
+
+
+/** Helper to turn a streamed log message into a @c void expression. The @c & operator binds
+ * weaker than @c <<, hence the complete message gets assembled first.
+ * @ingroup log */
+class LogMessageVoidify
+{
+public:
+  /** Discards the given stream. */
+  inline void operator&(const QTextStream &) const { }
 };
 
 
@@ -81,6 +106,15 @@ public:
   virtual ~LogHandler();
   /** Callback to handle log messages. */
   virtual void handle(const LogMessage &message) = 0;
+  /** Returns the minimum level of messages, this handler accepts. The default implementation
+   * accepts all messages. */
+  virtual LogMessage::Level minLevel() const;
+  /** Flushes any buffered output. The default implementation does nothing. */
+  virtual void flush();
+
+signals:
+  /** Gets emitted if the minimum level of the handler changed. */
+  void minLevelChanged();
 };
 
 
@@ -108,16 +142,29 @@ public:
 protected slots:
   /** Internal callback to handle deleted handler objects. */
   void onHandlerDeleted(QObject *obj);
+  /** Recomputes the minimum level accepted by any handler. */
+  void updateMinLevel();
 
 public:
   /** Factory method to get the singleton instance. */
   static Logger &get();
 
+  /** Returns @c true if any handler accepts messages of the given level. This check is cheap and
+   * gets performed before a message is assembled. */
+  static inline bool isEnabled(LogMessage::Level level) {
+    return int(level) >= _minLevel.load(std::memory_order_relaxed);
+  }
+
 protected:
   /** The singleton instance. */
   static Logger *_instance;
   /** The list of registered log-handler. */
   QList<LogHandler *> _handler;
+  /** Serializes the dispatch of messages, as these may be logged from several threads. */
+  QMutex _lock;
+  /** The minimum level accepted by any handler. If there are no handlers, no level is
+   * accepted. */
+  static std::atomic<int> _minLevel;
 };
 
 
@@ -140,7 +187,14 @@ public:
   /** Resets the minimum log level. */
   void setMinLevel(LogMessage::Level minLevel);
 
+  /** If @c true (default), the stream gets flushed after every message. */
+  bool autoFlush() const;
+  /** Enables or disables flushing the stream after every message. If disabled, the stream gets
+   * flushed by @c flush, e.g., by an @c AsyncLogHandler after a batch of messages. */
+  void setAutoFlush(bool enable);
+
   void handle(const LogMessage &message);
+  void flush();
 
 protected:
   /** A reference to the text stream to log into. */
@@ -149,6 +203,8 @@ protected:
   LogMessage::Level _minLevel;
   /** If true, write messages using console colors. */
   bool _color;
+  /** If true, the stream gets flushed after every message. */
+  bool _autoFlush;
 };
 
 
@@ -174,6 +230,7 @@ public:
   void setMinLevel(LogMessage::Level minLevel);
 
   void handle(const LogMessage &message);
+  void flush();
 
 protected:
   /** The file to log into. */
@@ -184,4 +241,74 @@ protected:
   LogMessage::Level _minLevel;
 };
 
+
+/** A log-handler that forwards messages asynchronously to another handler.
+ *
+ * The messages get copied into a fixed-size ring buffer and are passed to the wrapped handler in
+ * batches on a background thread. The wrapped handler gets flushed once per batch. Hence, the
+ * logging thread never waits for the actual output, unless the ring buffer is full.
+ *
+ * @note The wrapped handler gets called from the background thread. Any remaining messages are
+ *       written when this handler gets destroyed. Therefore, destroy this handler before any
+ *       resource used by the wrapped handler (e.g., the stream).
+ * @ingroup log */
+class AsyncLogHandler: public LogHandler
+{
+  Q_OBJECT
+
+public:
+  /** Constructor.
+   * @param handler Specifies the handler to forward the messages to. The ownership is taken.
+   * @param capacity Specifies the number of messages the ring buffer can hold.
+   * @param parent Specifies the parent object. */
+  explicit AsyncLogHandler(LogHandler *handler, unsigned capacity=1024, QObject *parent=nullptr);
+
+  /** Destructor, writes all pending messages and stops the background thread. */
+  virtual ~AsyncLogHandler();
+
+  /** Returns the minimum log level of the wrapped handler. */
+  LogMessage::Level minLevel() const;
+
+  void handle(const LogMessage &message);
+  void flush();
+
+protected:
+  /** Main loop of the background thread. */
+  void run();
+
+protected:
+  /** A copy of a queued message. */
+  struct Entry {
+    /** The log level. */
+    LogMessage::Level level;
+    /** The source file. */
+    QString file;
+    /** The source line. */
+    int line;
+    /** The log message content. */
+    QString message;
+  };
+
+  /** The wrapped handler. */
+  LogHandler *_handler;
+  /** The ring buffer of queued messages. */
+  QVector<Entry> _buffer;
+  /** Index of the oldest queued message. */
+  int _head;
+  /** Number of queued messages. */
+  int _count;
+  /** If @c true, the background thread is about to stop. */
+  bool _stop;
+  /** Number of batches currently processed by the background thread. */
+  int _busy;
+  /** Protects the ring buffer. */
+  QMutex _lock;
+  /** Signals new messages to the background thread. */
+  QWaitCondition _notEmpty;
+  /** Signals free space and processed batches to the logging threads. */
+  QWaitCondition _notFull;
+  /** The background thread. */
+  std::thread _thread;
+};
+
 #endif // LOGGER_HH
@@ -0,0 +1,128 @@
+#include "mappedfilereader.hh"
+#include "dfufile.hh"
+#include "logger.hh"
+#include <QFileInfo>
+#include <cstring>
+#include <algorithm>
+
+
+/* ********************************************************************************************* *
+ * Implementation of MappedFileReader
+ * ********************************************************************************************* */
+MappedFileReader::MappedFileReader(const QString &filename)
+  : _file(filename), _data(nullptr)
+{
+  // pass...
+}
+
+MappedFileReader::~MappedFileReader() {
+  close();
+}
+
+bool
+MappedFileReader::open(qint64 expectedSize, QString &errorMessage) {
+  // Check file properties
+  QFileInfo info(_file.fileName());
+  if (! info.exists()) {
+    errorMessage = QObject::tr("Cannot open file '%1': File does not exisist.").arg(_file.fileName());
+    return false;
+  }
+  if ((0 < expectedSize) && (expectedSize != info.size())) {
+    errorMessage = QObject::tr("Cannot read codeplug file '%1': File size is not %2 bytes.")
+        .arg(_file.fileName()).arg(expectedSize);
+    return false;
+  }
+
+  // Open file
+  if (! _file.open(QFile::ReadOnly)) {
+    errorMessage = QObject::tr("Cannot open file '%1': %2").arg(_file.fileName(), _file.errorString());
+    return false;
+  }
+
+  // Map file, fall back to reading the segments if the file cannot be mapped
+  if (nullptr == (_data = _file.map(0, _file.size())))
+    logDebug() << "Cannot map file '" << _file.fileName() << "': " << _file.errorString()
+               << ". Read file instead.";
+
+  return true;
+}
+
+void
+MappedFileReader::close() {
+  if (nullptr != _data)
+    _file.unmap(_data);
+  _data = nullptr;
+  if (_file.isOpen())
+    _file.close();
+}
+
+bool
+MappedFileReader::isMapped() const {
+  return nullptr != _data;
+}
+
+qint64
+MappedFileReader::size() const {
+  return _file.size();
+}
+
+const uchar *
+MappedFileReader::data(qint64 offset) const {
+  if ((nullptr == _data) || (0 > offset) || (offset >= _file.size()))
+    return nullptr;
+  return _data + offset;
+}
+
+bool
+MappedFileReader::read(const Segment &segment, DFUFile *image, QString &errorMessage) {
+  if ((qint64(segment.fileOffset) + segment.size) > _file.size()) {
+    errorMessage = QObject::tr("Cannot read codeplug file '%1': Segment exceeds file.")
+        .arg(_file.fileName());
+    return false;
+  }
+
+  // Copy overlapping part of every element of the image
+  uint32_t covered = 0;
+  DFUFile::Image &img = image->image(0);
+  for (int i=0; i<img.numElements(); i++) {
+    DFUFile::Element &el = img.element(i);
+    uint32_t start = std::max(segment.address, el.address());
+    uint32_t end   = std::min(segment.address+segment.size, el.address()+uint32_t(el.data().size()));
+    if (start >= end)
+      continue;
+
+    char *dest = el.data().data() + (start - el.address());
+    qint64 offset = segment.fileOffset + (start - segment.address);
+    if (nullptr != _data) {
+      memcpy(dest, _data+offset, end-start);
+    } else if ((! _file.seek(offset)) || (qint64(end-start) != _file.read(dest, end-start))) {
+      errorMessage = QObject::tr("Cannot read codeplug file '%1': %2")
+          .arg(_file.fileName(), _file.errorString());
+      return false;
+    }
+    covered += end-start;
+  }
+
+  if (covered != segment.size) {
+    errorMessage = QObject::tr("Cannot read codeplug file '%1': Segment at %2 is not covered by the codeplug.")
+        .arg(_file.fileName()).arg(segment.address, 0, 16);
+    return false;
+  }
+
+  return true;
+}
+
+bool
+MappedFileReader::read(const QString &filename, qint64 expectedSize,
+                       const std::initializer_list<Segment> &segments, DFUFile *image,
+                       QString &errorMessage)
+{
+  MappedFileReader reader(filename);
+  if (! reader.open(expectedSize, errorMessage))
+    return false;
+  for (const Segment &segment: segments) {
+    if (! reader.read(segment, image, errorMessage))
+      return false;
+  }
+  return true;
+}
@@ -0,0 +1,70 @@
+#ifndef MAPPEDFILEREADER_HH
+#define MAPPEDFILEREADER_HH
+
+#include <QFile>
+#include <QString>
+#include <initializer_list>
+
+class DFUFile;
+
+
+/** Reads manufacturer codeplug files through a memory mapping.
+ *
+ * The manufacturer codeplug files are mostly plain dumps of the codeplug memory. Hence, decoding
+ * them means to copy some segments of the file into the codeplug image. This class maps the
+ * complete file into memory and copies the segments directly from the mapping into the elements
+ * of the codeplug image. This avoids seeking and reading chunks of the file. If the file cannot be
+ * mapped, the segments are read from the file instead.
+ *
+ * @ingroup util */
+class MappedFileReader
+{
+public:
+  /** A segment of the file that gets copied into the codeplug image. */
+  struct Segment {
+    /** The offset of the segment within the file. */
+    uint32_t fileOffset;
+    /** The address of the segment within the codeplug image. */
+    uint32_t address;
+    /** The size of the segment in bytes. */
+    uint32_t size;
+  };
+
+public:
+  /** Constructor. */
+  explicit MappedFileReader(const QString &filename);
+  /** Destructor, unmaps and closes the file. */
+  ~MappedFileReader();
+
+  /** Opens and maps the file. If @c expectedSize is positive, the file must have exactly that
+   * size. */
+  bool open(qint64 expectedSize, QString &errorMessage);
+  /** Unmaps and closes the file. */
+  void close();
+
+  /** Returns @c true if the file is mapped into memory. */
+  bool isMapped() const;
+  /** Returns the size of the file. */
+  qint64 size() const;
+  /** Returns a pointer to the mapped file content at the given offset or @c nullptr if the file
+   * is not mapped or the offset is out of bounds. */
+  const uchar *data(qint64 offset=0) const;
+
+  /** Copies the given segment of the file into the given image. All elements of the image
+   * overlapping the segment get updated. */
+  bool read(const Segment &segment, DFUFile *image, QString &errorMessage);
+
+public:
+  /** Reads the given segments of the specified file into the given image. */
+  static bool read(const QString &filename, qint64 expectedSize,
+                   const std::initializer_list<Segment> &segments, DFUFile *image,
+                   QString &errorMessage);
+
+protected:
+  /** The file. */
+  QFile _file;
+  /** The mapping or @c nullptr if not mapped. */
+  uchar *_data;
+};
+
+#endif // MAPPEDFILEREADER_HH
@@ -2,10 +2,17 @@
 #include "opengd77_limits.hh"
 #include "logger.hh"
 #include "config.hh"
+#include "imagecache.hh"
 
 
 #define BSIZE 32
 
+// Regions changed by the radio itself, i.e., general settings as well as boot settings, menu
+// settings, boot text and VFO channels within the EEPROM. These are always read from the device.
+static const QList<ImageCache::Region> volatileRegions = {
+  {0, 0x0000e0, 0x000020}, {0, 0x007500, 0x000100}
+};
+
 RadioLimits *OpenGD77::_limits = nullptr;
 
 OpenGD77::OpenGD77(OpenGD77Interface *device, QObject *parent)
@@ -122,9 +129,9 @@ OpenGD77::startUploadCallsignDB(UserDatabase *db, bool blocking, const CallsignD
     return false;
   }
 
-  // Assemble call-sign db from user DB
-  logDebug() << "Encode call-signs into db.";
-  _callsigns.encode(db, selection);
+  // Call-sign db gets assembled from user DB within the radio thread
+  _userDB = db;
+  _selection = selection;
 
   _task = StatusUploadCallsigns;
   _errorStack = err;
@@ -192,7 +199,7 @@ OpenGD77::run() {
       return;
     }
 
-    if (! uploadCallsigns()) {
+    if ((! encodeCallsignDB(&_callsigns)) || (! uploadCallsigns())) {
       _task = StatusError;
       _dev->write_finish();
       _dev->reboot();
@@ -256,6 +263,8 @@ OpenGD77::download()
     _dev->read_finish(_errorStack);
   }
 
+  ImageCache::store(ImageCache::key(name(), _dev->serialNumber()), _codeplug);
+
   return true;
 }
 
@@ -284,28 +293,29 @@ OpenGD77::upload()
   }
 
   // Then download codeplug
-  size_t bcount = 0;
-  for (int image=0; image<_codeplug.numImages(); image++) {
-    uint32_t bank = ( (0 == image) ? OpenGD77Codeplug::EEPROM : OpenGD77Codeplug::FLASH );
-
-    for (int n=0; n<_codeplug.image(image).numElements(); n++) {
-      unsigned addr = _codeplug.image(image).element(n).address();
-      unsigned size = _codeplug.image(image).element(n).data().size();
-      unsigned b0 = addr/BSIZE, nb = size/BSIZE;
-      for (unsigned b=0; b<nb; b++, bcount+=BSIZE) {
-        if (! _dev->read(bank, (b0+b)*BSIZE, _codeplug.data((b0+b)*BSIZE, image), BSIZE, _errorStack)) {
-          errMsg(_errorStack) << "Cannot read block " << (b0+b) << ".";
-          return false;
-        }
-        QThread::usleep(100);
-        emit uploadProgress(float(bcount*50)/totb);
-      }
-    }
-    _dev->read_finish();
+  const QString cacheKey = ImageCache::key(name(), _dev->serialNumber());
+  if (! ImageCache::restoreOrRead(
+        cacheKey, _codeplug, BSIZE, volatileRegions,
+        [this](int image, uint32_t addr, uint8_t *data, const ErrorStack &err) {
+          uint32_t bank = ( (0 == image) ? OpenGD77Codeplug::EEPROM : OpenGD77Codeplug::FLASH );
+          if (! _dev->read(bank, addr, data, BSIZE, err))
+            return false;
+          QThread::usleep(100);
+          return true;
+        },
+        [this](size_t count, size_t total) { emit uploadProgress(float(count*50)/total); },
+        _errorStack))
+  {
+    errMsg(_errorStack) << "Cannot download codeplug.";
+    return false;
   }
+  _dev->read_finish();
+  size_t bcount = totb;
 
   // Encode config into codeplug
   _codeplug.encode(_config);
+  // The device content is unknown until the upload completes
+  ImageCache::invalidate(cacheKey);
 
   if (! _dev->write_start(0,0, _errorStack)) {
     errMsg(_errorStack) << "Cannot start codeplug upload.";
@@ -333,6 +343,8 @@ OpenGD77::upload()
     _dev->write_finish();
   }
 
+  ImageCache::store(cacheKey, _codeplug);
+
   return true;
 }
 
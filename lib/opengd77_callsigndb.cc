@@ -99,12 +99,8 @@ OpenGD77CallsignDB::encode(UserDatabase *calldb, const Selection &selection, con
   if (0 == n)
     return true;
 
-  // Select first n entries and sort them in ascending order of their IDs
-  QVector<UserDatabase::User> users;
-  for (unsigned i=0; i<n; i++)
-    users.append(calldb->user(i));
-  std::sort(users.begin(), users.end(),
-            [](const UserDatabase::User &a, const UserDatabase::User &b) { return a.id < b.id; });
+  // Select n entries closest to the preferred IDs and sort them in ascending order of their IDs
+  const QVector<UserDatabase::User> users = calldb->selectSortedById(selection.preferredIds(), n);
 
   // Allocate segment for user db if requested
   unsigned size = align_size(sizeof(userdb_t)+n*sizeof(userdb_entry_t), BLOCK_SIZE);
@@ -114,9 +110,16 @@ OpenGD77CallsignDB::encode(UserDatabase *calldb, const Selection &selection, con
   userdb_t *userdb = (userdb_t *)this->data(OFFSET_USERDB);
   userdb->clear(); userdb->setSize(n);
   userdb_entry_t *db = (userdb_entry_t *)this->data(OFFSET_USERDB+sizeof(userdb_t));
-  for (unsigned i=0; i<n; i++) {
-    db[i].fromEntry(users[i]);
-  }
+  memset(db, 0, n*sizeof(userdb_entry_t));
+  // Assemble the names as "call name", like userdb_entry_t::fromEntry does
+  QVector<QString> names; names.reserve(n);
+  for (qint64 i=0; i<n; i++)
+    names.append(users[i].name.isEmpty() ? users[i].call : (users[i].call + " " + users[i].name));
+  // Encode IDs and names of all entries at once
+  encode_dmr_ids_bcd_le((uint8_t *)&(db[0].number), sizeof(userdb_entry_t),
+                        (const uint32_t *)&(users[0].id), sizeof(UserDatabase::User), n);
+  encode_ascii_n((uint8_t *)(db[0].name), sizeof(userdb_entry_t),
+                 names.constData(), sizeof(QString), n, 15, 0x00);
 
   return true;
 }
@@ -26,7 +26,7 @@
  * Implementation of Radio
  * ******************************************************************************************** */
 Radio::Radio(QObject *parent)
-  : QThread(parent), _task(StatusIdle)
+  : QThread(parent), _task(StatusIdle), _userDB(nullptr), _selection()
 {
   // pass...
 }
@@ -45,6 +45,22 @@ Radio::callsignDB() {
   return nullptr;
 }
 
+bool
+Radio::encodeCallsignDB(CallsignDB *callsigns) {
+  if ((nullptr == callsigns) || (nullptr == _userDB)) {
+    errMsg(_errorStack) << "Cannot encode call-sign DB: No call-sign DB or user database.";
+    return false;
+  }
+
+  logDebug() << "Encode call-signs into db.";
+  if (! callsigns->encode(_userDB, _selection, _errorStack)) {
+    errMsg(_errorStack) << "Cannot encode call-sign DB.";
+    return false;
+  }
+
+  return true;
+}
+
 
 Radio *
 Radio::detect(const USBDeviceDescriptor &descr, const RadioInfo &force, const ErrorStack &err) {
@@ -116,11 +116,22 @@ signals:
   /** Gets emitted once the codeplug upload has been completed successfully. */
 	void uploadComplete(Radio *radio);
 
+protected:
+  /** Encodes the user database passed to @c startUploadCallsignDB into the given device specific
+   * call-sign DB. This gets called within the radio thread, keeping the selection and encoding of
+   * the call-signs off the GUI thread. The database may get reloaded or re-sorted by the GUI
+   * thread meanwhile, it guards its users by a read/write lock. */
+  bool encodeCallsignDB(CallsignDB *callsigns);
+
 protected:
   /** The current state/task. */
   Status _task;
   /** The error stack. */
   ErrorStack _errorStack;
+  /** The user database to encode into the call-sign DB. */
+  UserDatabase *_userDB;
+  /** The selection of call-signs to encode. */
+  CallsignDB::Selection _selection;
 };
 
 #endif // RADIO_HH
@@ -2659,7 +2659,7 @@ RadioddityCodeplug::index(Config *config, Context &ctx, const ErrorStack &err) c
 }
 
 bool
-RadioddityCodeplug::encode(Config *config, const Flags &flags, const ErrorStack &err) {
+RadioddityCodeplug::prepareEncoding(Config *config, Context &ctx, const ErrorStack &err) const {
   // Check if default DMR id is set.
   if (nullptr == config->radioIDs()->defaultId()) {
     errMsg(err) << "No default radio ID specified.";
@@ -2667,11 +2667,16 @@ RadioddityCodeplug::encode(Config *config, const Flags &flags, const ErrorStack
   }
 
   // Create index<->object table.
+  return index(config, ctx, err);
+}
+
+bool
+RadioddityCodeplug::encode(Config *config, const Flags &flags, const ErrorStack &err) {
   Context ctx(config);
-  if (! index(config, ctx, err))
+  if (! prepareEncoding(config, ctx, err))
     return false;
 
-  return this->encodeElements(flags, ctx);
+  return this->encodeElements(flags, ctx, err);
 }
 
 bool
@@ -2728,13 +2733,19 @@ RadioddityCodeplug::encodeElements(const Flags &flags, Context &ctx, const Error
 
 bool
 RadioddityCodeplug::decode(Config *config, const ErrorStack &err) {
-  // Clear config object
+  // Clear config object, the lists get notified once all elements are decoded
+  config->beginUpdate();
   config->clear();
 
   // Create index<->object table.
   Context ctx(config);
 
-  return this->decodeElements(ctx, err);
+  bool ok = this->decodeElements(ctx, err);
+  // Drop the partially decoded config at once on failure
+  if (! ok)
+    config->clear();
+  config->endUpdate();
+  return ok;
 }
 
 bool
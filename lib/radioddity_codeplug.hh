@@ -1308,6 +1308,8 @@ public:
   virtual void clear();
 
   bool index(Config *config, Context &ctx, const ErrorStack &err=ErrorStack()) const;
+  /** Checks for a default radio ID and indexes the config. */
+  bool prepareEncoding(Config *config, Context &ctx, const ErrorStack &err=ErrorStack()) const;
 
   /** Decodes the binary codeplug and stores its content in the given generic configuration. */
   bool decode(Config *config, const ErrorStack &err=ErrorStack());
@@ -47,6 +47,11 @@ RadioddityInterface::isOpen() const {
   return HIDevice::isOpen();
 }
 
+QString
+RadioddityInterface::serialNumber() const {
+  return HIDevice::serialNumber();
+}
+
 void
 RadioddityInterface::close() {
   logDebug() << "Close HID connection.";
@@ -41,6 +41,7 @@ public:
 
   /** Returns radio identifier string. */
   RadioInfo identifier(const ErrorStack &err=ErrorStack());
+  QString serialNumber() const;
 
   bool read_start(uint32_t bank, uint32_t addr, const ErrorStack &err=ErrorStack());
 
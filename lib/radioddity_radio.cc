@@ -2,9 +2,16 @@
 #include "config.hh"
 #include "logger.hh"
 #include "utils.hh"
+#include "imagecache.hh"
 
 #define BSIZE           32
 
+// Regions changed by the radio itself, i.e., general settings as well as boot settings, menu
+// settings, boot text and VFO channels. These are always read from the device.
+static const QList<ImageCache::Region> volatileRegions = {
+  {0, 0x0000e0, 0x000020}, {0, 0x007500, 0x000100}
+};
+
 
 RadioddityRadio::RadioddityRadio(RadioddityInterface *device, QObject *parent)
   : Radio(parent), _dev(device), _codeplugFlags(), _config(nullptr)
@@ -119,7 +126,7 @@ RadioddityRadio::run() {
       return;
     }
 
-    if(! uploadCallsigns()) {
+    if ((! encodeCallsignDB(callsignDB())) || (! uploadCallsigns())) {
       _dev->reboot();
       _dev->close();
       _task = StatusError;
@@ -162,6 +169,7 @@ RadioddityRadio::download() {
   }
 
   _dev->read_finish(_errorStack);
+  ImageCache::store(ImageCache::key(name(), _dev->serialNumber()), codeplug());
   return true;
 }
 
@@ -174,35 +182,41 @@ RadioddityRadio::upload() {
     btot += codeplug().image(0).element(n).data().size()/BSIZE;
   }
 
-  unsigned bcount = 0;
-  if (_codeplugFlags.updateCodePlug) {
-    // If codeplug gets updated, download codeplug from device first:
-    for (int n=0; n<codeplug().image(0).numElements(); n++) {
-      int b0 = codeplug().image(0).element(n).address()/BSIZE;
-      int nb = codeplug().image(0).element(n).data().size()/BSIZE;
-      for (int i=0; i<nb; i++, bcount++) {
-        // Select bank by addr
-        uint32_t addr = (b0+i)*BSIZE;
-        RadioddityInterface::MemoryBank bank = (
-              (0x10000 > addr) ? RadioddityInterface::MEMBANK_CODEPLUG_LOWER : RadioddityInterface::MEMBANK_CODEPLUG_UPPER );
-        // read
-        if (! _dev->read(bank, addr, codeplug().data(addr), BSIZE, _errorStack)) {
-          errMsg(_errorStack) << "Cannot upload codeplug.";
-          return false;
-        }
-        emit uploadProgress(float(bcount*50)/btot);
-      }
-    }
+  Codeplug::Preparation prepared(&codeplug(), _config);
+
+  // If codeplug gets updated, download codeplug from device first:
+  const QString cacheKey = ImageCache::key(name(), _dev->serialNumber());
+  if (_codeplugFlags.updateCodePlug && (! ImageCache::restoreOrRead(
+        cacheKey, codeplug(), BSIZE, volatileRegions,
+        [this](int image, uint32_t addr, uint8_t *data, const ErrorStack &err) {
+          Q_UNUSED(image);
+          // Select bank by addr
+          RadioddityInterface::MemoryBank bank = (
+                (0x10000 > addr) ? RadioddityInterface::MEMBANK_CODEPLUG_LOWER : RadioddityInterface::MEMBANK_CODEPLUG_UPPER );
+          return _dev->read(bank, addr, data, BSIZE, err);
+        },
+        [this](size_t count, size_t total) { emit uploadProgress(float(count*50)/total); },
+        _errorStack)))
+  {
+    errMsg(_errorStack) << "Cannot upload codeplug.";
+    return false;
   }
 
   // Encode config into codeplug
-  if (! codeplug().encode(_config, _codeplugFlags, _errorStack)) {
+  if (! prepared.wait(_errorStack)) {
     errMsg(_errorStack) << "Codeplug upload failed.";
     return false;
   }
+  if (! codeplug().encodeElements(_codeplugFlags, prepared.context(), _errorStack)) {
+    errMsg(_errorStack) << "Codeplug upload failed.";
+    return false;
+  }
+
+  // The device content is unknown until the upload completes
+  ImageCache::invalidate(cacheKey);
 
   // then, upload modified codeplug
-  bcount = 0;
+  unsigned bcount = 0;
   for (int n=0; n<codeplug().image(0).numElements(); n++) {
     int b0 = codeplug().image(0).element(n).address()/BSIZE;
     int nb = codeplug().image(0).element(n).data().size()/BSIZE;
@@ -220,6 +234,8 @@ RadioddityRadio::upload() {
     }
   }
 
+  ImageCache::store(cacheKey, codeplug());
+
   return true;
 }
 
@@ -0,0 +1,188 @@
+#include "radiodetector.hh"
+#include "radio.hh"
+#include "anytone_interface.hh"
+#include "opengd77_interface.hh"
+#include "radioddity_interface.hh"
+#include "tyt_interface.hh"
+#include "concurrency.hh"
+#include "logger.hh"
+
+
+/* ********************************************************************************************* *
+ * Implementation of RadioDetector
+ * ********************************************************************************************* */
+RadioDetector::RadioDetector(QObject *parent)
+  : QObject(parent), _devices(), _infos(), _watch()
+{
+  connect(&_watch, SIGNAL(timeout()), this, SLOT(onPoll()));
+}
+
+QList<USBDeviceDescriptor>
+RadioDetector::devices() {
+  QList<USBDeviceDescriptor> devices = USBDeviceDescriptor::detect();
+
+  QHash<QString, USBDeviceDescriptor> current;
+  foreach (USBDeviceDescriptor device, devices)
+    current.insert(device.deviceHandle(), device);
+
+  // Drop information of unplugged devices
+  foreach (QString handle, _devices.keys()) {
+    if (current.contains(handle))
+      continue;
+    logDebug() << "Device " << handle << " disconnected.";
+    _infos.remove(handle);
+  }
+  _devices = current;
+
+  return devices;
+}
+
+bool
+RadioDetector::isConnected(const USBDeviceDescriptor &device) const {
+  return _devices.contains(device.deviceHandle());
+}
+
+bool
+RadioDetector::hasRadioInfo(const USBDeviceDescriptor &device) const {
+  return _infos.contains(device.deviceHandle());
+}
+
+RadioInfo
+RadioDetector::radioInfo(const USBDeviceDescriptor &device) const {
+  return _infos.value(device.deviceHandle(), RadioInfo());
+}
+
+void
+RadioDetector::setRadioInfo(const USBDeviceDescriptor &device, const RadioInfo &info) {
+  if (info.isValid())
+    _infos.insert(device.deviceHandle(), info);
+  else
+    _infos.remove(device.deviceHandle());
+}
+
+void
+RadioDetector::clear() {
+  _infos.clear();
+}
+
+QList<RadioInfo>
+RadioDetector::identify(const QList<USBDeviceDescriptor> &devices, const ErrorStack &err) {
+  // Collect devices to probe
+  QVector<int> probe;
+  for (int i=0; i<devices.count(); i++) {
+    const USBDeviceDescriptor &device = devices.at(i);
+    if (hasRadioInfo(device) || (! device.isSave()) || (! device.isIdentifiable()))
+      continue;
+    // No need to probe devices, that are identified by their descriptor already
+    RadioInfo info = fromDescriptor(device);
+    if (info.isValid())
+      setRadioInfo(device, info);
+    else
+      probe.append(i);
+  }
+
+  // Probe devices concurrently, each with its own error stack
+  QVector<RadioInfo> results(probe.count());
+  QVector<ErrorStack> errors(probe.count());
+  parallel_for(probe.count(), [&devices, &probe, &results, &errors](unsigned first, unsigned last) {
+    for (unsigned i=first; i<last; i++)
+      results[i] = RadioDetector::identify(devices.at(probe[i]), errors[i]);
+  }, 1);
+
+  for (int i=0; i<probe.count(); i++) {
+    if (results[i].isValid())
+      setRadioInfo(devices.at(probe[i]), results[i]);
+    else
+      err.take(errors[i]);
+  }
+
+  QList<RadioInfo> infos;
+  foreach (USBDeviceDescriptor device, devices)
+    infos.append(radioInfo(device));
+  return infos;
+}
+
+Radio *
+RadioDetector::detect(const USBDeviceDescriptor &device, const RadioInfo &force, const ErrorStack &err) {
+  RadioInfo info = force;
+  // Only devices that cannot be identified use the cached information. Identifiable devices
+  // are identified anyway when the interface gets opened.
+  if ((! info.isValid()) && (! device.isIdentifiable()))
+    info = radioInfo(device);
+  if (! info.isValid())
+    info = fromDescriptor(device);
+
+  Radio *radio = Radio::detect(device, info, err);
+  if ((nullptr != radio) && force.isValid())
+    setRadioInfo(device, force);
+
+  return radio;
+}
+
+void
+RadioDetector::startWatching(unsigned interval) {
+  _watch.start(interval);
+}
+
+void
+RadioDetector::stopWatching() {
+  _watch.stop();
+}
+
+void
+RadioDetector::onPoll() {
+  QHash<QString, USBDeviceDescriptor> previous = _devices;
+  QList<USBDeviceDescriptor> current = devices();
+
+  foreach (USBDeviceDescriptor device, previous) {
+    if (! _devices.contains(device.deviceHandle()))
+      emit deviceRemoved(device);
+  }
+  foreach (USBDeviceDescriptor device, current) {
+    if (! previous.contains(device.deviceHandle()))
+      emit deviceAdded(device);
+  }
+}
+
+RadioInfo
+RadioDetector::fromDescriptor(const USBDeviceDescriptor &device) {
+  QList<RadioInfo> radios = RadioInfo::allRadios(device, false);
+  if (1 != radios.count())
+    return RadioInfo();
+  return radios.first();
+}
+
+RadioInfo
+RadioDetector::identify(const USBDeviceDescriptor &device, const ErrorStack &err) {
+  RadioInfo info = fromDescriptor(device);
+  if (info.isValid())
+    return info;
+
+  RadioInterface *iface = nullptr;
+  if (AnytoneInterface::interfaceInfo() == device)
+    iface = new AnytoneInterface(device, err);
+  else if (OpenGD77Interface::interfaceInfo() == device)
+    iface = new OpenGD77Interface(device, err);
+  else if (TyTInterface::interfaceInfo() == device)
+    iface = new TyTInterface(device, err);
+  else if (RadioddityInterface::interfaceInfo() == device)
+    iface = new RadioddityInterface(device, err);
+
+  if (nullptr == iface) {
+    errMsg(err) << "Cannot identify radio at " << device.deviceHandle() << ": Unknown interface.";
+    return RadioInfo();
+  }
+
+  if (iface->isOpen()) {
+    info = iface->identifier(err);
+    iface->close();
+  }
+  delete iface;
+
+  if (! info.isValid())
+    errMsg(err) << "Cannot identify radio at " << device.deviceHandle() << ".";
+  else
+    logDebug() << "Found " << info.name() << " at " << device.deviceHandle() << ".";
+
+  return info;
+}
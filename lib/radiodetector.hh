@@ -0,0 +1,95 @@
+#ifndef RADIODETECTOR_HH
+#define RADIODETECTOR_HH
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include "usbdevice.hh"
+#include "radioinfo.hh"
+#include "errorstack.hh"
+
+class Radio;
+
+
+/** Detects and identifies connected radios and caches the results.
+ *
+ * Identifying a radio requires to open the interface and a round trip to the device. This class
+ * identifies several devices concurrently and keeps the resulting @c RadioInfo for every device
+ * until the device gets unplugged. For devices that cannot be identified automatically, the radio
+ * selected by the user can be stored using @c setRadioInfo. Hence, the user needs to be asked
+ * only once.
+ *
+ * Optionally, the detector polls the connected devices periodically and signals added or removed
+ * devices (see @c startWatching).
+ *
+ * @ingroup detect */
+class RadioDetector : public QObject
+{
+  Q_OBJECT
+
+public:
+  /** Constructor. */
+  explicit RadioDetector(QObject *parent=nullptr);
+
+  /** Enumerates all connected devices (may contain false positives). Cached information for
+   * devices that are no longer connected gets dropped. */
+  QList<USBDeviceDescriptor> devices();
+  /** Returns @c true if the given device is still connected. This uses the last enumeration
+   * result, call @c devices to update it. */
+  bool isConnected(const USBDeviceDescriptor &device) const;
+
+  /** Returns @c true if there is a cached radio information for the given device. */
+  bool hasRadioInfo(const USBDeviceDescriptor &device) const;
+  /** Returns the cached radio information for the given device. */
+  RadioInfo radioInfo(const USBDeviceDescriptor &device) const;
+  /** Stores the radio information for the given device, e.g., the radio selected by the user. */
+  void setRadioInfo(const USBDeviceDescriptor &device, const RadioInfo &info);
+  /** Clears the cached radio information. */
+  void clear();
+
+  /** Identifies all given devices concurrently and caches the results. Devices that are not save
+   * to probe or cannot be identified automatically, are skipped. Devices with cached information
+   * or identified by their descriptor alone (see @c fromDescriptor) are not probed. Returns the
+   * radio information for every given device, the information is invalid for every device that
+   * could not be identified. */
+  QList<RadioInfo> identify(const QList<USBDeviceDescriptor> &devices,
+                            const ErrorStack &err=ErrorStack());
+
+  /** Connects to the radio at the given device. If @c force is invalid and the device cannot be
+   * identified automatically, the cached radio information is used. */
+  Radio *detect(const USBDeviceDescriptor &device, const RadioInfo &force=RadioInfo(),
+                const ErrorStack &err=ErrorStack());
+
+  /** Starts polling the connected devices every @c interval milliseconds. */
+  void startWatching(unsigned interval=1000);
+  /** Stops polling the connected devices. */
+  void stopWatching();
+
+public:
+  /** Opens the given device and identifies the connected radio. Devices identified by their
+   * descriptor are not opened. */
+  static RadioInfo identify(const USBDeviceDescriptor &device, const ErrorStack &err=ErrorStack());
+  /** Returns the radio information, if the given device descriptor matches a single radio only.
+   * Otherwise, an invalid information is returned. */
+  static RadioInfo fromDescriptor(const USBDeviceDescriptor &device);
+
+signals:
+  /** Gets emitted if a device got connected while watching. */
+  void deviceAdded(const USBDeviceDescriptor &device);
+  /** Gets emitted if a device got disconnected while watching. */
+  void deviceRemoved(const USBDeviceDescriptor &device);
+
+protected slots:
+  /** Polls the connected devices. */
+  void onPoll();
+
+protected:
+  /** The last enumeration result, indexed by the device handle. */
+  QHash<QString, USBDeviceDescriptor> _devices;
+  /** Cached radio information, indexed by the device handle. */
+  QHash<QString, RadioInfo> _infos;
+  /** Timer to poll the connected devices. */
+  QTimer _watch;
+};
+
+#endif // RADIODETECTOR_HH
@@ -1,6 +1,8 @@
 #include "radioid.hh"
 #include "logger.hh"
 #include "utils.hh"
+#include <QCoreApplication>
+#include <mutex>
 
 
 /* ********************************************************************************************* *
@@ -112,8 +114,15 @@ DefaultRadioID::DefaultRadioID(QObject *parent)
 
 DefaultRadioID *
 DefaultRadioID::get() {
-  if (nullptr == _instance)
+  // The instance may get created first by a worker thread, e.g., while decoding channels
+  // concurrently. Hence create it exactly once and hand it over to the application thread, which
+  // outlives all workers.
+  static std::once_flag once;
+  std::call_once(once, []() {
     _instance = new DefaultRadioID();
+    if (QCoreApplication *app = QCoreApplication::instance())
+      _instance->moveToThread(app->thread());
+  });
   return _instance;
 }
 
@@ -220,7 +229,7 @@ RadioIDList::setDefaultId(int idx) {
   if (_default) {
     disconnect(_default, SIGNAL(destroyed(QObject*)), this, SLOT(onDefaultIdDeleted()));
     if (0 <= indexOf(_default))
-      emit elementModified(indexOf(_default));
+      signalModified(indexOf(_default));
   }
 
   if (0 > idx) {
@@ -232,7 +241,7 @@ RadioIDList::setDefaultId(int idx) {
   if (nullptr == _default)
     return false;
   connect(_default, SIGNAL(destroyed(QObject*)), this, SLOT(onDefaultIdDeleted()));
-  emit elementModified(idx);
+  signalModified(idx);
   return true;
 }
 
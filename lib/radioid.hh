@@ -37,7 +37,7 @@ class DMRRadioID : public RadioID
 
 public:
   /** Default constructor. */
-  explicit DMRRadioID(QObject *parent=nullptr);
+  Q_INVOKABLE explicit DMRRadioID(QObject *parent=nullptr);
 
   /** Constructor.
    * @param name Specifies the name of the ID.
@@ -73,7 +73,7 @@ protected:
   explicit DefaultRadioID(QObject *parent=nullptr);
 
 public:
-  /** Factory method returning the singleton instance. */
+  /** Factory method returning the singleton instance. May be called from any thread. */
   static DefaultRadioID *get();
 
 private:
@@ -95,7 +95,7 @@ class DTMFRadioID: public RadioID
 
 public:
   /** Default constructor. */
-  explicit DTMFRadioID(QObject *parent=nullptr);
+  Q_INVOKABLE explicit DTMFRadioID(QObject *parent=nullptr);
 
   /** Constructor from name and number.
    * @param name Specifies the name of the DTMF radio ID.
@@ -17,6 +17,11 @@ RadioInterface::~RadioInterface() {
   // pass...
 }
 
+QString
+RadioInterface::serialNumber() const {
+  return QString();
+}
+
 bool
 RadioInterface::write_finish(const ErrorStack &err) {
   Q_UNUSED(err)
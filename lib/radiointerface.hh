@@ -34,6 +34,9 @@ public:
 
   /** Returns a device identifier. */
   virtual RadioInfo identifier(const ErrorStack &err=ErrorStack()) = 0;
+  /** Returns the serial number of the device as reported by the USB descriptor. Returns an empty
+   * string if the device does not report a serial number. */
+  virtual QString serialNumber() const;
 
   /** Starts the write process into the specified bank and at the given address.
    * @param bank Specifies the memory bank to write to. Usually there is only one bank. Some radios,
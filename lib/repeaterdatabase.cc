@@ -4,7 +4,6 @@
 #include <QStandardPaths>
 #include <QFile>
 #include <QDir>
-#include <QNetworkReply>
 #include <algorithm>
 #include "logger.hh"
 #include <QSet>
@@ -58,10 +57,11 @@ private:
 
 
 RepeaterDatabase::RepeaterDatabase(const QGeoCoordinate &qth, unsigned updatePeriodDays, QObject *parent)
-  : QAbstractTableModel(parent), _qth(qth), _repeater(), _callsigns(), _network()
+  : QAbstractTableModel(parent), _qth(qth), _repeater(), _callsigns(),
+    _fetcher(QUrl("https://repeatermap.de/api.php"),
+             QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)+"/repeater.json")
 {
-  connect(&_network, SIGNAL(finished(QNetworkReply*)),
-          this, SLOT(downloadFinished(QNetworkReply*)));
+  connect(&_fetcher, SIGNAL(updated()), this, SLOT(onDownloaded()));
 
   if ((! load()) || (updatePeriodDays < dbAge()))
     download();
@@ -69,8 +69,7 @@ RepeaterDatabase::RepeaterDatabase(const QGeoCoordinate &qth, unsigned updatePer
 
 bool
 RepeaterDatabase::load() {
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  return load(path+"/repeater.json");
+  return load(_fetcher.filename());
 }
 
 const QJsonObject &
@@ -126,45 +125,17 @@ RepeaterDatabase::load(const QString &filename) {
 
 void
 RepeaterDatabase::download() {
-  QUrl url("https://repeatermap.de/api.php");
-  QNetworkRequest request(url);
-  _network.get(request);
+  _fetcher.fetch(! _repeater.isEmpty());
 }
 
 void
-RepeaterDatabase::downloadFinished(QNetworkReply *reply) {
-  if (reply->error()) {
-    logError() << "Cannot download repeater list: " << reply->errorString();
-    return;
-  }
-
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  QFile file(path+"/repeater.json");
-  QDir directory;
-  if ((! directory.exists(path)) && (!directory.mkpath(path))) {
-    logError() << "Cannot create path '" << path << "'.";
-    return;
-  }
-  if (! file.open(QIODevice::WriteOnly)) {
-    logError() << "Cannot save repeaterlist at '" << (path+"/repeater.json") << "'.";
-    return;
-  }
-
-  file.write(reply->readAll());
-  file.flush();
-  file.close();
-
+RepeaterDatabase::onDownloaded() {
   load();
-  reply->deleteLater();
 }
 
 unsigned
 RepeaterDatabase::dbAge() const {
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/repeater.json";
-  QFileInfo info(path);
-  if (! info.exists())
-    return -1;
-  return info.lastModified().daysTo(QDateTime::currentDateTime());
+  return _fetcher.age();
 }
 
 int
@@ -5,10 +5,10 @@
 #include <QVector>
 #include <QHash>
 #include <QJsonObject>
-#include <QNetworkAccessManager>
 #include <QAbstractTableModel>
 #include <QSortFilterProxyModel>
 #include <QGeoPositionInfoSource>
+#include "databasefetcher.hh"
 
 /** Represents the complete downloaded repeater database from http://repeatermap.de.
  * @ingroup util */
@@ -47,8 +47,8 @@ public slots:
 	void download();
 
 private slots:
-	/** Internal callback on completed download. */
-	void downloadFinished(QNetworkReply *reply);
+	/** Internal callback on a downloaded new version of the database. */
+	void onDownloaded();
 
 private:
 	/** My location. */
@@ -57,8 +57,8 @@ private:
 	QVector<QJsonObject>  _repeater;
 	/** Table of callsigns. */
 	QHash<QString, unsigned>  _callsigns;
-	/** Network access. */
-	QNetworkAccessManager _network;
+	/** Keeps the downloaded database up-to-date. */
+	DatabaseFetcher _fetcher;
 };
 
 
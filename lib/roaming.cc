@@ -1,6 +1,8 @@
 #include "roaming.hh"
 #include "channel.hh"
 #include <QSet>
+#include <QCoreApplication>
+#include <mutex>
 
 
 /* ********************************************************************************************* *
@@ -94,8 +96,13 @@ DefaultRoamingZone::DefaultRoamingZone(QObject *parent)
 
 DefaultRoamingZone *
 DefaultRoamingZone::get() {
-  if (nullptr == _instance)
+  // Thread-safe, see DefaultRadioID::get()
+  static std::once_flag once;
+  std::call_once(once, []() {
     _instance = new DefaultRoamingZone();
+    if (QCoreApplication *app = QCoreApplication::instance())
+      _instance->moveToThread(app->thread());
+  });
   return _instance;
 }
 
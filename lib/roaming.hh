@@ -20,7 +20,7 @@ class RoamingZone : public ConfigObject
 
 public:
   /** Default constructor. */
-  explicit RoamingZone(QObject *parent=nullptr);
+  Q_INVOKABLE explicit RoamingZone(QObject *parent=nullptr);
 
   /** Constructor.
    * @param name Specifies the name of the roaming zone.
@@ -75,7 +75,7 @@ protected:
   explicit DefaultRoamingZone(QObject *parent=nullptr);
 
 public:
-  /** Returns the singleton instance of this class. */
+  /** Returns the singleton instance of this class. May be called from any thread. */
   static DefaultRoamingZone *get();
 
 protected:
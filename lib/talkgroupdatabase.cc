@@ -4,7 +4,6 @@
 #include "logger.hh"
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QNetworkReply>
 #include <QDir>
 
 
@@ -28,10 +27,12 @@ TalkGroupDatabase::TalkGroup::TalkGroup(const QString &name, unsigned number)
  * Implementation of TalkGroupDatabase
  * ********************************************************************************************* */
 TalkGroupDatabase::TalkGroupDatabase(unsigned updatePeriodDays, QObject *parent)
-  : QAbstractTableModel(parent), _talkgroups(), _network()
+  : QAbstractTableModel(parent), _talkgroups(),
+    _fetcher(QUrl("https://api.brandmeister.network/v1.0/groups/"),
+             QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)+"/talkgroups.json")
 {
-  connect(&_network, SIGNAL(finished(QNetworkReply*)),
-          this, SLOT(downloadFinished(QNetworkReply*)));
+  connect(&_fetcher, SIGNAL(updated()), this, SLOT(onDownloaded()));
+  connect(&_fetcher, SIGNAL(error(QString)), this, SIGNAL(error(QString)));
 
   if ((! load()) || (updatePeriodDays < dbAge()))
     download();
@@ -44,11 +45,7 @@ TalkGroupDatabase::count() const {
 
 unsigned
 TalkGroupDatabase::dbAge() const {
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/talkgroups.json";
-  QFileInfo info(path);
-  if (! info.exists())
-    return -1;
-  return info.lastModified().daysTo(QDateTime::currentDateTime());
+  return _fetcher.age();
 }
 
 TalkGroupDatabase::TalkGroup
@@ -60,48 +57,17 @@ TalkGroupDatabase::talkgroup(int index) const {
 
 void
 TalkGroupDatabase::download() {
-  QUrl url("https://api.brandmeister.network/v1.0/groups/");
-  QNetworkRequest request(url);
-  _network.get(request);
+  _fetcher.fetch(0 < count());
 }
 
 void
-TalkGroupDatabase::downloadFinished(QNetworkReply *reply) {
-  if (reply->error()) {
-    QString msg = QString("Cannot download user database: %1").arg(reply->errorString());
-    logError() << msg;
-    emit error(msg);
-    return;
-  }
-
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  QFile file(path+"/talkgroups.json");
-  QDir directory;
-  if ((! directory.exists(path)) && (!directory.mkpath(path))) {
-    QString msg = QString("Cannot create path '%1'.").arg(path);
-    logError() << msg;
-    emit error(msg);
-    return;
-  }
-  if (! file.open(QIODevice::WriteOnly)) {
-    QString msg = QString("Cannot save user database at '%1'.").arg(path+"/talkgroups.json");
-    logError() << msg;
-    emit error(msg);
-    return;
-  }
-
-  file.write(reply->readAll());
-  file.flush();
-  file.close();
-
+TalkGroupDatabase::onDownloaded() {
   load();
-  reply->deleteLater();
 }
 
 bool
 TalkGroupDatabase::load() {
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  return load(path+"/talkgroups.json");
+  return load(_fetcher.filename());
 }
 
 bool
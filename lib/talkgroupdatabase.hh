@@ -2,7 +2,7 @@
 #define TALKGROUPDATABASE_HH
 
 #include <QAbstractTableModel>
-#include <QNetworkAccessManager>
+#include "databasefetcher.hh"
 
 /** Downloads, periodically updates and provides a list of talk group IDs and their names.
  *
@@ -61,14 +61,14 @@ public slots:
   void download();
 
 private slots:
-  /** Gets called whenever the download is complete. */
-  void downloadFinished(QNetworkReply *reply);
+  /** Gets called whenever a new version of the database has been downloaded. */
+  void onDownloaded();
 
 protected:
   /** Holds all talk groups as id->name table. */
   QVector<TalkGroup>    _talkgroups;
-  /** The network access used for downloading. */
-  QNetworkAccessManager _network;
+  /** Keeps the downloaded database up-to-date. */
+  DatabaseFetcher       _fetcher;
 };
 
 #endif // TALKGROUPDATABASE_HH
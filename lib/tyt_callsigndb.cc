@@ -158,11 +158,7 @@ TyTCallsignDB::encode(UserDatabase *db, const Selection &selection, const ErrorS
   clearIndex();
 
   // Select n users and sort them in ascending order of their IDs
-  QVector<UserDatabase::User> users;
-  for (unsigned i=0; i<n; i++)
-    users.append(db->user(i));
-  std::sort(users.begin(), users.end(),
-            [](const UserDatabase::User &a, const UserDatabase::User &b) { return a.id < b.id; });
+  const QVector<UserDatabase::User> users = db->selectSortedById(selection.preferredIds(), n);
 
   // Store number of entries
   setNumEntries(n);
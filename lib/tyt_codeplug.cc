@@ -12,9 +12,7 @@
 #include <QtEndian>
 
 
-#define CHANNEL_SIZE      0x000040
 #define SETTINGS_SIZE     0x000090
-#define CONTACT_SIZE      0x000024
 #define MENUSETTINGS_SIZE 0x000010
 
 
@@ -24,11 +22,11 @@
 TyTCodeplug::ChannelElement::ChannelElement(uint8_t *ptr, size_t size)
   : Codeplug::Element(ptr, size)
 {
-  // pass...
+  checkLayoutSize(Layout::Size);
 }
 
 TyTCodeplug::ChannelElement::ChannelElement(uint8_t *ptr)
-  : Codeplug::Element(ptr, CHANNEL_SIZE)
+  : Codeplug::Element(ptr, Layout::Size)
 {
   // pass...
 }
@@ -96,238 +94,238 @@ TyTCodeplug::ChannelElement::clear() {
 
 TyTCodeplug::ChannelElement::Mode
 TyTCodeplug::ChannelElement::mode() const {
-  return TyTCodeplug::ChannelElement::Mode(getUInt2(0, 0));
+  return TyTCodeplug::ChannelElement::Mode(getField<Fields::Mode>());
 }
 void
 TyTCodeplug::ChannelElement::setMode(Mode mode) {
-  setUInt2(0,0, uint8_t(mode));
+  setField<Fields::Mode>(mode);
 }
 
 AnalogChannel::Bandwidth
 TyTCodeplug::ChannelElement::bandwidth() const {
-  if (0 == getUInt2(0, 2))
+  if (BW_12_5_KHZ == getField<Fields::Bandwidth>())
     return AnalogChannel::Bandwidth::Narrow;
   return AnalogChannel::Bandwidth::Wide;
 }
 void
 TyTCodeplug::ChannelElement::setBandwidth(AnalogChannel::Bandwidth bw) {
   if (AnalogChannel::Bandwidth::Narrow == bw)
-    setUInt2(0, 2, BW_12_5_KHZ);
+    setField<Fields::Bandwidth>(BW_12_5_KHZ);
   else
-    setUInt2(0, 2, BW_25_KHZ);
+    setField<Fields::Bandwidth>(BW_25_KHZ);
 }
 
 bool
 TyTCodeplug::ChannelElement::autoScan() const {
-  return getBit(0, 4);
+  return getField<Fields::AutoScan>();
 }
 void
 TyTCodeplug::ChannelElement::enableAutoScan(bool enable) {
-  setBit(0, 4, enable);
+  setField<Fields::AutoScan>(enable);
 }
 
 bool
 TyTCodeplug::ChannelElement::loneWorker() const {
-  return getBit(0, 7);
+  return getField<Fields::LoneWorker>();
 }
 void
 TyTCodeplug::ChannelElement::enableLoneWorker(bool enable) {
-  setBit(0, 7, enable);
+  setField<Fields::LoneWorker>(enable);
 }
 
 bool
 TyTCodeplug::ChannelElement::talkaround() const {
-  return ! getBit(1, 0);
+  return getField<Fields::Talkaround>();
 }
 void
 TyTCodeplug::ChannelElement::enableTalkaround(bool enable) {
-  setBit(1, 0, !enable);
+  setField<Fields::Talkaround>(enable);
 }
 
 bool
 TyTCodeplug::ChannelElement::rxOnly() const {
-  return getBit(1, 1);
+  return getField<Fields::RXOnly>();
 }
 void
 TyTCodeplug::ChannelElement::enableRXOnly(bool enable) {
-  setBit(1, 1, enable);
+  setField<Fields::RXOnly>(enable);
 }
 
 DigitalChannel::TimeSlot
 TyTCodeplug::ChannelElement::timeSlot() const {
-  if (2 == getUInt2(1,2))
+  if (2 == getField<Fields::TimeSlot>())
     return DigitalChannel::TimeSlot::TS2;
   return DigitalChannel::TimeSlot::TS1;
 }
 void
 TyTCodeplug::ChannelElement::setTimeSlot(DigitalChannel::TimeSlot ts) {
   if (DigitalChannel::TimeSlot::TS1 == ts)
-    setUInt2(1,2,1);
+    setField<Fields::TimeSlot>(1);
   else
-    setUInt2(1,2,2);
+    setField<Fields::TimeSlot>(2);
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::colorCode() const {
-  return getUInt4(1,4);
+  return getField<Fields::ColorCode>();
 }
 void
 TyTCodeplug::ChannelElement::setColorCode(uint8_t cc) {
-  setUInt4(1,4, std::min(uint8_t(16), cc));
+  setField<Fields::ColorCode>(std::min(uint8_t(16), cc));
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::privacyIndex() const {
-  return getUInt4(2,0);
+  return getField<Fields::PrivacyIndex>();
 }
 void
 TyTCodeplug::ChannelElement::setPrivacyIndex(uint8_t idx) {
-  setUInt4(2,0, idx);
+  setField<Fields::PrivacyIndex>(idx);
 }
 
 TyTCodeplug::ChannelElement::PrivacyType
 TyTCodeplug::ChannelElement::privacyType() const {
-  return TyTCodeplug::ChannelElement::PrivacyType(getUInt2(2,4));
+  return TyTCodeplug::ChannelElement::PrivacyType(getField<Fields::PrivacyType>());
 }
 void
 TyTCodeplug::ChannelElement::setPrivacyType(TyTCodeplug::ChannelElement::PrivacyType type) {
-  setUInt2(2,4, uint8_t(type));
+  setField<Fields::PrivacyType>(type);
 }
 
 bool
 TyTCodeplug::ChannelElement::privateCallConfirm() const {
-  return getBit(2, 6);
+  return getField<Fields::PrivateCallConfirm>();
 }
 void
 TyTCodeplug::ChannelElement::enablePrivateCallConfirm(bool enable) {
-  setBit(2, 6, enable);
+  setField<Fields::PrivateCallConfirm>(enable);
 }
 
 bool
 TyTCodeplug::ChannelElement::dataCallConfirm() const {
-  return getBit(2, 7);
+  return getField<Fields::DataCallConfirm>();
 }
 void
 TyTCodeplug::ChannelElement::enableDataCallConfirm(bool enable) {
-  setBit(2, 7, enable);
+  setField<Fields::DataCallConfirm>(enable);
 }
 
 TyTChannelExtension::RefFrequency
 TyTCodeplug::ChannelElement::rxRefFrequency() const {
-  return TyTChannelExtension::RefFrequency(getUInt2(3,0));
+  return TyTChannelExtension::RefFrequency(getField<Fields::RXRefFrequency>());
 }
 void
 TyTCodeplug::ChannelElement::setRXRefFrequency(TyTChannelExtension::RefFrequency ref) {
-  setUInt2(3,0, uint8_t(ref));
+  setField<Fields::RXRefFrequency>(uint8_t(ref));
 }
 
 bool
 TyTCodeplug::ChannelElement::emergencyAlarmACK() const {
-  return getBit(3,3);
+  return getField<Fields::EmergencyAlarmACK>();
 }
 void
 TyTCodeplug::ChannelElement::enableEmergencyAlarmACK(bool enable) {
-  setBit(3,3, enable);
+  setField<Fields::EmergencyAlarmACK>(enable);
 }
 
 bool
 TyTCodeplug::ChannelElement::displayPTTId() const {
-  return ! getBit(3,7);
+  return getField<Fields::DisplayPTTId>();
 }
 void
 TyTCodeplug::ChannelElement::enableDisplayPTTId(bool enable) {
-  setBit(3,7, !enable);
+  setField<Fields::DisplayPTTId>(enable);
 }
 
 TyTChannelExtension::RefFrequency
 TyTCodeplug::ChannelElement::txRefFrequency() const {
-  return TyTChannelExtension::RefFrequency(getUInt2(4,0));
+  return TyTChannelExtension::RefFrequency(getField<Fields::TXRefFrequency>());
 }
 void
 TyTCodeplug::ChannelElement::setTXRefFrequency(TyTChannelExtension::RefFrequency ref) {
-  setUInt2(4,0, uint8_t(ref));
+  setField<Fields::TXRefFrequency>(uint8_t(ref));
 }
 
 bool
 TyTCodeplug::ChannelElement::vox() const {
-  return getBit(4,4);
+  return getField<Fields::VOX>();
 }
 void
 TyTCodeplug::ChannelElement::enableVOX(bool enable) {
   if (enable)
     logDebug() << "Enable VOX!";
-  setBit(4,4, enable);
+  setField<Fields::VOX>(enable);
 }
 
 TyTCodeplug::ChannelElement::Admit
 TyTCodeplug::ChannelElement::admitCriterion() const {
-  return TyTCodeplug::ChannelElement::Admit(getUInt2(4,6));
+  return TyTCodeplug::ChannelElement::Admit(getField<Fields::AdmitCriterion>());
 }
 void
 TyTCodeplug::ChannelElement::setAdmitCriterion(TyTCodeplug::ChannelElement::Admit admit) {
-  setUInt2(4,6, uint8_t(admit));
+  setField<Fields::AdmitCriterion>(admit);
 }
 
 uint16_t
 TyTCodeplug::ChannelElement::contactIndex() const {
-  return getUInt16_le(6);
+  return getField<Fields::ContactIndex>();
 }
 void
 TyTCodeplug::ChannelElement::setContactIndex(uint16_t idx) {
-  setUInt16_le(6, idx);
+  setField<Fields::ContactIndex>(idx);
 }
 
 unsigned TyTCodeplug::ChannelElement::txTimeOut() const {
-  return getUInt6(8, 0)*15;
+  return getField<Fields::TXTimeOut>()*15;
 }
 void
 TyTCodeplug::ChannelElement::setTXTimeOut(unsigned tot) {
-  return setUInt6(8, 0, tot/15);
+  setField<Fields::TXTimeOut>(tot/15);
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::txTimeOutRekeyDelay() const {
-  return getUInt8(9);
+  return getField<Fields::TXTimeOutRekeyDelay>();
 }
 void
 TyTCodeplug::ChannelElement::setTXTimeOutRekeyDelay(uint8_t delay) {
-  return setUInt8(9, delay);
+  setField<Fields::TXTimeOutRekeyDelay>(delay);
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::emergencySystemIndex() const {
-  return getUInt8(10);
+  return getField<Fields::EmergencySystemIndex>();
 }
 void
 TyTCodeplug::ChannelElement::setEmergencySystemIndex(uint8_t delay) {
-  return setUInt8(10, delay);
+  setField<Fields::EmergencySystemIndex>(delay);
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::scanListIndex() const {
-  return getUInt8(11);
+  return getField<Fields::ScanListIndex>();
 }
 void
 TyTCodeplug::ChannelElement::setScanListIndex(uint8_t idx) {
-  return setUInt8(11, idx);
+  setField<Fields::ScanListIndex>(idx);
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::groupListIndex() const {
-  return getUInt8(12);
+  return getField<Fields::GroupListIndex>();
 }
 void
 TyTCodeplug::ChannelElement::setGroupListIndex(uint8_t idx) {
-  return setUInt8(12, idx);
+  setField<Fields::GroupListIndex>(idx);
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::positioningSystemIndex() const {
-  return getUInt8(13);
+  return getField<Fields::PositioningSystemIndex>();
 }
 void
 TyTCodeplug::ChannelElement::setPositioningSystemIndex(uint8_t idx) {
-  return setUInt8(13, idx);
+  setField<Fields::PositioningSystemIndex>(idx);
 }
 
 bool
@@ -341,83 +339,83 @@ TyTCodeplug::ChannelElement::setDTMFDecode(uint8_t idx, bool enable) {
 
 uint32_t
 TyTCodeplug::ChannelElement::rxFrequency() const {
-  return getBCD8_le(16)*10;
+  return getField<Fields::RXFrequency>()*10;
 }
 void
 TyTCodeplug::ChannelElement::setRXFrequency(uint32_t freq_Hz) {
-  return setBCD8_le(16, freq_Hz/10);
+  setField<Fields::RXFrequency>(freq_Hz/10);
 }
 
 uint32_t
 TyTCodeplug::ChannelElement::txFrequency() const {
-  return getBCD8_le(20)*10;
+  return getField<Fields::TXFrequency>()*10;
 }
 void
 TyTCodeplug::ChannelElement::setTXFrequency(uint32_t freq_Hz) {
-  return setBCD8_le(20, freq_Hz/10);
+  setField<Fields::TXFrequency>(freq_Hz/10);
 }
 
 Signaling::Code
 TyTCodeplug::ChannelElement::rxSignaling() const {
-  return decode_ctcss_tone_table(getUInt16_le(24));
+  return decode_ctcss_tone_table(getField<Fields::RXSignaling>());
 }
 void
 TyTCodeplug::ChannelElement::setRXSignaling(Signaling::Code code) {
-  setUInt16_le(24, encode_ctcss_tone_table(code));
+  setField<Fields::RXSignaling>(encode_ctcss_tone_table(code));
 }
 
 Signaling::Code
 TyTCodeplug::ChannelElement::txSignaling() const {
-  return decode_ctcss_tone_table(getUInt16_le(26));
+  return decode_ctcss_tone_table(getField<Fields::TXSignaling>());
 }
 void
 TyTCodeplug::ChannelElement::setTXSignaling(Signaling::Code code) {
-  setUInt16_le(26, encode_ctcss_tone_table(code));
+  setField<Fields::TXSignaling>(encode_ctcss_tone_table(code));
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::rxSignalingSystemIndex() const {
-  return getUInt8(28);
+  return getField<Fields::RXSignalingSystemIndex>();
 }
 void
 TyTCodeplug::ChannelElement::setRXSignalingSystemIndex(uint8_t idx) {
-  setUInt8(28, idx);
+  setField<Fields::RXSignalingSystemIndex>(idx);
 }
 
 uint8_t
 TyTCodeplug::ChannelElement::txSignalingSystemIndex() const {
-  return getUInt8(29);
+  return getField<Fields::TXSignalingSystemIndex>();
 }
 void
 TyTCodeplug::ChannelElement::setTXSignalingSystemIndex(uint8_t idx) {
-  setUInt8(29, idx);
+  setField<Fields::TXSignalingSystemIndex>(idx);
 }
 
 bool
 TyTCodeplug::ChannelElement::txGPSInfo() const {
-  return ! getBit(31, 0);
+  return getField<Fields::TXGPSInfo>();
 }
 void
 TyTCodeplug::ChannelElement::enableTXGPSInfo(bool enable) {
-  setBit(31,0, !enable);
+  setField<Fields::TXGPSInfo>(enable);
 }
 
 bool
 TyTCodeplug::ChannelElement::rxGPSInfo() const {
-  return !getBit(31, 1);
+  return getField<Fields::RXGPSInfo>();
 }
 void
 TyTCodeplug::ChannelElement::enableRXGPSInfo(bool enable) {
-  setBit(31,1, !enable);
+  setField<Fields::RXGPSInfo>(enable);
 }
 
 QString
 TyTCodeplug::ChannelElement::name() const {
-  return readUnicode(32, 16, 0x0000);
+  return getField<Fields::Name>();
 }
 void
 TyTCodeplug::ChannelElement::setName(const QString &name) {
-  return writeUnicode(32, name, 16, 0x0000);
+  setField<Fields::Name>(name);
 }
 
 Channel *
@@ -654,11 +652,11 @@ TyTCodeplug::ChannelElement::fromChannelObj(const Channel *chan, Context &ctx) {
 TyTCodeplug::ContactElement::ContactElement(uint8_t *ptr, size_t size)
   : Codeplug::Element(ptr, size)
 {
-  // pass...
+  checkLayoutSize(Layout::Size);
 }
 
 TyTCodeplug::ContactElement::ContactElement(uint8_t *ptr)
-  : Codeplug::Element(ptr, CONTACT_SIZE)
+  : Codeplug::Element(ptr, Layout::Size)
 {
   // pass...
 }
@@ -669,14 +667,14 @@ TyTCodeplug::ContactElement::~ContactElement() {
 
 bool
 TyTCodeplug::ContactElement::isValid() const {
-  return Element::isValid() && (0 != getUInt2(3, 0))
+  return Element::isValid() && (0 != getField<Fields::CallType>())
       && (0x0000 != getUInt16_be(4)) && (0xffff != getUInt16_be(4));
 }
 
 void
 TyTCodeplug::ContactElement::clear() {
   memset(_data, 0xff, 3); // clear DMR ID
-  setUInt2(3, 0, 0);      // type=0
+  setField<Fields::CallType>(0); // type=0
   setBit(3,2, 0); setBit(3,3, 0); setBit(3,4, 0); // unused = 0
   enableRingTone(false);
   setBit(3,6, 1); setBit(3,7, 1); // unknown = 1
@@ -685,25 +683,25 @@ TyTCodeplug::ContactElement::clear() {
 
 uint32_t
 TyTCodeplug::ContactElement::dmrId() const {
-  return getUInt24_le(0);
+  return getField<Fields::DMRId>();
 }
 
 void
 TyTCodeplug::ContactElement::setDMRId(uint32_t id) {
-  setUInt24_le(0, id);
+  setField<Fields::DMRId>(id);
 }
 
 bool
 TyTCodeplug::ContactElement::ringTone() const {
-  return getBit(3, 5);
+  return getField<Fields::RingTone>();
 }
 void
 TyTCodeplug::ContactElement::enableRingTone(bool enable) {
-  setBit(3, 5, enable);
+  setField<Fields::RingTone>(enable);
 }
 
 DigitalContact::Type TyTCodeplug::ContactElement::callType() const {
-  switch(getUInt2(3,0)) {
+  switch(getField<Fields::CallType>()) {
   case 1: return DigitalContact::GroupCall;
   case 2: return DigitalContact::PrivateCall;
   case 3: return DigitalContact::AllCall;
@@ -715,19 +713,19 @@ DigitalContact::Type TyTCodeplug::ContactElement::callType() const {
 void
 TyTCodeplug::ContactElement::setCallType(DigitalContact::Type type) {
   switch (type) {
-  case DigitalContact::GroupCall:   setUInt2(3,0, 1); break;
-  case DigitalContact::PrivateCall: setUInt2(3,0, 2); break;
-  case DigitalContact::AllCall:     setUInt2(3,0, 3); break;
+  case DigitalContact::GroupCall:   setField<Fields::CallType>(1); break;
+  case DigitalContact::PrivateCall: setField<Fields::CallType>(2); break;
+  case DigitalContact::AllCall:     setField<Fields::CallType>(3); break;
   }
 }
 
 QString
 TyTCodeplug::ContactElement::name() const {
-  return readUnicode(4, 16, 0x0000);
+  return getField<Fields::Name>();
 }
 void
 TyTCodeplug::ContactElement::setName(const QString &nm) {
-  writeUnicode(4, nm, 16, 0x0000);
+  setField<Fields::Name>(nm);
 }
 
 DigitalContact *
@@ -2808,7 +2806,7 @@ TyTCodeplug::clear()
 }
 
 bool
-TyTCodeplug::encode(Config *config, const Flags &flags, const ErrorStack &err) {
+TyTCodeplug::prepareEncoding(Config *config, Context &ctx, const ErrorStack &err) const {
   // Check if default DMR id is set.
   if (nullptr == config->radioIDs()->defaultId()) {
     errMsg(err) << "Cannot encode TyT codeplug: No default radio ID specified.";
@@ -2816,11 +2814,16 @@ TyTCodeplug::encode(Config *config, const Flags &flags, const ErrorStack &err) {
   }
 
   // Create index<->object table.
+  return index(config, ctx, err);
+}
+
+bool
+TyTCodeplug::encode(Config *config, const Flags &flags, const ErrorStack &err) {
   Context ctx(config);
-  if (! index(config, ctx))
+  if (! prepareEncoding(config, ctx, err))
     return false;
 
-  return this->encodeElements(flags, ctx);
+  return this->encodeElements(flags, ctx, err);
 }
 
 bool
@@ -2828,10 +2831,16 @@ TyTCodeplug::decode(Config *config, const ErrorStack &err) {
   // Create index<->object table.
   Context ctx(config);
 
-  // Clear config object
+  // Clear config object, the lists get notified once all elements are decoded
+  config->beginUpdate();
   config->clear();
 
-  return this->decodeElements(ctx, err);
+  bool ok = this->decodeElements(ctx, err);
+  // Drop the partially decoded config at once on failure
+  if (! ok)
+    config->clear();
+  config->endUpdate();
+  return ok;
 }
 
 bool
@@ -61,6 +61,47 @@ public:
       ADMIT_COLOR = 3,              ///< Allow TX if color-code matches.
     };
 
+  protected:
+    /** Layout of the encoded channel. */
+    typedef CodeplugLayout<0x40> Layout;
+    /** Fields of the encoded channel. */
+    struct Fields {
+      typedef Layout::Bits<0, 0, 2>       Mode;                   ///< Channel mode.
+      typedef Layout::Bits<0, 2, 2>       Bandwidth;              ///< Bandwidth.
+      typedef Layout::Flag<0, 4>          AutoScan;               ///< Auto-scan flag.
+      typedef Layout::Flag<0, 7>          LoneWorker;             ///< Lone-worker flag.
+      typedef Layout::Flag<1, 0, true>    Talkaround;             ///< Talkaround flag (inverted).
+      typedef Layout::Flag<1, 1>          RXOnly;                 ///< RX-only flag.
+      typedef Layout::Bits<1, 2, 2>       TimeSlot;               ///< Time slot (1 or 2).
+      typedef Layout::Bits<1, 4, 4>       ColorCode;              ///< Color code.
+      typedef Layout::Bits<2, 0, 4>       PrivacyIndex;           ///< Privacy key index.
+      typedef Layout::Bits<2, 4, 2>       PrivacyType;            ///< Privacy type.
+      typedef Layout::Flag<2, 6>          PrivateCallConfirm;     ///< Private call confirm flag.
+      typedef Layout::Flag<2, 7>          DataCallConfirm;        ///< Data call confirm flag.
+      typedef Layout::Bits<3, 0, 2>       RXRefFrequency;         ///< RX reference frequency.
+      typedef Layout::Flag<3, 3>          EmergencyAlarmACK;      ///< Emergency alarm ACK flag.
+      typedef Layout::Flag<3, 7, true>    DisplayPTTId;           ///< Display PTT ID (inverted).
+      typedef Layout::Bits<4, 0, 2>       TXRefFrequency;         ///< TX reference frequency.
+      typedef Layout::Flag<4, 4>          VOX;                    ///< VOX flag.
+      typedef Layout::Bits<4, 6, 2>       AdmitCriterion;         ///< TX admit criterion.
+      typedef Layout::UInt<6, 2>          ContactIndex;           ///< TX contact index.
+      typedef Layout::Bits<8, 0, 6>       TXTimeOut;              ///< TOT in multiples of 15s.
+      typedef Layout::UInt<9, 1>          TXTimeOutRekeyDelay;    ///< TOT re-key delay.
+      typedef Layout::UInt<10, 1>         EmergencySystemIndex;   ///< Emergency system index.
+      typedef Layout::UInt<11, 1>         ScanListIndex;          ///< Scan list index.
+      typedef Layout::UInt<12, 1>         GroupListIndex;         ///< Group list index.
+      typedef Layout::UInt<13, 1>         PositioningSystemIndex; ///< GPS system index.
+      typedef Layout::BCD<16, 4>          RXFrequency;            ///< RX frequency in 10Hz.
+      typedef Layout::BCD<20, 4>          TXFrequency;            ///< TX frequency in 10Hz.
+      typedef Layout::UInt<24, 2>         RXSignaling;            ///< RX CTCSS/DCS code.
+      typedef Layout::UInt<26, 2>         TXSignaling;            ///< TX CTCSS/DCS code.
+      typedef Layout::UInt<28, 1>         RXSignalingSystemIndex; ///< RX signaling system index.
+      typedef Layout::UInt<29, 1>         TXSignalingSystemIndex; ///< TX signaling system index.
+      typedef Layout::Flag<31, 0, true>   TXGPSInfo;              ///< TX GPS info (inverted).
+      typedef Layout::Flag<31, 1, true>   RXGPSInfo;              ///< RX GPS info (inverted).
+      typedef Layout::Unicode<32, 16>     Name;                   ///< Channel name.
+    };
+
   protected:
     /** Constructs a channel from the given memory. */
     ChannelElement(uint8_t *ptr, size_t size);
@@ -257,6 +298,17 @@ public:
    * @verbinclude tyt_contact.txt */
   class ContactElement: public Codeplug::Element
   {
+  protected:
+    /** Layout of the encoded contact. */
+    typedef CodeplugLayout<0x24> Layout;
+    /** Fields of the encoded contact. */
+    struct Fields {
+      typedef Layout::UInt<0, 3>      DMRId;    ///< DMR ID.
+      typedef Layout::Bits<3, 0, 2>   CallType; ///< Call type.
+      typedef Layout::Flag<3, 5>      RingTone; ///< Ring tone flag.
+      typedef Layout::Unicode<4, 16>  Name;     ///< Contact name.
+    };
+
   protected:
     /** Constructor. */
     ContactElement(uint8_t *ptr, size_t size);
@@ -1116,6 +1168,8 @@ public:
   virtual void clear();
 
   bool index(Config *config, Context &ctx, const ErrorStack &err=ErrorStack()) const;
+  /** Checks for a default radio ID and indexes the config. */
+  bool prepareEncoding(Config *config, Context &ctx, const ErrorStack &err=ErrorStack()) const;
 
   /** Decodes the binary codeplug and stores its content in the given generic configuration. */
   bool decode(Config *config, const ErrorStack &err=ErrorStack());
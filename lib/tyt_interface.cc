@@ -80,6 +80,11 @@ TyTInterface::isOpen() const {
   return DFUDevice::isOpen() && _ident.isValid();
 }
 
+QString
+TyTInterface::serialNumber() const {
+  return DFUDevice::serialNumber();
+}
+
 RadioInfo
 TyTInterface::identifier(const ErrorStack &err) {
   Q_UNUSED(err);
@@ -100,6 +100,7 @@ public:
 
   bool isOpen() const;
   RadioInfo identifier(const ErrorStack &err=ErrorStack());
+  QString serialNumber() const;
   void close();
 
   bool read_start(uint32_t bank, uint32_t addr, const ErrorStack &err=ErrorStack());
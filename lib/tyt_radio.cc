@@ -2,9 +2,16 @@
 #include "config.hh"
 #include "logger.hh"
 #include "utils.hh"
+#include "imagecache.hh"
 
 #define BSIZE 1024
 
+// Regions changed by the radio itself, i.e., timestamp, general and menu settings as well as the
+// VFO channels and boot settings. These are always read from the device.
+static const QList<ImageCache::Region> volatileRegions = {
+  {0, 0x002000, 0x000400}, {0, 0x02ec00, 0x000800}
+};
+
 
 TyTRadio::TyTRadio(TyTInterface *device, QObject *parent)
   : Radio(parent), _dev(device), _codeplugFlags(), _config(nullptr)
@@ -68,12 +75,13 @@ TyTRadio::startUploadCallsignDB(UserDatabase *db, bool blocking, const CallsignD
   if (StatusIdle != _task)
     return false;
 
-  logDebug() << "Encode call-sign DB.";
   if (nullptr == callsignDB()) {
     errMsg(err) << "Cannot upload callsign DB. DB not created.";
     return false;
   }
-  callsignDB()->encode(db, selection);
+  // Call-sign DB gets encoded within the radio thread
+  _userDB = db;
+  _selection = selection;
 
   _task = StatusUploadCallsigns;
   _errorStack = err;
@@ -132,7 +140,7 @@ TyTRadio::run() {
       return;
     }
 
-    if(! uploadCallsigns()) {
+    if ((! encodeCallsignDB(callsignDB())) || (! uploadCallsigns())) {
       _dev->reboot();
       _dev->close();
       _task = StatusError;
@@ -181,6 +189,8 @@ TyTRadio::download() {
     }
   }
 
+  ImageCache::store(ImageCache::key(name(), _dev->serialNumber()), codeplug());
+
   return true;
 }
 
@@ -197,26 +207,36 @@ TyTRadio::upload() {
 
   size_t totb = codeplug().memSize();
 
-  size_t bcount = 0;
+  Codeplug::Preparation prepared(&codeplug(), _config);
+
   // If codeplug gets updated, download codeplug from device first:
-  if (_codeplugFlags.updateCodePlug) {
-    for (int n=0; n<codeplug().image(0).numElements(); n++) {
-      unsigned addr = codeplug().image(0).element(n).address();
-      unsigned size = codeplug().image(0).element(n).data().size();
-      unsigned b0 = addr/BSIZE, nb = size/BSIZE;
-      for (unsigned b=0; b<nb; b++, bcount+=BSIZE) {
-        if (! _dev->read(0, (b0+b)*BSIZE, codeplug().data((b0+b)*BSIZE), BSIZE, _errorStack)) {
-          errMsg(_errorStack) << "Cannot upload codeplug.";
-          return false;
-        }
-        emit uploadProgress(float(bcount*50)/totb);
-      }
-    }
+  const QString cacheKey = ImageCache::key(name(), _dev->serialNumber());
+  if (_codeplugFlags.updateCodePlug && (! ImageCache::restoreOrRead(
+        cacheKey, codeplug(), BSIZE, volatileRegions,
+        [this](int image, uint32_t addr, uint8_t *data, const ErrorStack &err) {
+          Q_UNUSED(image);
+          return _dev->read(0, addr, data, BSIZE, err);
+        },
+        [this](size_t count, size_t total) { emit uploadProgress(float(count*50)/total); },
+        _errorStack)))
+  {
+    errMsg(_errorStack) << "Cannot upload codeplug.";
+    return false;
   }
 
   // Encode config into codeplug
   logDebug() << "Encode codeplug.";
-  codeplug().encode(_config, _codeplugFlags);
+  if (! prepared.wait(_errorStack)) {
+    errMsg(_errorStack) << "Cannot upload codeplug.";
+    return false;
+  }
+  if (! codeplug().encodeElements(_codeplugFlags, prepared.context(), _errorStack)) {
+    errMsg(_errorStack) << "Cannot upload codeplug.";
+    return false;
+  }
+
+  // The device content is unknown until the upload completes
+  ImageCache::invalidate(cacheKey);
 
   // then erase memory
   for (int i=0; i<codeplug().image(0).numElements(); i++)
@@ -225,7 +245,7 @@ TyTRadio::upload() {
 
   logDebug() << "Upload " << codeplug().image(0).numElements() << " elements.";
   // then, upload modified codeplug
-  bcount = 0;
+  size_t bcount = 0;
   for (int n=0; n<codeplug().image(0).numElements(); n++) {
     unsigned addr = codeplug().image(0).element(n).address();
     unsigned size = codeplug().image(0).element(n).memSize();
@@ -239,6 +259,8 @@ TyTRadio::upload() {
     }
   }
 
+  ImageCache::store(cacheKey, codeplug());
+
   return true;
 }
 
@@ -139,6 +139,11 @@ USBSerial::isOpen() const {
   return QSerialPort::isOpen();
 }
 
+QString
+USBSerial::serialNumber() const {
+  return QSerialPortInfo(*this).serialNumber();
+}
+
 void
 USBSerial::close() {
   if (isOpen())
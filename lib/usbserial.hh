@@ -40,6 +40,7 @@ public:
   bool isOpen() const;
   /** Closes the interface to the device. */
   void close();
+  QString serialNumber() const;
 
 public:
   /** Searches for all USB serial ports with the specified VID/PID. */
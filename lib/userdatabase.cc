@@ -1,13 +1,24 @@
 #include "userdatabase.hh"
-#include <QJsonDocument>
-#include <QJsonArray>
 #include <QStandardPaths>
 #include <QFile>
 #include <QDir>
-#include <QNetworkReply>
 #include <algorithm>
+#include <numeric>
+#include <vector>
 #include "logger.hh"
+#include "concurrency.hh"
+#include <QMutexLocker>
+#include <QReadLocker>
+#include <QWriteLocker>
 #include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <climits>
+
+// Size of the chunks, the user database file is read in.
+#define READ_CHUNK_SIZE 0x10000
+// Number of selections cached by selectSortedById().
+#define MAX_CACHED_SELECTIONS 4
 
 
 /* ********************************************************************************************* *
@@ -30,8 +41,13 @@ UserDatabase::User::User(const QJsonObject &obj)
 
 unsigned
 UserDatabase::User::distance(unsigned id) const {
+  return distance(this->id, id);
+}
+
+unsigned
+UserDatabase::User::distance(unsigned ida, unsigned idb) {
   // Fix number of digits
-  int a = this->id, b = id;
+  int a = ida, b = idb;
   int ad = std::ceil(std::log10(a));
   int bd = std::ceil(std::log10(b));
   if (ad > bd)
@@ -45,14 +61,476 @@ UserDatabase::User::distance(unsigned id) const {
 }
 
 
+/* ********************************************************************************************* *
+ * Implementation of Table
+ * ********************************************************************************************* */
+UserDatabase::Table::Table()
+  : _id(), _textOffset(1, 0), _text(), _city(), _state(), _country(), _pool(1), _poolIndex()
+{
+  // Index 0 of the pool is the empty string
+  _poolIndex.insert(QString(), 0);
+}
+
+int
+UserDatabase::Table::count() const {
+  return _id.count();
+}
+
+void
+UserDatabase::Table::clear() {
+  *this = Table();
+}
+
+void
+UserDatabase::Table::reserve(int n) {
+  _id.reserve(n);
+  _textOffset.reserve(NumTextColumns*n+1);
+  _city.reserve(n); _state.reserve(n); _country.reserve(n);
+}
+
+void
+UserDatabase::Table::squeeze() {
+  _id.squeeze();
+  _textOffset.squeeze();
+  _text.squeeze();
+  _city.squeeze(); _state.squeeze(); _country.squeeze();
+  _pool.squeeze();
+}
+
+void
+UserDatabase::Table::append(const User &user) {
+  _id.append(user.id);
+  const QString *texts[NumTextColumns] = { &user.call, &user.name, &user.surname, &user.comment };
+  for (int i=0; i<NumTextColumns; i++) {
+    _text.append(texts[i]->toUtf8());
+    _textOffset.append(_text.size());
+  }
+  _city.append(intern(user.city));
+  _state.append(intern(user.state));
+  _country.append(intern(user.country));
+}
+
+UserDatabase::User
+UserDatabase::Table::at(int idx) const {
+  User user;
+  user.id = _id[idx];
+  user.call = text(idx, CallColumn);
+  user.name = text(idx, NameColumn);
+  user.surname = text(idx, SurnameColumn);
+  user.comment = text(idx, CommentColumn);
+  // Pooled strings are implicitly shared, no copy is made here
+  user.city = _pool[_city[idx]];
+  user.state = _pool[_state[idx]];
+  user.country = _pool[_country[idx]];
+  return user;
+}
+
+UserDatabase::Table
+UserDatabase::Table::reordered(const QVector<int> &order) const {
+  Table table;
+  table._pool = _pool;
+  table._poolIndex = _poolIndex;
+  table.reserve(order.count());
+  table._text.reserve(_text.size());
+  foreach (int idx, order) {
+    table._id.append(_id[idx]);
+    for (int i=0; i<NumTextColumns; i++) {
+      quint32 start = _textOffset[NumTextColumns*idx+i], end = _textOffset[NumTextColumns*idx+i+1];
+      table._text.append(_text.constData()+start, end-start);
+      table._textOffset.append(table._text.size());
+    }
+    table._city.append(_city[idx]);
+    table._state.append(_state[idx]);
+    table._country.append(_country[idx]);
+  }
+  return table;
+}
+
+QString
+UserDatabase::Table::text(int idx, TextColumn column) const {
+  quint32 start = _textOffset[NumTextColumns*idx+column], end = _textOffset[NumTextColumns*idx+column+1];
+  if (start == end)
+    return QString();
+  return QString::fromUtf8(_text.constData()+start, end-start);
+}
+
+quint32
+UserDatabase::Table::intern(const QString &str) {
+  if (str.isEmpty())
+    return 0;
+  QHash<QString, quint32>::const_iterator item = _poolIndex.constFind(str);
+  if (_poolIndex.constEnd() != item)
+    return item.value();
+  quint32 idx = _pool.count();
+  _pool.append(str);
+  _poolIndex.insert(str, idx);
+  return idx;
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of User database entry parser
+ * ********************************************************************************************* */
+/** Skips whitespace. */
+static inline const char *
+skipSpace(const char *ptr, const char *end) {
+  while ((ptr < end) && ((' ' == *ptr) || ('\t' == *ptr) || ('\n' == *ptr) || ('\r' == *ptr)))
+    ptr++;
+  return ptr;
+}
+
+/** Decodes the escaped string between @c ptr and @c end. */
+static QString
+unescape(const char *ptr, const char *end) {
+  QString text;
+  const char *run = ptr;
+  while (ptr < end) {
+    if ('\\' != *ptr) {
+      ptr++;
+      continue;
+    }
+    text.append(QString::fromUtf8(run, ptr-run));
+    if ((ptr+1) >= end)
+      return text;
+    char c = ptr[1]; ptr += 2;
+    switch (c) {
+    case 'b': text.append(QChar('\b')); break;
+    case 'f': text.append(QChar('\f')); break;
+    case 'n': text.append(QChar('\n')); break;
+    case 'r': text.append(QChar('\r')); break;
+    case 't': text.append(QChar('\t')); break;
+    case 'u':
+      // Surrogate pairs are just appended as two UTF-16 code units
+      if (4 <= (end-ptr)) {
+        bool ok; ushort code = QByteArray(ptr, 4).toUShort(&ok, 16);
+        if (ok)
+          text.append(QChar(code));
+        ptr += 4;
+      }
+      break;
+    default: text.append(QChar::fromLatin1(c)); break;
+    }
+    run = ptr;
+  }
+  text.append(QString::fromUtf8(run, ptr-run));
+  return text;
+}
+
+/** Parses the string starting at @c ptr. If @c value is not @c nullptr, the decoded string is
+ * stored there. Returns the position past the string or @c nullptr on error. */
+static const char *
+parseString(const char *ptr, const char *end, QString *value) {
+  if ((ptr >= end) || ('"' != *ptr))
+    return nullptr;
+  const char *start = ++ptr;
+  bool escaped = false;
+  for (; (ptr < end) && ('"' != *ptr); ptr++) {
+    if ('\\' == *ptr) {
+      escaped = true; ptr++;
+    }
+  }
+  if (ptr >= end)
+    return nullptr;
+  if (value)
+    *value = escaped ? unescape(start, ptr) : QString::fromUtf8(start, ptr-start);
+  return ptr+1;
+}
+
+/** Skips the value starting at @c ptr. Returns the position past the value or @c nullptr on
+ * error. */
+static const char *
+skipValue(const char *ptr, const char *end) {
+  if (ptr >= end)
+    return nullptr;
+  if ('"' == *ptr)
+    return parseString(ptr, end, nullptr);
+  if (('{' == *ptr) || ('[' == *ptr)) {
+    int depth = 0;
+    while (ptr < end) {
+      if ('"' == *ptr) {
+        if (nullptr == (ptr = parseString(ptr, end, nullptr)))
+          return nullptr;
+        continue;
+      }
+      if (('{' == *ptr) || ('[' == *ptr))
+        depth++;
+      else if ((('}' == *ptr) || (']' == *ptr)) && (0 == --depth))
+        return ptr+1;
+      ptr++;
+    }
+    return nullptr;
+  }
+  // Numbers and literals
+  while ((ptr < end) && (',' != *ptr) && ('}' != *ptr) && (']' != *ptr) && (' ' != *ptr) &&
+         ('\t' != *ptr) && ('\n' != *ptr) && ('\r' != *ptr))
+    ptr++;
+  return ptr;
+}
+
+/** Parses the integer ID starting at @c ptr. Like @c QJsonValue::toInt, only integral numbers
+ * are accepted, anything else yields 0. Returns the position past the value or @c nullptr on
+ * error. */
+static const char *
+parseId(const char *ptr, const char *end, unsigned &id) {
+  const char *next = skipValue(ptr, end);
+  id = 0;
+  if ((nullptr == next) || ((('-' != *ptr)) && (('0' > *ptr) || ('9' < *ptr))))
+    return next;
+  char buffer[32];
+  size_t len = std::min(size_t(next-ptr), sizeof(buffer)-1);
+  memcpy(buffer, ptr, len); buffer[len] = 0;
+  double value = strtod(buffer, nullptr);
+  if ((value >= INT_MIN) && (value <= INT_MAX) && (int(value) == value))
+    id = int(value);
+  return next;
+}
+
+/** Returns @c true if the key of the given length equals @c name. */
+static inline bool
+isKey(const char *key, size_t len, const char *name) {
+  return (len == strlen(name)) && (0 == memcmp(key, name, len));
+}
+
+/** Parses a single entry of the "users" array into @c user. Returns @c false on error. */
+static bool
+parseUser(const char *ptr, const char *end, UserDatabase::User &user) {
+  ptr = skipSpace(ptr, end);
+  if ((ptr >= end) || ('{' != *ptr))
+    return false;
+  ptr = skipSpace(ptr+1, end);
+  if ((ptr < end) && ('}' == *ptr))
+    return true;
+
+  while (ptr < end) {
+    // Keys do not contain any escapes, compare them in place
+    const char *key = ptr+1;
+    if (nullptr == (ptr = parseString(ptr, end, nullptr)))
+      return false;
+    size_t keyLen = ptr-key-1;
+    ptr = skipSpace(ptr, end);
+    if ((ptr >= end) || (':' != *ptr))
+      return false;
+    ptr = skipSpace(ptr+1, end);
+    if (ptr >= end)
+      return false;
+
+    QString *field = nullptr;
+    if (isKey(key, keyLen, "id")) {
+      ptr = parseId(ptr, end, user.id);
+    } else {
+      if (isKey(key, keyLen, "callsign")) field = &user.call;
+      else if (isKey(key, keyLen, "fname")) field = &user.name;
+      else if (isKey(key, keyLen, "surname")) field = &user.surname;
+      else if (isKey(key, keyLen, "city")) field = &user.city;
+      else if (isKey(key, keyLen, "state")) field = &user.state;
+      else if (isKey(key, keyLen, "country")) field = &user.country;
+      else if (isKey(key, keyLen, "remarks")) field = &user.comment;
+      if (field && ('"' == *ptr))
+        ptr = parseString(ptr, end, field);
+      else
+        ptr = skipValue(ptr, end);
+    }
+    if (nullptr == ptr)
+      return false;
+
+    ptr = skipSpace(ptr, end);
+    if ((ptr < end) && ('}' == *ptr))
+      return true;
+    if ((ptr >= end) || (',' != *ptr))
+      return false;
+    ptr = skipSpace(ptr+1, end);
+  }
+  return false;
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of Reader
+ * ********************************************************************************************* */
+UserDatabase::Reader::Reader()
+{
+  reset();
+}
+
+void
+UserDatabase::Reader::reset() {
+  _depth = 0; _inString = _escape = false;
+  _expectKey = _inKey = false;
+  _inUsers = _inEntry = false;
+  _hasUsers = _usersIsArray = false;
+  _done = false;
+  _offset = 0;
+  _key.clear(); _entry.clear();
+  _users.clear();
+  _errorMessage.clear();
+}
+
+bool
+UserDatabase::Reader::feed(const QByteArray &data) {
+  return feed(data.constData(), data.size());
+}
+
+bool
+UserDatabase::Reader::feed(const char *data, qint64 size) {
+  if (! _errorMessage.isEmpty())
+    return false;
+
+  // Start of the current entry within this chunk
+  qint64 entryStart = 0;
+  for (qint64 i=0; i<size; i++) {
+    char c = data[i];
+
+    if (_inString) {
+      if (_escape)
+        _escape = false;
+      else if ('\\' == c)
+        _escape = true;
+      else if ('"' == c)
+        _inString = _inKey = false;
+      if (_inKey)
+        _key.append(c);
+      continue;
+    }
+
+    switch (c) {
+    case ' ': case '\t': case '\n': case '\r':
+      break;
+
+    case '"':
+      _inString = true;
+      if ((1 == _depth) && _expectKey) {
+        _inKey = true; _key.clear();
+      } else if ((1 == _depth) && ("users" == _key)) {
+        _hasUsers = true;
+      }
+      break;
+
+    case '{': case '[':
+      if (_done)
+        return setError(QString("Unexpected data at offset %1.").arg(_offset+i));
+      if ((0 == _depth) && ('{' != c))
+        return setError("JSON document is not an object!");
+      if ((1 == _depth) && ("users" == _key)) {
+        _hasUsers = true;
+        _usersIsArray = _inUsers = ('[' == c);
+      }
+      if (_inUsers && (2 == _depth) && ('{' == c)) {
+        _inEntry = true; entryStart = i;
+      }
+      if (0 == _depth++)
+        _expectKey = true;
+      break;
+
+    case '}': case ']':
+      if (0 == _depth)
+        return setError(QString("Unexpected '%1' at offset %2.").arg(c).arg(_offset+i));
+      _depth--;
+      if (_inEntry && (2 == _depth)) {
+        // Entry is complete, parse it in place if it is within this chunk
+        User user;
+        bool ok;
+        if (_entry.isEmpty()) {
+          ok = parseUser(data+entryStart, data+i+1, user);
+        } else {
+          _entry.append(data+entryStart, i+1-entryStart);
+          ok = parseUser(_entry.constData(), _entry.constData()+_entry.size(), user);
+          _entry.clear();
+        }
+        if (! ok)
+          return setError(QString("Malformed user entry ending at offset %1.").arg(_offset+i));
+        if (user.isValid())
+          _users.append(user);
+        _inEntry = false;
+      } else if (_inUsers && (1 == _depth)) {
+        _inUsers = false;
+      } else if (0 == _depth) {
+        _done = true;
+      }
+      if (1 == _depth)
+        _key.clear();
+      break;
+
+    case ':':
+      if (1 == _depth)
+        _expectKey = false;
+      break;
+
+    case ',':
+      if (1 == _depth) {
+        _expectKey = true; _key.clear();
+      }
+      break;
+
+    default:
+      if (0 == _depth)
+        return setError(_done ? QString("Unexpected data at offset %1.").arg(_offset+i)
+                              : QString("JSON document is not an object!"));
+      if ((1 == _depth) && ("users" == _key))
+        _hasUsers = true;
+      break;
+    }
+  }
+
+  // Keep the incomplete entry for the next chunk
+  if (_inEntry)
+    _entry.append(data+entryStart, size-entryStart);
+  _offset += size;
+  return true;
+}
+
+bool
+UserDatabase::Reader::finish() {
+  if (! _errorMessage.isEmpty())
+    return false;
+  if (! _done)
+    return setError("Unexpected end of JSON document.");
+  if (! _hasUsers)
+    return setError("JSON object does not contain 'users' item.");
+  if (! _usersIsArray)
+    return setError("'users' item is not an array.");
+  return true;
+}
+
+qint64
+UserDatabase::Reader::count() const {
+  return _users.count();
+}
+
+UserDatabase::Table
+UserDatabase::Reader::takeUsers() {
+  Table users = _users;
+  users.squeeze();
+  reset();
+  return users;
+}
+
+const QString &
+UserDatabase::Reader::errorMessage() const {
+  return _errorMessage;
+}
+
+bool
+UserDatabase::Reader::setError(const QString &msg) {
+  _errorMessage = msg;
+  _users.clear(); _entry.clear();
+  return false;
+}
+
+
 /* ********************************************************************************************* *
  * Implementation of UserDatabase
  * ********************************************************************************************* */
 UserDatabase::UserDatabase(unsigned updatePeriodDays, QObject *parent)
-  : QAbstractTableModel(parent), _user(), _network()
+  : QAbstractTableModel(parent), _user(), _lock(),
+    _fetcher(QUrl("https://database.radioid.net/static/users.json"),
+             QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)+"/user.json"),
+    _download(), _selectionLock(), _selections()
 {
-  connect(&_network, SIGNAL(finished(QNetworkReply*)),
-          this, SLOT(downloadFinished(QNetworkReply*)));
+  connect(&_fetcher, SIGNAL(updated()), this, SLOT(onDownloaded()));
+  connect(&_fetcher, SIGNAL(error(QString)), this, SIGNAL(error(QString)));
+  connect(&_fetcher, SIGNAL(received(QByteArray)), this, SLOT(onReceived(QByteArray)));
+  connect(&_fetcher, SIGNAL(unchanged()), this, SLOT(onDownloadUnchanged()));
+  connect(&_fetcher, SIGNAL(error(QString)), this, SLOT(onDownloadDropped()));
 
   if ((! load()) || (updatePeriodDays < dbAge()))
     download();
@@ -60,18 +538,19 @@ UserDatabase::UserDatabase(unsigned updatePeriodDays, QObject *parent)
 
 qint64
 UserDatabase::count() const {
-  return _user.size();
+  QReadLocker locker(&_lock);
+  return _user.count();
 }
 
 bool
 UserDatabase::load() {
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  return load(path+"/user.json");
+  return load(_fetcher.filename());
 }
 
-const UserDatabase::User &
+UserDatabase::User
 UserDatabase::user(int idx) const {
-  return _user[idx];
+  QReadLocker locker(&_lock);
+  return _user.at(idx);
 }
 
 bool
@@ -83,56 +562,74 @@ UserDatabase::load(const QString &filename) {
     emit error(msg);
     return false;
   }
-  QByteArray data = file.readAll();
-  file.close();
 
-  QJsonDocument doc = QJsonDocument::fromJson(data);
-  if (! doc.isObject()) {
-    QString msg = "Failed to load user DB: JSON document is not an object!";
-    logError() << msg;
-    emit error(msg);
-    return false;
+  // Read file in chunks, only the users are kept in memory
+  Reader reader;
+  QByteArray buffer(READ_CHUNK_SIZE, 0);
+  while (! file.atEnd()) {
+    qint64 n = file.read(buffer.data(), buffer.size());
+    if (0 > n) {
+      QString msg = QString("Cannot read user list '%1': %2").arg(filename).arg(file.errorString());
+      logError() << msg;
+      emit error(msg);
+      return false;
+    }
+    if (! reader.feed(buffer.constData(), n))
+      break;
   }
-  if (! doc.object().contains("users")) {
-    QString msg = "Failed to load user DB: JSON object does not contain 'users' item.";
+  file.close();
+
+  if (! reader.finish()) {
+    QString msg = QString("Failed to load user DB: %1").arg(reader.errorMessage());
     logError() << msg;
     emit error(msg);
     return false;
   }
-  if (! doc.object()["users"].isArray()) {
-    QString msg = "Failed to load user DB: 'users' item is not an array.";
-    logError() << msg;
-    emit error(msg);
-    return false;
+
+  setUsers(reader.takeUsers(), filename);
+  return true;
+}
+
+void
+UserDatabase::setUsers(const Table &users, const QString &source) {
+  // Sort users w.r.t. their IDs, the database is usually sorted already
+  QVector<int> order(users.count());
+  std::iota(order.begin(), order.end(), 0);
+  bool sorted = std::is_sorted(order.begin(), order.end(), [&users](int a, int b) {
+    return users.id(a) < users.id(b);
+  });
+  if (! sorted) {
+    std::stable_sort(order.begin(), order.end(), [&users](int a, int b) {
+      return users.id(a) < users.id(b);
+    });
   }
 
+  Table table = sorted ? users : users.reordered(order);
   beginResetModel();
-  _user.clear();
-
-  QJsonArray array = doc.object()["users"].toArray();
-  _user.reserve(array.size());
-  for (int i=0; i<array.size(); i++) {
-    User user(array.at(i).toObject());
-    if (user.isValid())
-      _user.append(user);
-  }
-  // Sort repeater w.r.t. their IDs
-  std::stable_sort(_user.begin(), _user.end(), [](const User &a, const User &b){ return a.id < b.id; });
+  _lock.lockForWrite();
+  _user = table;
+  clearSelections();
+  _lock.unlock();
   // Done.
   endResetModel();
 
-  logDebug() << "Loaded user database with " << _user.size() << " entries from " << filename << ".";
+  logDebug() << "Loaded user database with " << _user.count() << " entries from " << source << ".";
 
   emit loaded();
-  return true;
 }
 
 void
 UserDatabase::sortUsers(unsigned id) {
   // Sort repeater w.r.t. distance to ID
-  std::stable_sort(_user.begin(), _user.end(), [id](const User &a, const User &b){
-    return a.distance(id) < b.distance(id);
+  QVector<int> order(_user.count());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this, id](int a, int b){
+    return User::distance(_user.id(a), id) < User::distance(_user.id(b), id);
   });
+  Table table = _user.reordered(order);
+  QWriteLocker locker(&_lock);
+  _user = table;
+  clearSelections();
 }
 
 void
@@ -141,71 +638,151 @@ UserDatabase::sortUsers(const QSet<unsigned> &ids) {
     return;
 
   // Sort repeater w.r.t. distance to each ID
-  std::stable_sort(_user.begin(), _user.end(), [ids](const User &a, const User &b){
+  QVector<int> order(_user.count());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this, ids](int a, int b){
     QSet<unsigned>::const_iterator id=ids.begin();
-    unsigned min_a = a.distance(*id), min_b = b.distance(*id);
+    unsigned min_a = User::distance(_user.id(a), *id), min_b = User::distance(_user.id(b), *id);
     id++;
     for (; id!=ids.end(); id++) {
-      min_a = std::min(min_a, a.distance(*id));
-      min_b = std::min(min_b, b.distance(*id));
+      min_a = std::min(min_a, User::distance(_user.id(a), *id));
+      min_b = std::min(min_b, User::distance(_user.id(b), *id));
     }
     return min_a < min_b;
   });
+  Table table = _user.reordered(order);
+  QWriteLocker locker(&_lock);
+  _user = table;
+  clearSelections();
+}
+
+QVector<int>
+UserDatabase::select(const QSet<unsigned> &ids, qint64 n) const {
+  QReadLocker locker(&_lock);
+  return selectIndices(ids, n);
+}
+
+QVector<int>
+UserDatabase::selectIndices(const QSet<unsigned> &ids, qint64 n) const {
+  n = std::max(qint64(0), std::min(n, qint64(_user.count())));
+  QVector<int> indices; indices.reserve(n);
+
+  // Without any preferred IDs, just take the first n users
+  if (ids.isEmpty()) {
+    for (int i=0; i<n; i++)
+      indices.append(i);
+    return indices;
+  }
+
+  // Compute the minimum distance of every user only once. The distance is stored in the upper
+  // 32bit and the index in the lower 32bit of the key. Hence, sorting the keys yields the same
+  // order as the stable sort in sortUsers().
+  QVector<unsigned> idList = ids.values().toVector();
+  std::vector<quint64> keys(_user.count());
+  parallel_for(_user.count(), [this, &idList, &keys](unsigned first, unsigned last) {
+    for (unsigned i=first; i<last; i++) {
+      unsigned dist = User::distance(_user.id(i), idList.first());
+      for (int j=1; j<idList.count(); j++)
+        dist = std::min(dist, User::distance(_user.id(i), idList[j]));
+      keys[i] = (quint64(dist) << 32) | i;
+    }
+  }, 4096);
+
+  // Only the first n keys need to be sorted
+  std::partial_sort(keys.begin(), keys.begin()+n, keys.end());
+  for (int i=0; i<n; i++)
+    indices.append(int(keys[i] & 0xffffffff));
+  return indices;
+}
+
+QVector<UserDatabase::User>
+UserDatabase::selectSortedById(const QSet<unsigned> &ids, qint64 n) const {
+  QReadLocker locker(&_lock);
+  n = std::max(qint64(0), std::min(n, qint64(_user.count())));
+
+  QMutexLocker selectionLocker(&_selectionLock);
+  for (int i=0; i<_selections.count(); i++) {
+    if ((_selections[i].count == n) && (_selections[i].ids == ids)) {
+      logDebug() << "Reuse selection of " << n << " users.";
+      // Keep most recently used first
+      _selections.move(i, 0);
+      return _selections.first().users;
+    }
+  }
+
+  // Sort the selected indices by the IDs of the users before constructing the users
+  QVector<int> indices = selectIndices(ids, n);
+  std::sort(indices.begin(), indices.end(), [this](int a, int b) {
+    return (_user.id(a) < _user.id(b)) || ((_user.id(a) == _user.id(b)) && (a < b));
+  });
+  Selection selection;
+  selection.ids = ids;
+  selection.count = n;
+  selection.users.reserve(n);
+  foreach (int idx, indices)
+    selection.users.append(_user.at(idx));
+
+  _selections.prepend(selection);
+  while (_selections.count() > MAX_CACHED_SELECTIONS)
+    _selections.removeLast();
+  return selection.users;
 }
 
 void
-UserDatabase::download() {
-  QUrl url("https://database.radioid.net/static/users.json");
-  QNetworkRequest request(url);
-  _network.get(request);
+UserDatabase::clearSelections() {
+  QMutexLocker locker(&_selectionLock);
+  _selections.clear();
 }
 
 void
-UserDatabase::downloadFinished(QNetworkReply *reply) {
-  if (reply->error()) {
-    QString msg = QString("Cannot download user database: %1").arg(reply->errorString());
-    logError() << msg;
-    emit error(msg);
+UserDatabase::download() {
+  if (_fetcher.isRunning())
     return;
-  }
+  _download.reset();
+  // Only ask for changes if the local copy has been loaded. Otherwise, a "304 Not Modified" would
+  // leave the database empty.
+  _fetcher.fetch(0 < count());
+}
 
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  QFile file(path+"/user.json");
-  QDir directory;
-  if ((! directory.exists(path)) && (!directory.mkpath(path))) {
-    QString msg = QString("Cannot create path '%1'.").arg(path);
-    logError() << msg;
-    emit error(msg);
-    return;
-  }
-  if (! file.open(QIODevice::WriteOnly)) {
-    QString msg = QString("Cannot save user database at '%1'.").arg(path+"/user.json");
-    logError() << msg;
-    emit error(msg);
+void
+UserDatabase::onDownloaded() {
+  // Use the users read while downloading, if possible
+  if (_download.finish()) {
+    setUsers(_download.takeUsers(), _fetcher.url().toString());
     return;
   }
+  logDebug() << "Cannot read user DB while downloading: " << _download.errorMessage()
+             << " Load from file.";
+  _download.reset();
+  load();
+}
 
-  file.write(reply->readAll());
-  file.flush();
-  file.close();
+void
+UserDatabase::onReceived(const QByteArray &data) {
+  _download.feed(data);
+}
 
-  load();
-  reply->deleteLater();
+void
+UserDatabase::onDownloadDropped() {
+  _download.reset();
+}
+
+void
+UserDatabase::onDownloadUnchanged() {
+  _download.reset();
+  // The local copy is loaded and up-to-date
+  emit loaded();
 }
 
 unsigned
 UserDatabase::dbAge() const {
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/user.json";
-  QFileInfo info(path);
-  if (! info.exists())
-    return -1;
-  return info.lastModified().daysTo(QDateTime::currentDateTime());
+  return _fetcher.age();
 }
 
 int
 UserDatabase::rowCount(const QModelIndex &parent) const {
   Q_UNUSED(parent);
-  return _user.size();
+  return _user.count();
 }
 
 int
@@ -219,35 +796,36 @@ UserDatabase::data(const QModelIndex &index, int role) const {
   if ((Qt::EditRole != role) && ((Qt::DisplayRole != role)))
     return QVariant();
 
-  if (index.row() >= _user.size())
+  if (index.row() >= _user.count())
     return QVariant();
+  User user = _user.at(index.row());
 
   if (0 == index.column()) {
     // Call
     if (Qt::DisplayRole == role) {
-      if (_user[index.row()].surname.isEmpty()) {
-        if (_user[index.row()].name.isEmpty()) {
-          return _user[index.row()].call;
+      if (user.surname.isEmpty()) {
+        if (user.name.isEmpty()) {
+          return user.call;
         } else {
           return tr("%1 (%2)")
-              .arg(_user[index.row()].call)
-              .arg(_user[index.row()].name);
+              .arg(user.call)
+              .arg(user.name);
         }
       } else {
         return tr("%1 (%2, %3)")
-            .arg(_user[index.row()].call)
-            .arg(_user[index.row()].name)
-            .arg(_user[index.row()].surname);
+            .arg(user.call)
+            .arg(user.name)
+            .arg(user.surname);
       }
     } else {
-      return _user[index.row()].call;
+      return user.call;
     }
   } else if (1 == index.column()) {
     // ID
-    return _user[index.row()].id;
+    return user.id;
   } else if (2 == index.column()) {
     // Country
-    return _user[index.column()].country;
+    return user.country;
   }
 
   return QVariant();
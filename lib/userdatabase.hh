@@ -4,11 +4,13 @@
 #include <QObject>
 #include <QVector>
 #include <QHash>
+#include <QMutex>
+#include <QReadWriteLock>
 #include <QJsonObject>
-#include <QNetworkAccessManager>
 #include <QAbstractTableModel>
 #include <QSortFilterProxyModel>
 #include <QGeoPositionInfoSource>
+#include "databasefetcher.hh"
 
 /** Auto-updating DMR user database.
  *
@@ -18,6 +20,10 @@
  * to help assemble private call contacts and to assemble so-called CSV callsign databases, that
  * are programmable to some DMR radios to resolve the DMR ID to callsigns and names.
  *
+ * The database gets loaded, sorted and accessed through the table-model interface only within the
+ * thread owning it. The methods @c count, @c user, @c select and @c selectSortedById are guarded
+ * by a read/write lock and may also be called from other threads.
+ *
  * @ingroup util */
 class UserDatabase : public QAbstractTableModel
 {
@@ -37,6 +43,8 @@ public:
 
     /** Returns the "distance" between this user and the given ID. */
     unsigned distance(unsigned id) const;
+    /** Returns the "distance" between the two given IDs. */
+    static unsigned distance(unsigned a, unsigned b);
 
 		/** The DMR ID of the user. */
 		unsigned id;
@@ -56,6 +64,132 @@ public:
     QString comment;
 	};
 
+  /** Columnar storage of all users.
+   *
+   * The database holds several hundred thousand users. Storing each as a @c User would require
+   * a separate allocation for every string. Instead, the IDs are kept in a single array, the
+   * low-cardinality columns (city, state and country) are interned in a string pool and the
+   * remaining strings are packed as UTF-8 into a single buffer. @c at constructs a @c User view
+   * of a single entry on demand. */
+  class Table {
+  public:
+    /** Constructs an empty table. */
+    Table();
+
+    /** Returns the number of users. */
+    int count() const;
+    /** Deletes all users. */
+    void clear();
+    /** Reserves space for @c n users. */
+    void reserve(int n);
+    /** Frees unused memory. */
+    void squeeze();
+
+    /** Appends the given user. */
+    void append(const User &user);
+    /** Returns a view of the user at the given index. */
+    User at(int idx) const;
+    /** Returns the ID of the user at the given index. */
+    inline unsigned id(int idx) const { return _id[idx]; }
+
+    /** Returns a copy of the table, where the i-th user is the user at index @c order[i]. */
+    Table reordered(const QVector<int> &order) const;
+
+  private:
+    /** Columns of packed UTF-8 strings. */
+    enum TextColumn {
+      CallColumn = 0, NameColumn, SurnameColumn, CommentColumn, NumTextColumns
+    };
+
+    /** Returns the text of the given column for the user at the given index. */
+    QString text(int idx, TextColumn column) const;
+    /** Returns the index of the given string within the pool, adds it if needed. */
+    quint32 intern(const QString &str);
+
+  private:
+    /** The IDs of all users. */
+    QVector<unsigned> _id;
+    /** Offsets of the packed strings, @c NumTextColumns per user plus the end offset. */
+    QVector<quint32> _textOffset;
+    /** The packed UTF-8 strings. */
+    QByteArray _text;
+    /** Pool indices of the cities. */
+    QVector<quint32> _city;
+    /** Pool indices of the states. */
+    QVector<quint32> _state;
+    /** Pool indices of the countries. */
+    QVector<quint32> _country;
+    /** The string pool. */
+    QVector<QString> _pool;
+    /** Maps strings to their index within the pool. */
+    QHash<QString, quint32> _poolIndex;
+  };
+
+  /** Incremental reader of the user database JSON document.
+   *
+   * The document gets fed in arbitrary chunks, e.g., as they are read from a file or received
+   * from the network. The reader only tracks the structure of the document and constructs the
+   * users directly from each entry of the "users" array once the entry is complete. Hence, no
+   * copy of the document or a DOM is kept and the memory needed is proportional to the number of
+   * users read. */
+  class Reader {
+  public:
+    /** Constructs an empty reader. */
+    Reader();
+
+    /** Resets the reader, all users read so far get dropped. */
+    void reset();
+    /** Processes the next chunk of the document. Returns @c false on error. */
+    bool feed(const char *data, qint64 size);
+    /** Processes the next chunk of the document. Returns @c false on error. */
+    bool feed(const QByteArray &data);
+    /** Checks if the complete document has been read. Returns @c false on error. */
+    bool finish();
+
+    /** Returns the number of users read so far. */
+    qint64 count() const;
+    /** Returns the users read so far and resets the reader. */
+    Table takeUsers();
+    /** Returns the last error message. */
+    const QString &errorMessage() const;
+
+  private:
+    /** Sets the error message and returns @c false. */
+    bool setError(const QString &msg);
+
+  private:
+    /** The current nesting depth. */
+    int _depth;
+    /** If @c true, the reader is within a string. */
+    bool _inString;
+    /** If @c true, the next character within a string is escaped. */
+    bool _escape;
+    /** If @c true, a key of the root object is expected next. */
+    bool _expectKey;
+    /** If @c true, the current string is a key of the root object. */
+    bool _inKey;
+    /** If @c true, the reader is within the "users" array. */
+    bool _inUsers;
+    /** If @c true, the reader is within an entry of the "users" array. */
+    bool _inEntry;
+    /** If @c true, the root object contains a "users" item. */
+    bool _hasUsers;
+    /** If @c true, the "users" item is an array. */
+    bool _usersIsArray;
+    /** If @c true, the root object has been closed. */
+    bool _done;
+    /** Number of bytes processed. */
+    qint64 _offset;
+    /** The last key of the root object. */
+    QByteArray _key;
+    /** Holds the part of the current entry received with previous chunks. */
+    QByteArray _entry;
+    /** The users read so far. */
+    Table _users;
+    /** The last error message. */
+    QString _errorMessage;
+  };
+
 public:
 	/** Constructs the user-database.
 	 * The constructor will download the current user database if it was not downloaded yet or
@@ -75,8 +209,25 @@ public:
   /** Sorts users with respect to the minimum distance to the given IDs. */
   void sortUsers(const QSet<unsigned> &ids);
 
-	/** Returns the user with index @c idx. */
-  const User &user(int idx) const;
+  /** Returns the indices of the @c n users closest to any of the given IDs. The indices are
+   * ordered by distance and, for equal distances, by their position within the database. That is,
+   * the result equals the first @c n users after calling @c sortUsers(ids). In contrast to
+   * @c sortUsers, this method does not modify the database. It holds the read lock, hence it may
+   * be called from another thread while the owning thread loads or sorts the database. However,
+   * the indices refer to the table at the time of the call and may be invalidated by a later
+   * reload or sort. If @c ids is empty, the first @c n users are selected. */
+  QVector<int> select(const QSet<unsigned> &ids, qint64 n) const;
+  /** Returns the @c n users closest to any of the given IDs (see @c select), sorted in ascending
+   * order of their IDs. This is the selection written to the callsign DBs of the radios. The
+   * result is cached, hence writing the callsign DB to several radios with the same selection
+   * requires only a single selection and sort. The selection is made and cached under the read
+   * lock, while the table is replaced and the cache is cleared under the write lock. Hence this
+   * method may be called from another thread, e.g., the radio thread, while the owning thread
+   * loads or sorts the database. */
+  QVector<User> selectSortedById(const QSet<unsigned> &ids, qint64 n) const;
+
+	/** Returns the user with index @c idx. Like @c count, this method holds the read lock. */
+  User user(int idx) const;
 
 	/** Returns the age of the database in days. */
 	unsigned dbAge() const;
@@ -89,7 +240,8 @@ public:
   QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
 
 signals:
-  /** Gets emitted once the call-sign database has been loaded. */
+  /** Gets emitted once the call-sign database has been loaded. Also gets emitted if a download
+   * finds the loaded database to be up-to-date. */
   void loaded();
   /** Gets emitted if the loading of the call-sign database fails. */
   void error(const QString &msg);
@@ -99,14 +251,50 @@ public slots:
 	void download();
 
 private slots:
-	/** Gets called whenever the download is complete. */
-	void downloadFinished(QNetworkReply *reply);
+	/** Gets called whenever a new version of the database has been downloaded. */
+	void onDownloaded();
+  /** Reads the next chunk of a running download. */
+  void onReceived(const QByteArray &data);
+  /** Drops the users read from a download that did not update the database. */
+  void onDownloadDropped();
+  /** Gets called if the local copy is still up-to-date. */
+  void onDownloadUnchanged();
+
+private:
+  /** Replaces all users by the given ones. */
+  void setUsers(const Table &users, const QString &source);
+  /** Drops all cached selections, the caller must hold the write lock. Hence no selection of
+   * the previous table can be cached after the table got replaced. */
+  void clearSelections();
+  /** Implements @c select, the caller must hold the read lock. */
+  QVector<int> selectIndices(const QSet<unsigned> &ids, qint64 n) const;
+
+private:
+  /** A cached selection, see @c selectSortedById. */
+  struct Selection {
+    /** The preferred IDs. */
+    QSet<unsigned> ids;
+    /** The number of selected users. */
+    qint64 count;
+    /** The selected users sorted by ID. */
+    QVector<User> users;
+  };
 
 private:
 	/** Holds all users sorted by their ID. */
-	QVector<User>         _user;
-	/** The network access used for downloading. */
-	QNetworkAccessManager _network;
+	Table                 _user;
+  /** Guards the users against replacement by @c setUsers or @c sortUsers while they are read
+   * from other threads (e.g., when encoding a callsign DB within the radio thread). Only the
+   * thread owning the database replaces the users, hence it may read them without locking. */
+  mutable QReadWriteLock _lock;
+	/** Keeps the downloaded database up-to-date. */
+	DatabaseFetcher       _fetcher;
+  /** Reads the database while it gets downloaded. */
+  Reader                _download;
+  /** Guards the cached selections. */
+  mutable QMutex        _selectionLock;
+  /** The most recently used selections. */
+  mutable QList<Selection> _selections;
 };
 
 
@@ -2,7 +2,11 @@
 #include <QRegExp>
 #include <QVector>
 #include <QHash>
+#include <QtEndian>
 #include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 // Maps APRS icon number to code-char
 static QVector<char> aprsIconCodeTable{
@@ -105,39 +109,56 @@ static QHash<unsigned, QString> aprsIconNameTable{
 
 QString
 decode_unicode(const uint16_t *data, size_t size, uint16_t fill) {
-  QString res; res.reserve(size);
-  for (size_t i=0; (i<size) && (fill!=data[i]); i++) {
-    res.append(QChar(data[i]));
-  }
-  return res;
+  size_t len = 0;
+  while ((len<size) && (fill!=data[len]))
+    len++;
+  return QString(reinterpret_cast<const QChar *>(data), len);
 }
 
 void
 encode_unicode(uint16_t *data, const QString &text, size_t size, uint16_t fill) {
-  for (size_t i=0; (i<size); i++) {
-    if (i<size_t(text.size()))
-      data[i] = text.at(i).unicode();
-    else
-      data[i] = fill;
-  }
+  size_t len = std::min(size, size_t(text.size()));
+  memcpy(data, text.utf16(), len*sizeof(uint16_t));
+  for (size_t i=len; i<size; i++)
+    data[i] = fill;
 }
 
 QString
 decode_ascii(const uint8_t *data, size_t size, uint16_t fill) {
-  QString res; res.reserve(size);
-  for (size_t i=0; (i<size) && (0!=data[i]) && (fill!=data[i]); i++)
-    res.append(QChar(data[i]));
-  return res;
+  size_t len = 0;
+  while ((len<size) && (0!=data[len]) && (fill!=data[len]))
+    len++;
+  // fromLatin1 uses the SIMD optimized conversion of Qt
+  return QString::fromLatin1(reinterpret_cast<const char *>(data), len);
 }
 
 void
 encode_ascii(uint8_t *data, const QString &text, size_t size, uint16_t fill) {
-  for (size_t i=0; (i<size); i++) {
-    if (i<size_t(text.size()))
-      data[i] = text.at(i).toLatin1();
-    else
-      data[i] = fill;
+  size_t len = std::min(size, size_t(text.size())), i = 0;
+  const uint16_t *src = text.utf16();
+#ifdef __SSE2__
+  // Narrow 8 chars at once, chars outside of Latin-1 are mapped to 0 like QChar::toLatin1() does.
+  const __m128i zero = _mm_setzero_si128();
+  for (; (i+8)<=len; i+=8) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src+i));
+    __m128i latin = _mm_cmpeq_epi16(_mm_srli_epi16(chars, 8), zero);
+    chars = _mm_and_si128(chars, latin);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(data+i), _mm_packus_epi16(chars, chars));
   }
+#endif
+  for (; i<len; i++)
+    data[i] = (src[i] < 0x100) ? src[i] : 0;
+  if (len < size)
+    memset(data+len, fill, size-len);
+}
+
+void
+encode_ascii_n(uint8_t *data, size_t stride, const QString *texts, size_t textStride,
+               size_t count, size_t size, uint16_t fill)
+{
+  const uint8_t *text = reinterpret_cast<const uint8_t *>(texts);
+  for (size_t i=0; i<count; i++, data+=stride, text+=textStride)
+    encode_ascii(data, *reinterpret_cast<const QString *>(text), size, fill);
 }
 
 QString
@@ -153,33 +174,59 @@ encode_utf8(uint8_t *data, const QString &text, size_t size, uint16_t fill) {
   memcpy(data, buffer.data(), std::min(size_t(buffer.size()), size));
 }
 
+/** Lookup tables to convert two digits at once from and to BCD. */
+struct BCDTables {
+  /** Maps 0-99 to the BCD byte. */
+  uint8_t encode[100];
+  /** Maps a BCD byte to 0-165 (invalid digits are decoded as their nibble value). */
+  uint8_t decode[256];
+
+  BCDTables() {
+    for (unsigned i=0; i<100; i++)
+      encode[i] = ((i/10) << 4) | (i%10);
+    for (unsigned i=0; i<256; i++)
+      decode[i] = (i >> 4)*10 + (i & 0xf);
+  }
+};
+static const BCDTables bcdTables;
+
+uint32_t
+encode_bcd8(uint32_t value) {
+  return uint32_t(bcdTables.encode[value % 100])
+      | (uint32_t(bcdTables.encode[(value / 100) % 100]) << 8)
+      | (uint32_t(bcdTables.encode[(value / 10000) % 100]) << 16)
+      | (uint32_t(bcdTables.encode[(value / 1000000) % 100]) << 24);
+}
+
+uint32_t
+decode_bcd8(uint32_t bcd) {
+  return uint32_t(bcdTables.decode[bcd & 0xff])
+      + uint32_t(bcdTables.decode[(bcd >> 8) & 0xff]) * 100
+      + uint32_t(bcdTables.decode[(bcd >> 16) & 0xff]) * 10000
+      + uint32_t(bcdTables.decode[(bcd >> 24) & 0xff]) * 1000000;
+}
+
 double
 decode_frequency(uint32_t bcd) {
-  double freq =
-      1e2  * ((bcd >> 28) & 0xf) +
-      1e1  * ((bcd >> 24) & 0xf) +
-      1.0  * ((bcd >> 20) & 0xf) +
-      1e-1 * ((bcd >> 16) & 0xf) +
-      1e-2 * ((bcd >> 12) & 0xf) +
-      1e-3 * ((bcd >>  8) & 0xf) +
-      1e-4 * ((bcd >>  4) & 0xf) +
-      1e-5 * ((bcd >>  0) & 0xf);
-  return freq;
+  return decode_bcd8(bcd) / 1e5;
 }
 
 uint32_t
 encode_frequency(double freq) {
   uint32_t hz = std::round(freq * 1e6);
-  uint32_t a  = (hz / 100000000) % 10;
-  uint32_t b  = (hz /  10000000) % 10;
-  uint32_t c  = (hz /   1000000) % 10;
-  uint32_t d  = (hz /    100000) % 10;
-  uint32_t e  = (hz /     10000) % 10;
-  uint32_t f  = (hz /      1000) % 10;
-  uint32_t g  = (hz /       100) % 10;
-  uint32_t h  = (hz /        10) % 10;
+  return encode_bcd8(hz / 10);
+}
 
-  return (a << 28) + (b << 24) + (c << 20) + (d << 16) + (e << 12) + (f << 8) + (g << 4) + h;
+void
+encode_frequencies(uint32_t *bcd, const double *freq, size_t count) {
+  for (size_t i=0; i<count; i++)
+    bcd[i] = encode_frequency(freq[i]);
+}
+
+void
+decode_frequencies(double *freq, const uint32_t *bcd, size_t count) {
+  for (size_t i=0; i<count; i++)
+    freq[i] = decode_frequency(bcd[i]);
 }
 
 
@@ -195,39 +242,45 @@ void encode_dmr_id_bin(uint8_t *id, uint32_t no) {
 
 
 uint32_t decode_dmr_id_bcd(const uint8_t *id) {
-  return ((id[0] >> 4) * 10000000
-      + (id[0] & 15) * 1000000
-      + (id[1] >> 4) * 100000
-      + (id[1] & 15) * 10000
-      + (id[2] >> 4) * 1000
-      + (id[2] & 15) * 100
-      + (id[3] >> 4) * 10
-      + (id[3] & 15));
+  return decode_bcd8(qFromBigEndian<uint32_t>(id));
 }
 
 uint32_t decode_dmr_id_bcd_le(const uint8_t *id) {
-  return ((id[3] >> 4) * 10000000
-      + (id[3] & 15) * 1000000
-      + (id[2] >> 4) * 100000
-      + (id[2] & 15) * 10000
-      + (id[1] >> 4) * 1000
-      + (id[1] & 15) * 100
-      + (id[0] >> 4) * 10
-      + (id[0] & 15));
+  return decode_bcd8(qFromLittleEndian<uint32_t>(id));
 }
 
 void encode_dmr_id_bcd(uint8_t *id, uint32_t no) {
-  id[0] = ((no / 10000000) << 4)    | ((no / 1000000) % 10);
-  id[1] = ((no / 100000 % 10) << 4) | ((no / 10000) % 10);
-  id[2] = ((no / 1000 % 10) << 4)   | ((no / 100) % 10);
-  id[3] = ((no / 10 % 10) << 4)     | (no % 10);
+  qToBigEndian(encode_bcd8(no), id);
 }
 
 void encode_dmr_id_bcd_le(uint8_t *id, uint32_t no) {
-  id[3] = ((no / 10000000) << 4)    | ((no / 1000000) % 10);
-  id[2] = ((no / 100000 % 10) << 4) | ((no / 10000) % 10);
-  id[1] = ((no / 1000 % 10) << 4)   | ((no / 100) % 10);
-  id[0] = ((no / 10 % 10) << 4)     | (no % 10);
+  qToLittleEndian(encode_bcd8(no), id);
+}
+
+void
+encode_dmr_ids_bcd(uint8_t *data, size_t stride, const uint32_t *ids, size_t idStride, size_t count) {
+  const uint8_t *id = reinterpret_cast<const uint8_t *>(ids);
+  for (size_t i=0; i<count; i++, data+=stride, id+=idStride)
+    qToBigEndian(encode_bcd8(*reinterpret_cast<const uint32_t *>(id)), data);
+}
+
+void
+encode_dmr_ids_bcd_le(uint8_t *data, size_t stride, const uint32_t *ids, size_t idStride, size_t count) {
+  const uint8_t *id = reinterpret_cast<const uint8_t *>(ids);
+  for (size_t i=0; i<count; i++, data+=stride, id+=idStride)
+    qToLittleEndian(encode_bcd8(*reinterpret_cast<const uint32_t *>(id)), data);
+}
+
+void
+decode_dmr_ids_bcd(uint32_t *ids, const uint8_t *data, size_t stride, size_t count) {
+  for (size_t i=0; i<count; i++, data+=stride)
+    ids[i] = decode_bcd8(qFromBigEndian<uint32_t>(data));
+}
+
+void
+decode_dmr_ids_bcd_le(uint32_t *ids, const uint8_t *data, size_t stride, size_t count) {
+  for (size_t i=0; i<count; i++, data+=stride)
+    ids[i] = decode_bcd8(qFromLittleEndian<uint32_t>(data));
 }
 
 QVector<char> bin_dtmf_tab = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','*','#'};
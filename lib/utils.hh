@@ -52,6 +52,34 @@ void encode_dmr_id_bcd(uint8_t *id, uint32_t num);
 /** Encodes bcd (32bit) encoded DMR ID, big endian. */
 void encode_dmr_id_bcd_le(uint8_t *id, uint32_t num);
 
+/** Encodes the given number (0-99999999) as a packed 8 digit BCD value, where the most significant
+ * digit is stored in the most significant nibble. */
+uint32_t encode_bcd8(uint32_t value);
+/** Decodes a packed 8 digit BCD value. */
+uint32_t decode_bcd8(uint32_t bcd);
+
+/** Encodes @c count frequencies (in MHz) as 8 digit BCD values. */
+void encode_frequencies(uint32_t *bcd, const double *freq, size_t count);
+/** Decodes @c count 8 digit BCD encoded frequencies (in MHz). */
+void decode_frequencies(double *freq, const uint32_t *bcd, size_t count);
+
+/** Encodes @c count DMR IDs as BCD (32bit, big endian). The IDs are read every @c idStride bytes
+ * starting at @c ids, and the encoded IDs are stored every @c stride bytes starting at @c data.
+ * This allows to encode the IDs directly from an array of records into an array of elements. */
+void encode_dmr_ids_bcd(uint8_t *data, size_t stride, const uint32_t *ids, size_t idStride, size_t count);
+/** Encodes @c count DMR IDs as BCD (32bit, little endian), see @c encode_dmr_ids_bcd. */
+void encode_dmr_ids_bcd_le(uint8_t *data, size_t stride, const uint32_t *ids, size_t idStride, size_t count);
+/** Decodes @c count BCD (32bit, big endian) encoded DMR IDs stored every @c stride bytes. */
+void decode_dmr_ids_bcd(uint32_t *ids, const uint8_t *data, size_t stride, size_t count);
+/** Decodes @c count BCD (32bit, little endian) encoded DMR IDs stored every @c stride bytes. */
+void decode_dmr_ids_bcd_le(uint32_t *ids, const uint8_t *data, size_t stride, size_t count);
+
+/** Encodes @c count strings as ASCII of up-to @c size chars each, see @c encode_ascii. The
+ * strings are read every @c textStride bytes starting at @c texts, and the encoded strings are
+ * stored every @c stride bytes starting at @c data. */
+void encode_ascii_n(uint8_t *data, size_t stride, const QString *texts, size_t textStride,
+                    size_t count, size_t size, uint16_t fill=0x00);
+
 QString decode_dtmf_bin(const uint8_t *num, int size=16, uint8_t fill=0xff);
 bool encode_dtmf_bin(const QString &number, uint8_t *num, int size=16, uint8_t fill=0xff);
 
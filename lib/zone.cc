@@ -22,6 +22,8 @@ Zone::Zone(QObject *parent)
   connect(&_A, SIGNAL(elementRemoved(int)), this, SIGNAL(modified()));
   connect(&_B, SIGNAL(elementAdded(int)), this, SIGNAL(modified()));
   connect(&_B, SIGNAL(elementRemoved(int)), this, SIGNAL(modified()));
+  connect(&_A, SIGNAL(elementsReset()), this, SIGNAL(modified()));
+  connect(&_B, SIGNAL(elementsReset()), this, SIGNAL(modified()));
 }
 
 Zone::Zone(const QString &name, QObject *parent)
@@ -31,6 +33,8 @@ Zone::Zone(const QString &name, QObject *parent)
   connect(&_A, SIGNAL(elementRemoved(int)), this, SIGNAL(modified()));
   connect(&_B, SIGNAL(elementAdded(int)), this, SIGNAL(modified()));
   connect(&_B, SIGNAL(elementRemoved(int)), this, SIGNAL(modified()));
+  connect(&_A, SIGNAL(elementsReset()), this, SIGNAL(modified()));
+  connect(&_B, SIGNAL(elementsReset()), this, SIGNAL(modified()));
 }
 
 Zone &
@@ -2,6 +2,7 @@
 #include <QMainWindow>
 #include <QtUiTools>
 #include <QDesktopServices>
+#include <QLockFile>
 
 #include "logger.hh"
 #include "radio.hh"
@@ -21,7 +22,9 @@
 #include "repeaterdatabase.hh"
 #include "userdatabase.hh"
 #include "talkgroupdatabase.hh"
+#include "configsearchindex.hh"
 #include "searchpopup.hh"
+#include "searchdialog.hh"
 #include "contactselectiondialog.hh"
 #include "configitemwrapper.hh"
 #include "generalsettingsview.hh"
@@ -37,11 +40,14 @@
 #include "extensionview.hh"
 #include "deviceselectiondialog.hh"
 #include "radioselectiondialog.hh"
+#include "radiodetector.hh"
+#include "configsnapshot.hh"
 
 
 Application::Application(int &argc, char *argv[])
-  : QApplication(argc, argv), _config(nullptr), _mainWindow(nullptr), _repeater(nullptr),
-    _lastDevice()
+  : QApplication(argc, argv), _config(nullptr), _mainWindow(nullptr), _searchDialog(nullptr), _repeater(nullptr),
+    _detector(nullptr), _lastDevice(), _autosave(), _autosaveWrite(),
+    _autosaveLock(nullptr)
 {
   setApplicationName("qdmr");
   setOrganizationName("DM3MAT");
@@ -62,6 +68,11 @@ Application::Application(int &argc, char *argv[])
   _users      = new UserDatabase(30, this);
   _talkgroups = new TalkGroupDatabase(30, this);
   _config = new Config(this);
+  _searchIndex = new ConfigSearchIndex(_config, this);
+  _detector = new RadioDetector(this);
+  connect(_detector, SIGNAL(deviceRemoved(USBDeviceDescriptor)),
+          this, SLOT(onDeviceRemoved(USBDeviceDescriptor)));
+  _detector->startWatching();
 
   if (argc>1) {
     QFileInfo info(argv[1]);
@@ -102,9 +113,23 @@ Application::Application(int &argc, char *argv[])
 
   logDebug() << "Last known position: " << _currentPosition.toString();
   connect(_config, SIGNAL(modified(ConfigItem*)), this, SLOT(onConfigModifed()));
+
+  // Take a snapshot of the codeplug some seconds after the last modification
+  _autosave.setSingleShot(true);
+  _autosave.setInterval(5000);
+  connect(&_autosave, SIGNAL(timeout()), this, SLOT(onAutosave()));
+  // Every instance writes its own snapshot, the lock tells running instances from crashed ones
+  _autosaveLock = new QLockFile(autosaveDir().absoluteFilePath(
+                                  QString("autosave-%1.lock").arg(applicationPid())));
+  _autosaveLock->setStaleLockTime(0);
+  if (! _autosaveLock->tryLock())
+    logWarn() << "Cannot lock autosave snapshot, it may get restored by another instance.";
 }
 
 Application::~Application() {
+  if (_autosaveWrite.valid())
+    _autosaveWrite.wait();
+  delete _autosaveLock;
   if (_mainWindow)
     delete _mainWindow;
   _mainWindow = nullptr;
@@ -146,6 +171,11 @@ Application::repeater() const{
   return _repeater;
 }
 
+ConfigSearchIndex *
+Application::searchIndex() const {
+  return _searchIndex;
+}
+
 
 QMainWindow *
 Application::createMainWindow() {
@@ -170,6 +200,7 @@ Application::createMainWindow() {
   QAction *newCP   = _mainWindow->findChild<QAction*>("actionNewCodeplug");
   QAction *loadCP  = _mainWindow->findChild<QAction*>("actionOpenCodeplug");
   QAction *saveCP  = _mainWindow->findChild<QAction*>("actionSaveCodeplug");
+  QAction *findCP  = _mainWindow->findChild<QAction*>("actionFind");
 
   QAction *findDev = _mainWindow->findChild<QAction*>("actionDetectDevice");
   QAction *verCP   = _mainWindow->findChild<QAction*>("actionVerifyCodeplug");
@@ -189,6 +220,7 @@ Application::createMainWindow() {
   connect(newCP, SIGNAL(triggered()), this, SLOT(newCodeplug()));
   connect(loadCP, SIGNAL(triggered()), this, SLOT(loadCodeplug()));
   connect(saveCP, SIGNAL(triggered()), this, SLOT(saveCodeplug()));
+  connect(findCP, SIGNAL(triggered()), this, SLOT(showSearch()));
   connect(quit, SIGNAL(triggered()), this, SLOT(quitApplication()));
   connect(about, SIGNAL(triggered()), this, SLOT(showAbout()));
   connect(sett, SIGNAL(triggered()), this, SLOT(showSettings()));
@@ -267,6 +299,7 @@ Application::createMainWindow() {
   }
 
   _mainWindow->restoreGeometry(settings.mainWindowState());
+  restoreAutosave();
   return _mainWindow;
 }
 
@@ -283,6 +316,7 @@ Application::newCodeplug() {
 
   _config->clear();
   _config->setModified(false);
+  discardAutosave();
 }
 
 
@@ -321,6 +355,7 @@ Application::loadCodeplug() {
     ErrorStack err;
     if (_config->readYAML(filename, err)) {
       _mainWindow->setWindowModified(false);
+      discardAutosave();
     } else {
       QMessageBox::critical(nullptr, tr("Cannot read codeplug."),
                             tr("Cannot read codeplug from file '%1': %2")
@@ -332,6 +367,7 @@ Application::loadCodeplug() {
     QTextStream stream(&file);
     if (_config->readCSV(stream, errorMessage)) {
       _mainWindow->setWindowModified(false);
+      discardAutosave();
     } else {
       QMessageBox::critical(nullptr, tr("Cannot read codeplug."),
                             tr("Cannot read codeplug from file '%1': %2")
@@ -377,6 +413,7 @@ Application::saveCodeplug() {
   QFileInfo info(filename);
   if (_config->toYAML(stream)) {
     _mainWindow->setWindowModified(false);
+    discardAutosave();
   } else {
     QMessageBox::critical(nullptr, tr("Cannot save codeplug"),
                           tr("Cannot save codeplug to file '%1'.").arg(filename));
@@ -403,24 +440,31 @@ Application::quitApplication() {
   if (_mainWindow)
     settings.setMainWindowState(_mainWindow->saveGeometry());
 
+  discardAutosave();
   quit();
 }
 
 
 Radio *
 Application::autoDetect(const ErrorStack &err) {
+  // First get all devices that are known by VID/PID, this also drops the cached radio information
+  // of unplugged devices
+  QList<USBDeviceDescriptor> interfaces = _detector->devices();
+  if (_lastDevice.isValid() && (! _detector->isConnected(_lastDevice)))
+    _lastDevice = USBDeviceDescriptor();
+
   // If the last detected device is still valid
   //  -> skip interface detection and selection
   if (! _lastDevice.isValid()) {
     logDebug() << "Last device is invalid, search for new one.";
-    // First get all devices that are known by VID/PID
-    QList<USBDeviceDescriptor> interfaces = USBDeviceDescriptor::detect();
     if (interfaces.isEmpty()) {
       errMsg(err) << tr("No matching devices found.");
       return nullptr;
     } else if ((1 != interfaces.count()) || (! interfaces.first().isSave())) {
-      // More than one device found, or device not save -> select by user
-      DeviceSelectionDialog dialog(interfaces);
+      // More than one device found, or device not save -> select by user. Identify all devices
+      // concurrently, that are save to probe, to show the connected radios.
+      QList<RadioInfo> radios = _detector->identify(interfaces);
+      DeviceSelectionDialog dialog(interfaces, radios);
       if (QDialog::Accepted != dialog.exec()) {
         return nullptr;
       }
@@ -430,9 +474,10 @@ Application::autoDetect(const ErrorStack &err) {
     }
   }
 
-  // Check if device supports identification
+  // Check if device supports identification, the radio selected by the user is cached until the
+  // device gets unplugged
   RadioInfo radioInfo;
-  if (! _lastDevice.isIdentifiable()) {
+  if ((! _lastDevice.isIdentifiable()) && (! _detector->hasRadioInfo(_lastDevice))) {
     RadioSelectionDialog dialog(_lastDevice);
     if (QDialog::Accepted != dialog.exec()) {
       return nullptr;
@@ -440,7 +485,7 @@ Application::autoDetect(const ErrorStack &err) {
     radioInfo = dialog.radioInfo();
   }
 
-  Radio *radio = Radio::detect(_lastDevice, radioInfo, err);
+  Radio *radio = _detector->detect(_lastDevice, radioInfo, err);
   if (nullptr == radio) {
     QMessageBox::critical(nullptr, tr("Cannot connect to radio"),
                           tr("Cannot connect to radio: %1").arg(err.format()));
@@ -548,6 +593,7 @@ Application::onCodeplugDownloaded(Radio *radio, Codeplug *codeplug) {
     _mainWindow->statusBar()->showMessage(tr("Read complete"));
     _mainWindow->findChild<QProgressBar *>("progress")->setVisible(false);
     _config->setModified(false);
+    discardAutosave();
   } else {
     ErrorMessageView(err).show();
   }
@@ -616,9 +662,11 @@ Application::uploadCallsignDB() {
     return;
   }
 
-  // Sort call-sign DB w.r.t. the current DMR ID in _config
-  // this is part of the "auto-selection" of calls-signs for upload
+  // Select call-signs closest to the current DMR ID in _config
+  // this is part of the "auto-selection" of calls-signs for upload. The actual selection and
+  // encoding is performed by the radio thread.
   Settings settings;
+  CallsignDB::Selection css;
   if (settings.selectUsingUserDMRID()) {
     if (nullptr == _config->radioIDs()->defaultId()) {
       QMessageBox::critical(nullptr, tr("Cannot write call-sign DB."),
@@ -627,30 +675,31 @@ Application::uploadCallsignDB() {
       radio->deleteLater();
       return;
     }
-    // Sort w.r.t users DMR ID
+    // Select w.r.t users DMR ID
     unsigned id = _config->radioIDs()->defaultId()->number();
-    logDebug() << "Sort call-signs closest to ID=" << id << ".";
-    _users->sortUsers(id);
+    logDebug() << "Select call-signs closest to ID=" << id << ".";
+    css.setPreferredId(id);
   } else {
-    // sort w.r.t. chosen prefixes
+    // select w.r.t. chosen prefixes
     QSet<unsigned> ids=settings.callSignDBPrefixes(); QStringList prefs;
     foreach (unsigned pref, ids)
       prefs.append(QString::number(pref));
-    logDebug() << "Sort call-signs closest to IDs={" << prefs.join(", ") << "}.";
-    _users->sortUsers(ids);
+    logDebug() << "Select call-signs closest to IDs={" << prefs.join(", ") << "}.";
+    css.setPreferredIds(ids);
   }
 
   // Assemble flags for callsign DB encoding
-  CallsignDB::Selection css;
   if (settings.limitCallSignDBEntries()) {
     logDebug() << "Limit callsign DB entries to " << settings.maxCallSignDBEntries() << ".";
     css.setCountLimit(settings.maxCallSignDBEntries());
   }
 
+  // Show a busy indicator while the call-sign DB gets encoded
   QProgressBar *progress = _mainWindow->findChild<QProgressBar *>("progress");
-  progress->setRange(0, 100); progress->setValue(0);
+  progress->setRange(0, 0); progress->setValue(0);
   progress->setVisible(true);
 
+  connect(radio, SIGNAL(uploadStarted()), this, SLOT(onCallsignDBUploadStarted()));
   connect(radio, SIGNAL(uploadProgress(int)), progress, SLOT(setValue(int)));
   connect(radio, SIGNAL(uploadError(Radio *)), this, SLOT(onCodeplugUploadError(Radio *)));
   connect(radio, SIGNAL(uploadComplete(Radio *)), this, SLOT(onCodeplugUploaded(Radio *)));
@@ -658,7 +707,7 @@ Application::uploadCallsignDB() {
   ErrorStack err;
   if (radio->startUploadCallsignDB(_users, false, css, err)) {
     logDebug() << "Start call-sign DB write...";
-    _mainWindow->statusBar()->showMessage(tr("Write call-sign DB ..."));
+    _mainWindow->statusBar()->showMessage(tr("Prepare call-sign DB ..."));
     _mainWindow->setEnabled(false);
   } else {
     ErrorMessageView(err).show();
@@ -667,6 +716,14 @@ Application::uploadCallsignDB() {
 }
 
 
+void
+Application::onCallsignDBUploadStarted() {
+  // Encoding is done, switch from busy indicator to upload progress
+  QProgressBar *progress = _mainWindow->findChild<QProgressBar *>("progress");
+  progress->setRange(0, 100); progress->setValue(0);
+  _mainWindow->statusBar()->showMessage(tr("Write call-sign DB ..."));
+}
+
 void
 Application::onCodeplugUploadError(Radio *radio) {
   _mainWindow->statusBar()->showMessage(tr("Write error"));
@@ -780,12 +837,144 @@ Application::showHelp() {
 }
 
 
+void
+Application::showSearch() {
+  if (nullptr == _searchDialog) {
+    _searchDialog = new SearchDialog(_config, _searchIndex, _mainWindow);
+    connect(_searchDialog, SIGNAL(jumpTo(ConfigObject*)), this, SLOT(jumpTo(ConfigObject*)));
+  }
+  _searchDialog->show();
+  _searchDialog->raise();
+  _searchDialog->activateWindow();
+}
+
+void
+Application::jumpTo(ConfigObject *obj) {
+  AbstractConfigObjectList *list = _searchIndex->listOf(obj);
+  if ((nullptr == list) || (nullptr == _mainWindow))
+    return;
+  int row = list->indexOf(obj);
+
+  // Find the view showing the list
+  QTabWidget *tabs = _mainWindow->findChild<QTabWidget*>("tabs");
+  for (int i=0; i<tabs->count(); i++) {
+    foreach (QAbstractItemView *view, tabs->widget(i)->findChildren<QAbstractItemView *>()) {
+      QAbstractItemModel *model = view->model();
+      AbstractConfigObjectList *shown = nullptr;
+      if (GenericTableWrapper *wrapper = qobject_cast<GenericTableWrapper *>(model))
+        shown = wrapper->list();
+      else if (GenericListWrapper *wrapper = qobject_cast<GenericListWrapper *>(model))
+        shown = wrapper->list();
+      if (list != shown)
+        continue;
+      // Models may populate their rows lazily
+      while ((row >= model->rowCount()) && model->canFetchMore(QModelIndex()))
+        model->fetchMore(QModelIndex());
+      if (row >= model->rowCount())
+        return;
+      tabs->setCurrentIndex(i);
+      view->setCurrentIndex(model->index(row, 0));
+      view->scrollTo(model->index(row, 0));
+      _mainWindow->activateWindow();
+      return;
+    }
+  }
+}
+
+
 void
 Application::onConfigModifed() {
   if (! _mainWindow)
     return;
 
   _mainWindow->setWindowModified(true);
+  _autosave.start();
+}
+
+void
+Application::onAutosave() {
+  if (! _mainWindow->isWindowModified())
+    return;
+
+  // Taking the snapshot is cheap but must happen here, writing it is done in the background
+  QByteArray data;
+  ErrorStack err;
+  if (! ConfigSnapshot::save(_config, data, err)) {
+    logWarn() << "Cannot take autosave snapshot: " << err.format();
+    return;
+  }
+
+  if (_autosaveWrite.valid())
+    _autosaveWrite.wait();
+  QString filename = autosaveFile();
+  _autosaveWrite = std::async(std::launch::async, [data, filename]() {
+    ErrorStack err;
+    if (! ConfigSnapshot::write(data, filename, err)) {
+      logWarn() << "Cannot write autosave snapshot: " << err.format();
+      return false;
+    }
+    logDebug() << "Autosaved codeplug to '" << filename << "'.";
+    return true;
+  });
+}
+
+QDir
+Application::autosaveDir() {
+  QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+  if (! dir.exists())
+    dir.mkpath(".");
+  return dir;
+}
+
+QString
+Application::autosaveFile() const {
+  return autosaveDir().absoluteFilePath(QString("autosave-%1.snapshot").arg(applicationPid()));
+}
+
+void
+Application::restoreAutosave() {
+  QDir dir = autosaveDir();
+  QFileInfoList snapshots = dir.entryInfoList(
+        QStringList() << "autosave-*.snapshot", QDir::Files, QDir::Time);
+  foreach (const QFileInfo &snapshot, snapshots) {
+    if (snapshot.absoluteFilePath() == autosaveFile())
+      continue;
+    // The snapshot is still in use if its instance is running. Locks held by instances that are
+    // gone are stale and get taken over. Holding the lock keeps other instances from restoring the
+    // same snapshot.
+    QLockFile lock(dir.absoluteFilePath(snapshot.completeBaseName() + ".lock"));
+    lock.setStaleLockTime(0);
+    if (! lock.tryLock())
+      continue;
+
+    if (QMessageBox::Yes == QMessageBox::question(
+          nullptr, tr("Restore unsaved codeplug?"),
+          tr("A previous session ended with unsaved changes to the codeplug. "
+             "Do you want to restore that codeplug?"),
+          QMessageBox::No|QMessageBox::Yes)) {
+      ErrorStack err;
+      if (ConfigSnapshot::read(_config, snapshot.absoluteFilePath(), err)) {
+        QFile::remove(snapshot.absoluteFilePath());
+        // Keep the restored codeplug safe until it gets saved
+        _mainWindow->setWindowModified(true);
+        onAutosave();
+        return;
+      }
+      QMessageBox::critical(nullptr, tr("Cannot restore codeplug."),
+                            tr("Cannot restore codeplug from '%1': %2")
+                            .arg(snapshot.absoluteFilePath()).arg(err.format()));
+      _config->clear();
+    }
+    QFile::remove(snapshot.absoluteFilePath());
+  }
+}
+
+void
+Application::discardAutosave() {
+  _autosave.stop();
+  if (_autosaveWrite.valid())
+    _autosaveWrite.wait();
+  QFile::remove(autosaveFile());
 }
 
 void
@@ -816,4 +1005,13 @@ Application::onPaletteChanged(const QPalette &palette) {
   }
 }
 
+void
+Application::onDeviceRemoved(const USBDeviceDescriptor &device) {
+  // Forget the last device once it gets unplugged, the user gets asked again
+  if (_lastDevice.isValid() && (device.deviceHandle() == _lastDevice.deviceHandle())) {
+    logDebug() << "Last device " << device.deviceHandle() << " disconnected.";
+    _lastDevice = USBDeviceDescriptor();
+  }
+}
+
 
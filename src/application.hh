@@ -4,15 +4,23 @@
 #include <QApplication>
 #include <QGroupBox>
 #include <QIcon>
+#include <QTimer>
+#include <QDir>
 #include "config.hh"
 #include <QGeoPositionInfoSource>
 #include "releasenotes.hh"
 #include "radio.hh"
+#include <future>
 
 class QMainWindow;
+class QLockFile;
 class RepeaterDatabase;
 class UserDatabase;
 class TalkGroupDatabase;
+class ConfigSearchIndex;
+class ConfigObject;
+class SearchDialog;
+class RadioDetector;
 class RadioIDListView;
 class GeneralSettingsView;
 class ContactListView;
@@ -37,6 +45,7 @@ public:
   UserDatabase *user() const;
   RepeaterDatabase *repeater() const;
   TalkGroupDatabase *talkgroup() const;
+  ConfigSearchIndex *searchIndex() const;
 
   bool hasPosition() const;
   QGeoCoordinate position() const;
@@ -62,6 +71,9 @@ public slots:
   void showAbout();
   void showHelp();
 
+  void showSearch();
+  void jumpTo(ConfigObject *obj);
+
 private slots:
   QMainWindow *createMainWindow();
 
@@ -70,16 +82,28 @@ private slots:
 
   void onCodeplugUploadError(Radio *radio);
   void onCodeplugUploaded(Radio *radio);
+  void onCallsignDBUploadStarted();
 
   void onConfigModifed();
+  void onAutosave();
 
   void positionUpdated(const QGeoPositionInfo &info);
 
   void onPaletteChanged(const QPalette &palette);
 
+  void onDeviceRemoved(const USBDeviceDescriptor &device);
+
+protected:
+  static QDir autosaveDir();
+  QString autosaveFile() const;
+  void restoreAutosave();
+  void discardAutosave();
+
 protected:
   Config *_config;
+  ConfigSearchIndex *_searchIndex;
   QMainWindow *_mainWindow;
+  SearchDialog *_searchDialog;
 
   GeneralSettingsView *_generalSettings;
   RadioIDListView *_radioIdTab;
@@ -101,8 +125,17 @@ protected:
 
   ReleaseNotes _releaseNotes;
 
+  // Detects radios and caches the radio information per device
+  RadioDetector *_detector;
   // Last detected device:
   USBDeviceDescriptor _lastDevice;
+
+  // Delays the autosave snapshot after modifications of the codeplug
+  QTimer _autosave;
+  // Pending write of the last autosave snapshot
+  std::future<bool> _autosaveWrite;
+  // Held while running, marks the autosave snapshot of this instance as in use
+  QLockFile *_autosaveLock;
 };
 
 #endif // APPLICATION_HH
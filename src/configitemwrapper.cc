@@ -1,9 +1,14 @@
 #include "configitemwrapper.hh"
 #include <cmath>
+#include <algorithm>
 #include "logger.hh"
 #include <QColor>
 #include <QPalette>
 #include <QWidget>
+#include <QEvent>
+
+/** Number of rows populated at once by table wrappers. */
+#define FETCH_BATCH_SIZE 256
 
 
 /* ********************************************************************************************* *
@@ -19,6 +24,7 @@ GenericListWrapper::GenericListWrapper(AbstractConfigObjectList *list, QObject *
   connect(_list, SIGNAL(elementAdded(int)), this, SLOT(onItemAdded(int)));
   connect(_list, SIGNAL(elementModified(int)), this, SLOT(onItemModified(int)));
   connect(_list, SIGNAL(elementRemoved(int)), this, SLOT(onItemRemoved(int)));
+  connect(_list, SIGNAL(elementsReset()), this, SLOT(onItemsReset()));
 }
 
 int
@@ -37,6 +43,11 @@ GenericListWrapper::columnCount(const QModelIndex &index) const {
   return 1;
 }
 
+AbstractConfigObjectList *
+GenericListWrapper::list() const {
+  return _list;
+}
+
 bool
 GenericListWrapper::moveUp(int row) {
   if ((0>=row) || (row>=_list->count()))
@@ -107,20 +118,36 @@ GenericListWrapper::onItemModified(int idx) {
   emit dataChanged(index(idx),index(idx));
 }
 
+void
+GenericListWrapper::onItemsReset() {
+  beginResetModel();
+  endResetModel();
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of GenericTableWrapper
  * ********************************************************************************************* */
+GenericTableWrapper::CachedRow::CachedRow()
+  : valid(false), inactive(0), cells()
+{
+  // pass...
+}
+
 GenericTableWrapper::GenericTableWrapper(AbstractConfigObjectList *list, QObject *parent)
-  : QAbstractTableModel(parent), _list(list)
+  : QAbstractTableModel(parent), _list(list), _loaded(0), _cache()
 {
   if (nullptr == _list)
     return;
 
+  _loaded = std::min(_list->count(), FETCH_BATCH_SIZE);
+  _cache.resize(_loaded);
+
   connect(_list, SIGNAL(destroyed(QObject*)), this, SLOT(onListDeleted()));
   connect(_list, SIGNAL(elementAdded(int)), this, SLOT(onItemAdded(int)));
   connect(_list, SIGNAL(elementModified(int)), this, SLOT(onItemModified(int)));
   connect(_list, SIGNAL(elementRemoved(int)), this, SLOT(onItemRemoved(int)));
+  connect(_list, SIGNAL(elementsReset()), this, SLOT(onItemsReset()));
 }
 
 int
@@ -128,26 +155,92 @@ GenericTableWrapper::rowCount(const QModelIndex &index) const {
   Q_UNUSED(index)
   if (nullptr == _list)
     return 0;
-  return _list->count();
+  return _loaded;
 }
 
 bool
-GenericTableWrapper::moveUp(int row) {
-  if ((0>=row) || (row>=_list->count()))
+GenericTableWrapper::canFetchMore(const QModelIndex &parent) const {
+  if (parent.isValid() || (nullptr == _list))
     return false;
-  beginMoveRows(QModelIndex(), row, row, QModelIndex(), row-1);
-  _list->moveUp(row);
-  endMoveRows();
-  emit modified();
-  return true;
+  return _loaded < _list->count();
+}
+
+void
+GenericTableWrapper::fetchMore(const QModelIndex &parent) {
+  if (! canFetchMore(parent))
+    return;
+  int n = std::min(_list->count()-_loaded, FETCH_BATCH_SIZE);
+  beginInsertRows(QModelIndex(), _loaded, _loaded+n-1);
+  _loaded += n;
+  _cache.resize(_loaded);
+  endInsertRows();
+}
+
+const GenericTableWrapper::CachedRow &
+GenericTableWrapper::cachedRow(int row) const {
+  CachedRow &cached = _cache[row];
+  if (! cached.valid) {
+    cached.cells.clear();
+    cached.inactive = 0;
+    formatRow(row, cached.cells, cached.inactive);
+    cached.valid = true;
+  }
+  return cached;
+}
+
+QVariant
+GenericTableWrapper::cachedData(int row, int column) const {
+  if ((0 > row) || (row >= _cache.count()))
+    return QVariant();
+  return cachedRow(row).cells.value(column);
+}
+
+bool
+GenericTableWrapper::cachedInactive(int row, int column) const {
+  if ((0 > row) || (row >= _cache.count()) || (0 > column) || (64 <= column))
+    return false;
+  return cachedRow(row).inactive & (quint64(1) << column);
+}
+
+void
+GenericTableWrapper::formatRow(int row, QVector<QVariant> &cells, quint64 &inactive) const {
+  Q_UNUSED(row); Q_UNUSED(inactive);
+  cells.resize(columnCount());
+}
+
+void
+GenericTableWrapper::invalidateRows(int first, int last) {
+  first = std::max(0, first); last = std::min(_cache.count()-1, last);
+  for (int i=first; i<=last; i++)
+    _cache[i].valid = false;
+}
+
+void
+GenericTableWrapper::watchList(AbstractConfigObjectList *list) {
+  if (nullptr == list)
+    return;
+  connect(list, SIGNAL(elementModified(int)), this, SLOT(onWatchedListModified()));
+  connect(list, SIGNAL(elementRemoved(int)), this, SLOT(onWatchedListModified()));
+  connect(list, SIGNAL(elementsReset()), this, SLOT(onWatchedListModified()));
+}
+
+AbstractConfigObjectList *
+GenericTableWrapper::list() const {
+  return _list;
+}
+
+bool
+GenericTableWrapper::moveUp(int row) {
+  return moveUp(row, row);
 }
 
 bool
 GenericTableWrapper::moveUp(int first, int last) {
-  if ((0>=first) || (last>=_list->count()))
+  if ((0>=first) || (last>=_loaded))
     return false;
   beginMoveRows(QModelIndex(), first, last, QModelIndex(), first-1);
   _list->moveUp(first, last);
+  invalidateRows(first-1, last);
   endMoveRows();
   emit modified();
   return true;
@@ -155,21 +248,19 @@ GenericTableWrapper::moveUp(int first, int last) {
 
 bool
 GenericTableWrapper::moveDown(int row) {
-  if ((0>row) || ((row+1)>=_list->count()))
-    return false;
-  beginMoveRows(QModelIndex(), row, row, QModelIndex(), row+2);
-  _list->moveDown(row);
-  endMoveRows();
-  emit modified();
-  return true;
+  return moveDown(row, row);
 }
 
 bool
 GenericTableWrapper::moveDown(int first, int last) {
-  if ((0>first) || ((last+1)>=_list->count()))
+  // Moving the last populated row down requires the next one
+  if ((last+1) >= _loaded)
+    fetchMore(QModelIndex());
+  if ((0>first) || ((last+1)>=_loaded))
     return false;
   beginMoveRows(QModelIndex(), first, last, QModelIndex(), last+2);
   _list->moveDown(first, last);
+  invalidateRows(first, last+1);
   endMoveRows();
   emit modified();
   return true;
@@ -179,35 +270,82 @@ void
 GenericTableWrapper::onListDeleted() {
   beginResetModel();
   _list = nullptr;
+  _loaded = 0;
+  _cache.clear();
   endResetModel();
 }
 
 void
 GenericTableWrapper::onItemAdded(int idx) {
+  // Items added beyond the populated rows are not known to the views yet, they get populated
+  // later by fetchMore().
+  if ((0 > idx) || (idx > _loaded))
+    return;
   beginInsertRows(QModelIndex(), idx, idx);
+  _cache.insert(idx, CachedRow());
+  _loaded++;
   endInsertRows();
 }
 
 void
 GenericTableWrapper::onItemRemoved(int idx) {
+  // Rows not populated yet are not known to the views
+  if (idx >= _loaded)
+    return;
   beginRemoveRows(QModelIndex(), idx, idx);
   //logDebug() << "Signal removal of item at idx=" << idx;
+  _cache.remove(idx);
+  _loaded--;
   endRemoveRows();
 }
 
 void
 GenericTableWrapper::onItemModified(int idx) {
+  if ((0 > idx) || (idx >= _loaded))
+    return;
+  invalidateRows(idx, idx);
   emit dataChanged(index(idx,0),index(idx,columnCount()-1));
 }
 
+void
+GenericTableWrapper::onItemsReset() {
+  beginResetModel();
+  _loaded = std::min(_list->count(), FETCH_BATCH_SIZE);
+  _cache.clear();
+  _cache.resize(_loaded);
+  endResetModel();
+}
+
+void
+GenericTableWrapper::onWatchedListModified() {
+  if (0 == _loaded)
+    return;
+  invalidateRows(0, _loaded-1);
+  emit dataChanged(index(0,0), index(_loaded-1, columnCount()-1));
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of ChannelListWrapper
  * ********************************************************************************************* */
 ChannelListWrapper::ChannelListWrapper(ChannelList *list, QObject *parent)
-  : GenericTableWrapper(list, parent)
+  : GenericTableWrapper(list, parent), _active(), _inactive()
 {
-  // pass...
+  updateColors();
+  if (QWidget *widget = qobject_cast<QWidget *>(parent))
+    widget->installEventFilter(this);
+
+  // Channels show the names of the referenced objects, hence changes to these objects must
+  // invalidate the cached rows
+  if ((nullptr != list) && (nullptr != list->config())) {
+    const Config *config = list->config();
+    watchList(config->radioIDs());
+    watchList(config->contacts());
+    watchList(config->rxGroupLists());
+    watchList(config->scanlists());
+    watchList(config->posSystems());
+    watchList(config->roaming());
+  }
 }
 
 int
@@ -226,34 +364,55 @@ ChannelListWrapper::data(const QModelIndex &index, int role) const {
   if (nullptr == _list)
     return QVariant();
 
-  if ((! index.isValid()) || (index.row()>=_list->count()))
+  if ((! index.isValid()) || (index.row()>=_loaded) || (index.column()>=columnCount()))
     return QVariant();
 
-  if (Qt::ForegroundRole == role) {
-    const QPalette &palette = qobject_cast<QWidget *>(QObject::parent())->palette();
-    QColor active   = palette.color(QPalette::Active, QPalette::Text);
-    QColor inactive = palette.color(QPalette::Inactive, QPalette::Text);
-    bool isDigital = dynamic_cast<ChannelList *>(_list)->channel(index.row())->is<DigitalChannel>();
-    switch(index.column()) {
-    case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8:
-      return active;
-    case 9: case 10: case 11: case 12: case 13:
-      return (isDigital ? active : inactive);
-    case 14:
-      return active;
-    case 15:
-      return (isDigital ? active : inactive);
-    case 16: case 17: case 18: case 19:
-      return (isDigital ? inactive : active);
-    }
-  }
+  if (Qt::ForegroundRole == role)
+    return cachedInactive(index.row(), index.column()) ? _inactive : _active;
 
   if ((Qt::DisplayRole!=role) && (Qt::EditRole!=role))
     return QVariant();
 
-  Channel *channel = dynamic_cast<ChannelList *>(_list)->channel(index.row());
+  return cachedData(index.row(), index.column());
+}
 
-  switch (index.column()) {
+bool
+ChannelListWrapper::eventFilter(QObject *obj, QEvent *event) {
+  if ((obj == QObject::parent()) && (QEvent::PaletteChange == event->type())) {
+    updateColors();
+    if (_loaded)
+      emit dataChanged(index(0,0), index(_loaded-1, columnCount()-1), {Qt::ForegroundRole});
+  }
+  return GenericTableWrapper::eventFilter(obj, event);
+}
+
+void
+ChannelListWrapper::updateColors() {
+  QWidget *widget = qobject_cast<QWidget *>(QObject::parent());
+  if (nullptr == widget)
+    return;
+  const QPalette &palette = widget->palette();
+  _active   = palette.color(QPalette::Active, QPalette::Text);
+  _inactive = palette.color(QPalette::Inactive, QPalette::Text);
+}
+
+void
+ChannelListWrapper::formatRow(int row, QVector<QVariant> &cells, quint64 &inactive) const {
+  Channel *channel = _list->get(row)->as<Channel>();
+  cells.resize(columnCount());
+  for (int i=0; i<cells.size(); i++)
+    cells[i] = formatCell(channel, i);
+  // Digital-only columns are inactive for analog channels and vice versa
+  if (channel->is<DigitalChannel>())
+    inactive = (quint64(1)<<16) | (quint64(1)<<17) | (quint64(1)<<18) | (quint64(1)<<19);
+  else
+    inactive = (quint64(1)<<9) | (quint64(1)<<10) | (quint64(1)<<11) | (quint64(1)<<12)
+        | (quint64(1)<<13) | (quint64(1)<<15);
+}
+
+QVariant
+ChannelListWrapper::formatCell(Channel *channel, int column) const {
+  switch (column) {
   case 0:
     if (channel->is<AnalogChannel>())
       return tr("Analog");
@@ -500,46 +659,35 @@ ContactListWrapper::columnCount(const QModelIndex &index) const {
 
 QVariant
 ContactListWrapper::data(const QModelIndex &index, int role) const {
-  if ((!index.isValid()) || (index.row()>=_list->count()))
+  if ((nullptr == _list) || (!index.isValid()) || (index.row()>=_loaded))
     return QVariant();
 
-  if (Qt::DisplayRole == role) {
-    Contact *contact = _list->get(index.row())->as<Contact>();
-    if (contact->is<DTMFContact>()) {
-      DTMFContact *dtmf = contact->as<DTMFContact>();
-      switch (index.column()) {
-        case 0:
-          return tr("DTMF");
-        case 1:
-          return dtmf->name();
-        case 2:
-          return dtmf->number();
-        case 3:
-          return (dtmf->ring() ? tr("On") : tr("Off"));
-        default:
-          return QVariant();
-      }
-    } else if (contact->is<DigitalContact>()) {
-      DigitalContact *digi = contact->as<DigitalContact>();
-      switch (index.column()) {
-        case 0:
-          switch (digi->type()) {
-            case DigitalContact::PrivateCall: return tr("Private Call");
-            case DigitalContact::GroupCall: return tr("Group Call");
-            case DigitalContact::AllCall: return tr("All Call");
-          }
-        case 1:
-          return digi->name();
-        case 2:
-          return digi->number();
-        case 3:
-          return (digi->ring() ? tr("On") : tr("Off"));
-        default:
-          return QVariant();
-      }
+  if (Qt::DisplayRole == role)
+    return cachedData(index.row(), index.column());
+
+  return QVariant();
+}
+
+void
+ContactListWrapper::formatRow(int row, QVector<QVariant> &cells, quint64 &inactive) const {
+  Q_UNUSED(inactive);
+  Contact *contact = _list->get(row)->as<Contact>();
+  cells.resize(columnCount());
+  if (DTMFContact *dtmf = contact->as<DTMFContact>()) {
+    cells[0] = tr("DTMF");
+    cells[1] = dtmf->name();
+    cells[2] = dtmf->number();
+    cells[3] = (dtmf->ring() ? tr("On") : tr("Off"));
+  } else if (DigitalContact *digi = contact->as<DigitalContact>()) {
+    switch (digi->type()) {
+      case DigitalContact::PrivateCall: cells[0] = tr("Private Call"); break;
+      case DigitalContact::GroupCall: cells[0] = tr("Group Call"); break;
+      case DigitalContact::AllCall: cells[0] = tr("All Call"); break;
     }
+    cells[1] = digi->name();
+    cells[2] = digi->number();
+    cells[3] = (digi->ring() ? tr("On") : tr("Off"));
   }
-  return QVariant();
 }
 
 
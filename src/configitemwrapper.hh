@@ -3,6 +3,7 @@
 
 #include "config.hh"
 #include <QAbstractTableModel>
+#include <QColor>
 
 class GenericListWrapper: public QAbstractListModel
 {
@@ -12,6 +13,9 @@ protected:
   GenericListWrapper(AbstractConfigObjectList *list, QObject *parent=nullptr);
 
 public:
+  /** Returns the wrapped list or @c nullptr if the list was deleted. */
+  AbstractConfigObjectList *list() const;
+
   /** Moves the channel at index @c idx one step up. */
   virtual bool moveUp(int idx);
   /** Moves the channels at one step up. */
@@ -40,6 +44,8 @@ protected slots:
   void onItemRemoved(int idx);
   /** Internal callback on modified channels. */
   void onItemModified(int idx);
+  /** Internal callback on bulk updates of the list. */
+  void onItemsReset();
 
 protected:
   /** Holds a weak reference to the list object. */
@@ -55,6 +61,9 @@ protected:
   GenericTableWrapper(AbstractConfigObjectList *list, QObject *parent=nullptr);
 
 public:
+  /** Returns the wrapped list or @c nullptr if the list was deleted. */
+  AbstractConfigObjectList *list() const;
+
   /** Moves the channel at index @c idx one step up. */
   virtual bool moveUp(int idx);
   /** Moves the channels at one step up. */
@@ -65,13 +74,49 @@ public:
   virtual bool moveDown(int first, int last);
 
   // QAbstractTableModel interface
-  /** Implements QAbstractTableModel, returns number of rows. */
+  /** Implements QAbstractTableModel, returns number of rows populated so far. */
   int rowCount(const QModelIndex &index) const;
+  /** Implements QAbstractTableModel, returns @c true if there are rows left to populate. */
+  bool canFetchMore(const QModelIndex &parent) const;
+  /** Implements QAbstractTableModel, populates the next batch of rows. */
+  void fetchMore(const QModelIndex &parent);
 
 signals:
   /** Gets emitted once the table has been changed. */
   void modified();
 
+protected:
+  /** Cached display data of a single row. */
+  struct CachedRow {
+    /** Empty constructor, creates an invalid row. */
+    CachedRow();
+    /** If @c true, the row has been formatted and is up to date. */
+    bool valid;
+    /** Bit-mask of inactive columns. */
+    quint64 inactive;
+    /** The display data for each column. */
+    QVector<QVariant> cells;
+  };
+
+protected:
+  /** Returns the cached display data of the specified cell. The row gets formatted using
+   * @c formatRow on first access. */
+  QVariant cachedData(int row, int column) const;
+  /** Returns the cached row, formats the row if needed. */
+  const CachedRow &cachedRow(int row) const;
+  /** Returns @c true if the specified cell was marked as inactive by @c formatRow. */
+  bool cachedInactive(int row, int column) const;
+  /** Formats all cells of the given row. Wrappers using the row cache must implement this method.
+   * @param row Specifies the row to format.
+   * @param cells Gets filled with the display data of each column.
+   * @param inactive Bit-mask of columns that are not applicable for the item in this row. */
+  virtual void formatRow(int row, QVector<QVariant> &cells, quint64 &inactive) const;
+  /** Invalidates the cached rows from @c first to @c last (inclusive). */
+  void invalidateRows(int first, int last);
+  /** Invalidates all cached rows whenever the given list changes. This is needed for lists of
+   * items that are referenced by the wrapped items, as their names are shown. */
+  void watchList(AbstractConfigObjectList *list);
+
 protected slots:
   /** Internal used callback on deleted config. */
   void onListDeleted();
@@ -81,10 +126,18 @@ protected slots:
   void onItemRemoved(int idx);
   /** Internal callback on modified channels. */
   void onItemModified(int idx);
+  /** Internal callback on bulk updates of the list. */
+  void onItemsReset();
+  /** Internal callback on modifications of a watched list. */
+  void onWatchedListModified();
 
 protected:
   /** Holds a weak reference to the list object. */
   AbstractConfigObjectList *_list;
+  /** Number of rows populated so far. */
+  int _loaded;
+  /** Per-row cache of display data, one entry for each populated row. */
+  mutable QVector<CachedRow> _cache;
 };
 
 
@@ -98,11 +151,27 @@ public:
 public:
   // QAbstractTableModel interface
   /** Implements QAbstractTableModel, returns number of colums. */
-  int columnCount(const QModelIndex &index) const;
+  int columnCount(const QModelIndex &index=QModelIndex()) const;
   /** Implements QAbstractTableModel, returns data at cell. */
   QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
   /** Implements QAbstractTableModel, returns header at section. */
   QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const;
+
+  /** Updates the cached text colors on palette changes of the parent widget. */
+  bool eventFilter(QObject *obj, QEvent *event);
+
+protected:
+  void formatRow(int row, QVector<QVariant> &cells, quint64 &inactive) const;
+  /** Formats a single cell of the given channel. */
+  QVariant formatCell(Channel *channel, int column) const;
+  /** Reads the text colors from the palette of the parent widget. */
+  void updateColors();
+
+protected:
+  /** Text color of active cells. */
+  QColor _active;
+  /** Text color of inactive cells. */
+  QColor _inactive;
 };
 
 
@@ -132,11 +201,14 @@ public:
 public:
   // Implementation of QAbstractTableModel
   /** Returns the number of columns, implements the QAbstractTableModel. */
-  int columnCount(const QModelIndex &index) const;
+  int columnCount(const QModelIndex &index=QModelIndex()) const;
   /** Returns the cell data at given index, implements the QAbstractTableModel. */
   QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
   /** Returns the header at given section, implements the QAbstractTableModel. */
   QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const;
+
+protected:
+  void formatRow(int row, QVector<QVariant> &cells, quint64 &inactive) const;
 };
 
 
@@ -1,14 +1,18 @@
 #include "deviceselectiondialog.hh"
 #include "ui_deviceselectiondialog.h"
 
-DeviceSelectionDialog::DeviceSelectionDialog(const QList<USBDeviceDescriptor> &interfaces, QWidget *parent) :
+DeviceSelectionDialog::DeviceSelectionDialog(const QList<USBDeviceDescriptor> &interfaces,
+                                             const QList<RadioInfo> &radios, QWidget *parent) :
   QDialog(parent), ui(new Ui::DeviceSelectionDialog), _interfaces(interfaces)
 {
   ui->setupUi(this);
 
-  // Populate combo box
-  foreach (USBDeviceDescriptor dev, _interfaces) {
-    ui->comboBox->addItem(dev.description());
+  // Populate combo box, add the radio name if the device has been identified already
+  for (int i=0; i<_interfaces.count(); i++) {
+    if ((i < radios.count()) && radios.at(i).isValid())
+      ui->comboBox->addItem(tr("%1 (%2)").arg(_interfaces.at(i).description()).arg(radios.at(i).name()));
+    else
+      ui->comboBox->addItem(_interfaces.at(i).description());
   }
   connect(ui->comboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(onDeviceSelected(int)));
 
@@ -3,6 +3,7 @@
 
 #include <QDialog>
 #include "usbdevice.hh"
+#include "radioinfo.hh"
 
 namespace Ui {
   class DeviceSelectionDialog;
@@ -13,7 +14,9 @@ class DeviceSelectionDialog : public QDialog
   Q_OBJECT
 
 public:
-  explicit DeviceSelectionDialog(const QList<USBDeviceDescriptor> &interfaces, QWidget *parent = nullptr);
+  explicit DeviceSelectionDialog(const QList<USBDeviceDescriptor> &interfaces,
+                                 const QList<RadioInfo> &radios = QList<RadioInfo>(),
+                                 QWidget *parent = nullptr);
   ~DeviceSelectionDialog();
 
   USBDeviceDescriptor device() const;
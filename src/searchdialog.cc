@@ -0,0 +1,90 @@
+#include "searchdialog.hh"
+#include <QVBoxLayout>
+#include <QLineEdit>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include "config.hh"
+#include "configsearchindex.hh"
+
+
+SearchDialog::SearchDialog(Config *config, ConfigSearchIndex *index, QWidget *parent)
+  : QDialog(parent), _config(config), _index(index)
+{
+  setWindowTitle(tr("Find in codeplug"));
+
+  _search = new QLineEdit();
+  _search->setPlaceholderText(tr("Name, frequency or DMR ID"));
+  _search->setClearButtonEnabled(true);
+  connect(_search, SIGNAL(textChanged(QString)), this, SLOT(refresh()));
+
+  _results = new QTreeWidget();
+  _results->setColumnCount(2);
+  _results->setHeaderLabels(QStringList() << tr("Name") << tr("Type"));
+  _results->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+  _results->header()->setStretchLastSection(false);
+  connect(_results, SIGNAL(itemActivated(QTreeWidgetItem*,int)),
+          this, SLOT(onItemActivated(QTreeWidgetItem*,int)));
+
+  // Results refer to the objects of the config, search again on any change
+  connect(_config, SIGNAL(modified(ConfigItem*)), this, SLOT(refresh()));
+
+  QVBoxLayout *layout = new QVBoxLayout();
+  layout->addWidget(_search);
+  layout->addWidget(_results);
+  setLayout(layout);
+  resize(400, 400);
+}
+
+void
+SearchDialog::refresh() {
+  _results->clear();
+  if (_search->text().isEmpty())
+    return;
+
+  foreach (ConfigObject *obj, _index->find(_search->text())) {
+    QTreeWidgetItem *item = createItem(obj);
+    QTreeWidgetItem *usedBy = nullptr;
+    foreach (ConfigObject *referrer, _index->referrers(obj)) {
+      if (nullptr == usedBy) {
+        usedBy = new QTreeWidgetItem(QStringList() << tr("Used by"));
+        usedBy->setFlags(Qt::ItemIsEnabled);
+        item->addChild(usedBy);
+      }
+      usedBy->addChild(createItem(referrer));
+    }
+    _results->addTopLevelItem(item);
+  }
+}
+
+void
+SearchDialog::onItemActivated(QTreeWidgetItem *item, int column) {
+  Q_UNUSED(column);
+  if (ConfigObject *obj = qobject_cast<ConfigObject *>(item->data(0, Qt::UserRole).value<QObject *>()))
+    emit jumpTo(obj);
+}
+
+QTreeWidgetItem *
+SearchDialog::createItem(ConfigObject *obj) const {
+  QString type;
+  AbstractConfigObjectList *list = _index->listOf(obj);
+  if (_config->radioIDs() == list)
+    type = tr("Radio ID");
+  else if (_config->contacts() == list)
+    type = tr("Contact");
+  else if (_config->rxGroupLists() == list)
+    type = tr("Group List");
+  else if (_config->channelList() == list)
+    type = tr("Channel");
+  else if (_config->zones() == list)
+    type = tr("Zone");
+  else if (_config->scanlists() == list)
+    type = tr("Scan List");
+  else if (_config->posSystems() == list)
+    type = tr("GPS/APRS");
+  else if (_config->roaming() == list)
+    type = tr("Roaming Zone");
+
+  QTreeWidgetItem *item = new QTreeWidgetItem(QStringList() << obj->name() << type);
+  item->setData(0, Qt::UserRole, QVariant::fromValue<QObject *>(obj));
+  return item;
+}
@@ -0,0 +1,52 @@
+#ifndef SEARCHDIALOG_HH
+#define SEARCHDIALOG_HH
+
+#include <QDialog>
+
+class QLineEdit;
+class QTreeWidget;
+class QTreeWidgetItem;
+class Config;
+class ConfigObject;
+class ConfigSearchIndex;
+
+/** Searches all objects of the codeplug, e.g., channels by frequency or contacts by DMR ID.
+ *
+ * Each match lists the objects using it (e.g., the channels and group lists using a contact).
+ * Activating any entry emits @c jumpTo() for the associated object. */
+class SearchDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  /** Constructs a search dialog for the given config and its search index. */
+  SearchDialog(Config *config, ConfigSearchIndex *index, QWidget *parent=nullptr);
+
+signals:
+  /** Gets emitted if the user activates an entry. */
+  void jumpTo(ConfigObject *obj);
+
+public slots:
+  /** Repeats the current search. */
+  void refresh();
+
+protected slots:
+  /** Gets called if an entry gets activated. */
+  void onItemActivated(QTreeWidgetItem *item, int column);
+
+protected:
+  /** Creates a result entry for the given object. */
+  QTreeWidgetItem *createItem(ConfigObject *obj) const;
+
+protected:
+  /** The indexed config. */
+  Config *_config;
+  /** The search index. */
+  ConfigSearchIndex *_index;
+  /** The query. */
+  QLineEdit *_search;
+  /** The search results. */
+  QTreeWidget *_results;
+};
+
+#endif // SEARCHDIALOG_HH
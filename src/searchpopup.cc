@@ -5,6 +5,9 @@
 #include <QToolButton>
 #include <QLabel>
 #include "logger.hh"
+#include "application.hh"
+#include "configitemwrapper.hh"
+#include "configsearchindex.hh"
 
 
 SearchPopup::SearchPopup(QAbstractItemView *parent)
@@ -77,18 +80,51 @@ SearchPopup::onSearchChanged(const QString &text) {
   _currentMatch = 0;
   itemView->selectionModel()->clear();
   _matches.clear();
-  for (int i=0; i<model->columnCount(); i++)
-    _matches.append(model->match(model->index(0,i), Qt::DisplayRole, text, -1,
-                                 Qt::MatchContains|Qt::MatchWrap));
-  std::sort(
-        _matches.begin(), _matches.end(),
-        [](const QModelIndex &a, const QModelIndex &b) {
-    if (a.row() < b.row())
-      return true;
-    if (a.row() > b.row())
-      return false;
-    return a.column() < b.column();
-  });
+
+  // Get wrapped config list (if there is one)
+  AbstractConfigObjectList *list = nullptr;
+  if (GenericTableWrapper *wrapper = qobject_cast<GenericTableWrapper *>(model))
+    list = wrapper->list();
+  else if (GenericListWrapper *wrapper = qobject_cast<GenericListWrapper *>(model))
+    list = wrapper->list();
+
+  Application *app = qobject_cast<Application *>(QApplication::instance());
+  if (app && app->searchIndex() && list && app->searchIndex()->indexes(list)) {
+    // Use codeplug-wide search index, it also covers the names of referenced objects shown in
+    // the views.
+    foreach (int row, app->searchIndex()->indices(text, list)) {
+      // Models may populate their rows lazily, populate them up to the matching row only
+      while ((row >= model->rowCount()) && model->canFetchMore(QModelIndex()))
+        model->fetchMore(QModelIndex());
+      if (row >= model->rowCount())
+        break;
+      // Select the first cell showing the query, if any
+      int column = 0;
+      for (int i=0; i<model->columnCount(); i++) {
+        if (model->index(row, i).data().toString().contains(text, Qt::CaseInsensitive)) {
+          column = i;
+          break;
+        }
+      }
+      _matches.append(model->index(row, column));
+    }
+  } else {
+    // Models may populate their rows lazily, search all of them
+    while (model->canFetchMore(QModelIndex()))
+      model->fetchMore(QModelIndex());
+    for (int i=0; i<model->columnCount(); i++)
+      _matches.append(model->match(model->index(0,i), Qt::DisplayRole, text, -1,
+                                   Qt::MatchContains|Qt::MatchWrap));
+    std::sort(
+          _matches.begin(), _matches.end(),
+          [](const QModelIndex &a, const QModelIndex &b) {
+      if (a.row() < b.row())
+        return true;
+      if (a.row() > b.row())
+        return false;
+      return a.column() < b.column();
+    });
+  }
 
   if (_matches.count()) {
     _label->setText(tr("%1/%2").arg(_currentMatch+1).arg(_matches.count()));
@@ -0,0 +1,179 @@
+#include "codeplugfieldtest.hh"
+#include "tyt_codeplug.hh"
+#include "utils.hh"
+#include <QTest>
+
+
+/** Exposes the generic, checked accessors of a codeplug element. */
+class RawElement: public Codeplug::Element
+{
+public:
+  RawElement(uint8_t *ptr, size_t size) : Codeplug::Element(ptr, size) { }
+
+  template <class Field>
+  typename Field::Type get() const { return getField<Field>(); }
+  template <class Field>
+  void set(const typename Field::Type &value) { setField<Field>(value); }
+};
+
+/** Fills the buffer with pseudo random bytes. The bytes within [bcdBegin, bcdEnd) are valid BCD
+ * digits. */
+static QByteArray
+randomBuffer(unsigned size, uint32_t seed, unsigned bcdBegin=0, unsigned bcdEnd=0) {
+  QByteArray buffer(size, 0);
+  for (unsigned i=0; i<size; i++) {
+    seed = seed*1103515245u + 12345u;
+    uint8_t byte = seed >> 16;
+    if ((i >= bcdBegin) && (i < bcdEnd))
+      byte = (((byte>>4) % 10) << 4) | ((byte & 0xf) % 10);
+    buffer[i] = char(byte);
+  }
+  return buffer;
+}
+
+
+CodeplugFieldTest::CodeplugFieldTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+CodeplugFieldTest::testTyTChannelDecode() {
+  for (uint32_t seed=1; seed<64; seed++) {
+    QByteArray buffer = randomBuffer(0x40, seed, 16, 24);
+    uint8_t *ptr = (uint8_t *)buffer.data();
+    TyTCodeplug::ChannelElement ch(ptr);
+    RawElement raw(ptr, 0x40);
+
+    QCOMPARE(unsigned(ch.mode()), unsigned(raw.getUInt2(0, 0)));
+    QCOMPARE(int(ch.bandwidth()), int((0 == raw.getUInt2(0, 2)) ? AnalogChannel::Bandwidth::Narrow
+                                                                : AnalogChannel::Bandwidth::Wide));
+    QCOMPARE(ch.autoScan(), raw.getBit(0, 4));
+    QCOMPARE(ch.loneWorker(), raw.getBit(0, 7));
+    QCOMPARE(ch.talkaround(), ! raw.getBit(1, 0));
+    QCOMPARE(ch.rxOnly(), raw.getBit(1, 1));
+    QCOMPARE(int(ch.timeSlot()), int((2 == raw.getUInt2(1, 2)) ? DigitalChannel::TimeSlot::TS2
+                                                               : DigitalChannel::TimeSlot::TS1));
+    QCOMPARE(ch.colorCode(), raw.getUInt4(1, 4));
+    QCOMPARE(ch.privacyIndex(), raw.getUInt4(2, 0));
+    QCOMPARE(unsigned(ch.privacyType()), unsigned(raw.getUInt2(2, 4)));
+    QCOMPARE(ch.privateCallConfirm(), raw.getBit(2, 6));
+    QCOMPARE(ch.dataCallConfirm(), raw.getBit(2, 7));
+    QCOMPARE(unsigned(ch.rxRefFrequency()), unsigned(raw.getUInt2(3, 0)));
+    QCOMPARE(ch.emergencyAlarmACK(), raw.getBit(3, 3));
+    QCOMPARE(ch.displayPTTId(), ! raw.getBit(3, 7));
+    QCOMPARE(unsigned(ch.txRefFrequency()), unsigned(raw.getUInt2(4, 0)));
+    QCOMPARE(ch.vox(), raw.getBit(4, 4));
+    QCOMPARE(unsigned(ch.admitCriterion()), unsigned(raw.getUInt2(4, 6)));
+    QCOMPARE(ch.contactIndex(), raw.getUInt16_le(6));
+    QCOMPARE(ch.txTimeOut(), unsigned(raw.getUInt6(8, 0))*15);
+    QCOMPARE(ch.txTimeOutRekeyDelay(), raw.getUInt8(9));
+    QCOMPARE(ch.emergencySystemIndex(), raw.getUInt8(10));
+    QCOMPARE(ch.scanListIndex(), raw.getUInt8(11));
+    QCOMPARE(ch.groupListIndex(), raw.getUInt8(12));
+    QCOMPARE(ch.positioningSystemIndex(), raw.getUInt8(13));
+    QCOMPARE(ch.rxFrequency(), raw.getBCD8_le(16)*10);
+    QCOMPARE(ch.txFrequency(), raw.getBCD8_le(20)*10);
+    QCOMPARE(int(ch.rxSignaling()), int(decode_ctcss_tone_table(raw.getUInt16_le(24))));
+    QCOMPARE(int(ch.txSignaling()), int(decode_ctcss_tone_table(raw.getUInt16_le(26))));
+    QCOMPARE(ch.rxSignalingSystemIndex(), raw.getUInt8(28));
+    QCOMPARE(ch.txSignalingSystemIndex(), raw.getUInt8(29));
+    QCOMPARE(ch.txGPSInfo(), ! raw.getBit(31, 0));
+    QCOMPARE(ch.rxGPSInfo(), ! raw.getBit(31, 1));
+    QCOMPARE(ch.name(), raw.readUnicode(32, 16, 0x0000));
+  }
+}
+
+void
+CodeplugFieldTest::testTyTChannelEncode() {
+  for (uint32_t seed=1; seed<64; seed++) {
+    QByteArray initial = randomBuffer(0x40, seed, 16, 24);
+    QByteArray fields = initial, reference = initial;
+    TyTCodeplug::ChannelElement ch((uint8_t *)fields.data());
+    RawElement raw((uint8_t *)reference.data(), 0x40);
+
+    bool flag = (seed & 1);
+    ch.enableAutoScan(flag);         raw.setBit(0, 4, flag);
+    ch.enableLoneWorker(!flag);      raw.setBit(0, 7, !flag);
+    ch.enableTalkaround(flag);       raw.setBit(1, 0, !flag);
+    ch.enableRXOnly(flag);           raw.setBit(1, 1, flag);
+    ch.enablePrivateCallConfirm(flag); raw.setBit(2, 6, flag);
+    ch.enableDataCallConfirm(!flag); raw.setBit(2, 7, !flag);
+    ch.enableEmergencyAlarmACK(flag); raw.setBit(3, 3, flag);
+    ch.enableDisplayPTTId(flag);     raw.setBit(3, 7, !flag);
+    ch.enableVOX(!flag);             raw.setBit(4, 4, !flag);
+    ch.enableTXGPSInfo(flag);        raw.setBit(31, 0, !flag);
+    ch.enableRXGPSInfo(!flag);       raw.setBit(31, 1, flag);
+    QCOMPARE(fields, reference);
+
+    ch.setBandwidth(AnalogChannel::Bandwidth::Narrow); raw.setUInt2(0, 2, 0);
+    ch.setTimeSlot(DigitalChannel::TimeSlot::TS2);     raw.setUInt2(1, 2, 2);
+    ch.setColorCode(seed % 16);      raw.setUInt4(1, 4, seed % 16);
+    ch.setPrivacyIndex(seed % 16);   raw.setUInt4(2, 0, seed % 16);
+    ch.setContactIndex(seed*1000);   raw.setUInt16_le(6, seed*1000);
+    ch.setTXTimeOut(seed*15);        raw.setUInt6(8, 0, seed);
+    ch.setTXTimeOutRekeyDelay(seed); raw.setUInt8(9, seed);
+    ch.setScanListIndex(seed+1);     raw.setUInt8(11, seed+1);
+    ch.setGroupListIndex(seed+2);    raw.setUInt8(12, seed+2);
+    ch.setPositioningSystemIndex(seed+3); raw.setUInt8(13, seed+3);
+    ch.setRXFrequency(439562500+seed*10); raw.setBCD8_le(16, 43956250+seed);
+    ch.setTXFrequency(431962500+seed*10); raw.setBCD8_le(20, 43196250+seed);
+    ch.setRXSignalingSystemIndex(seed);   raw.setUInt8(28, seed);
+    ch.setTXSignalingSystemIndex(seed+1); raw.setUInt8(29, seed+1);
+    QCOMPARE(fields, reference);
+
+    // Names of all lengths, including truncation at 16 chars
+    QString name = QString("Channel %1 abcdefghijklmnop").arg(seed).left(seed % 20);
+    ch.setName(name); raw.writeUnicode(32, name, 16, 0x0000);
+    QCOMPARE(fields, reference);
+  }
+}
+
+void
+CodeplugFieldTest::testTyTContact() {
+  for (uint32_t seed=1; seed<64; seed++) {
+    QByteArray initial = randomBuffer(0x24, seed);
+    QByteArray fields = initial, reference = initial;
+    TyTCodeplug::ContactElement contact((uint8_t *)fields.data());
+    RawElement raw((uint8_t *)reference.data(), 0x24);
+
+    QCOMPARE(contact.dmrId(), raw.getUInt24_le(0));
+    QCOMPARE(contact.ringTone(), raw.getBit(3, 5));
+    QCOMPARE(contact.name(), raw.readUnicode(4, 16, 0x0000));
+
+    contact.setDMRId(seed*12345);    raw.setUInt24_le(0, seed*12345);
+    contact.enableRingTone(seed & 1); raw.setBit(3, 5, seed & 1);
+    contact.setCallType(DigitalContact::PrivateCall); raw.setUInt2(3, 0, 2);
+    contact.setName(QString("Contact %1").arg(seed)); raw.writeUnicode(4, QString("Contact %1").arg(seed), 16, 0x0000);
+    QCOMPARE(fields, reference);
+  }
+}
+
+void
+CodeplugFieldTest::testOverflow() {
+  typedef CodeplugLayout<0x40> Layout;
+  typedef Layout::UInt<0x0c, 4> Inside;
+  typedef Layout::UInt<0x0e, 4> Crossing;
+  typedef Layout::Flag<0x10, 0, true> InvertedOutside;
+  typedef Layout::Flag<0x20, 0> Outside;
+  typedef Layout::Unicode<0x08, 16> UnicodeCrossing;
+  typedef Layout::ASCII<0x08, 16> ASCIICrossing;
+  QByteArray initial = randomBuffer(0x40, 42);
+  QByteArray buffer = initial;
+  // Element is smaller than the layout
+  RawElement raw((uint8_t *)buffer.data(), 0x10);
+
+  // Fields within the element are accessible
+  QCOMPARE(raw.get<Inside>(), raw.getUInt32_le(0x0c));
+  // Fields past the element are neither read nor written
+  QCOMPARE(raw.get<Crossing>(), 0U);
+  QCOMPARE(raw.get<InvertedOutside>(), false);
+  QCOMPARE(raw.get<UnicodeCrossing>(), QString());
+  raw.set<Crossing>(0);
+  raw.set<Outside>(true);
+  raw.set<ASCIICrossing>("abcdefghijklmnop");
+  QCOMPARE(buffer, initial);
+}
+
+
+QTEST_GUILESS_MAIN(CodeplugFieldTest)
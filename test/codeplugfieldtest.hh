@@ -0,0 +1,20 @@
+#ifndef CODEPLUGFIELDTEST_HH
+#define CODEPLUGFIELDTEST_HH
+
+#include <QObject>
+
+class CodeplugFieldTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit CodeplugFieldTest(QObject *parent = nullptr);
+
+private slots:
+  void testTyTChannelDecode();
+  void testTyTChannelEncode();
+  void testTyTContact();
+  void testOverflow();
+};
+
+#endif // CODEPLUGFIELDTEST_HH
@@ -0,0 +1,100 @@
+#include "configsearchindextest.hh"
+#include "configsearchindex.hh"
+#include <QTest>
+
+
+ConfigSearchIndexTest::ConfigSearchIndexTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+ConfigSearchIndexTest::initTestCase() {
+  // Read simple configuration file
+  QString errMessage;
+  QVERIFY(_config.readCSV("://testconfig.conf", errMessage));
+}
+
+void
+ConfigSearchIndexTest::cleanupTestCase() {
+  // clear codeplug
+  _config.reset();
+}
+
+void
+ConfigSearchIndexTest::testFind() {
+  ConfigSearchIndex index(&_config);
+
+  // Names, case insensitive
+  QList<ConfigObject *> found = index.find("db0lds");
+  QCOMPARE(found.count(), 2);
+  QCOMPARE(found.at(0)->name(), QString("BB DB0LDS TS2"));
+  QCOMPARE(found.at(1)->name(), QString("DB0LDS"));
+  // Frequencies
+  found = index.find("439.5630");
+  QCOMPARE(found.count(), 1);
+  QCOMPARE(found.at(0)->name(), QString("BB DB0LDS TS2"));
+  // DMR IDs
+  found = index.find("2621", _config.contacts());
+  QCOMPARE(found.count(), 1);
+  QCOMPARE(found.at(0)->name(), QString("Bln/Brb"));
+  // Short queries
+  QCOMPARE(index.indices("kw", _config.zones()), QList<int>({0}));
+  // No match
+  QVERIFY(index.find("xyzzy").isEmpty());
+}
+
+void
+ConfigSearchIndexTest::testReferencedNames() {
+  Config config;
+  QString errMessage;
+  QVERIFY(config.readCSV("://testconfig.conf", errMessage));
+  ConfigSearchIndex index(&config);
+
+  // Channels are found by the name of their TX contact
+  QCOMPARE(index.indices("bln/brb", config.channelList()), QList<int>({0, 1}));
+
+  // Renaming the contact updates the channels referencing it
+  config.contacts()->contact(1)->setName("Xyzzy");
+  QCOMPARE(index.indices("bln/brb", config.channelList()), QList<int>());
+  QCOMPARE(index.indices("xyzzy", config.channelList()), QList<int>({0, 1}));
+}
+
+void
+ConfigSearchIndexTest::testReferrers() {
+  ConfigSearchIndex index(&_config);
+
+  // Contact used by a channel and a group list
+  QList<ConfigObject *> users = index.referrers(_config.contacts()->contact(0));
+  QCOMPARE(users.count(), 2);
+  QVERIFY(users.contains(_config.channelList()->channel(2)));
+  QVERIFY(users.contains(_config.rxGroupLists()->list(0)));
+
+  // Channel member of a zone
+  users = index.referrers(_config.channelList()->channel(0));
+  QCOMPARE(users.count(), 1);
+  QCOMPARE(users.at(0), static_cast<ConfigObject *>(_config.zones()->zone(0)));
+
+  QCOMPARE(index.listOf(_config.zones()->zone(0)), static_cast<AbstractConfigObjectList *>(_config.zones()));
+}
+
+void
+ConfigSearchIndexTest::testRemove() {
+  Config config;
+  QString errMessage;
+  QVERIFY(config.readCSV("://testconfig.conf", errMessage));
+  ConfigSearchIndex index(&config);
+  QCOMPARE(index.find("db0lds").count(), 2);
+
+  ConfigObject *removed = config.channelList()->get(0);
+  QVERIFY(config.channelList()->del(removed));
+  QList<ConfigObject *> found = index.find("db0lds");
+  QCOMPARE(found.count(), 1);
+  QCOMPARE(found.at(0)->name(), QString("DB0LDS"));
+
+  // Only the remaining channel using the contact is found
+  QCOMPARE(index.indices("bln/brb", config.channelList()), QList<int>({0}));
+}
+
+
+QTEST_GUILESS_MAIN(ConfigSearchIndexTest)
@@ -0,0 +1,28 @@
+#ifndef CONFIGSEARCHINDEXTEST_HH
+#define CONFIGSEARCHINDEXTEST_HH
+
+#include <QObject>
+#include "config.hh"
+
+
+class ConfigSearchIndexTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ConfigSearchIndexTest(QObject *parent = nullptr);
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void testFind();
+  void testReferencedNames();
+  void testReferrers();
+  void testRemove();
+
+protected:
+  Config _config;
+};
+
+#endif // CONFIGSEARCHINDEXTEST_HH
@@ -0,0 +1,124 @@
+#include "configsnapshottest.hh"
+#include "configsnapshot.hh"
+#include "config.hh"
+#include <QTest>
+
+
+ConfigSnapshotTest::ConfigSnapshotTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+ConfigSnapshotTest::initTestCase() {
+  // Read simple configuration file
+  QString errMessage;
+  QVERIFY(_config.readCSV("://testconfig.conf", errMessage));
+
+  // Add some state not accessible through properties
+  _config.channelList()->channel(0)->setDefaultPower();
+  AnalogChannel *analog = _config.channelList()->channel(3)->as<AnalogChannel>();
+  QVERIFY(nullptr != analog);
+  _config.posSystems()->add(new APRSSystem("APRS", analog, "WIDE3", 3, "DM3MAT", 7, "WIDE1-1"));
+  _config.radioIDs()->add(new DMRRadioID("Second", 7654321));
+  QVERIFY(_config.radioIDs()->setDefaultId(1));
+
+  // Take and restore snapshot
+  ErrorStack err; QByteArray data;
+  if (! ConfigSnapshot::save(&_config, data, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  QVERIFY(ConfigSnapshot::isSnapshot(data));
+  if (! ConfigSnapshot::load(&_restored, data, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+}
+
+void
+ConfigSnapshotTest::cleanupTestCase() {
+  _config.reset();
+  _restored.reset();
+}
+
+void
+ConfigSnapshotTest::testRoundTrip() {
+  QString original, restored;
+  QTextStream originalStream(&original), restoredStream(&restored);
+  QVERIFY(_config.toYAML(originalStream));
+  QVERIFY(_restored.toYAML(restoredStream));
+  originalStream.flush(); restoredStream.flush();
+  QCOMPARE(restored, original);
+}
+
+void
+ConfigSnapshotTest::testReferences() {
+  QCOMPARE(_restored.channelList()->count(), _config.channelList()->count());
+  QCOMPARE(_restored.contacts()->count(), _config.contacts()->count());
+
+  // References must point to the restored objects
+  DigitalChannel *digi = _restored.channelList()->channel(0)->as<DigitalChannel>();
+  QVERIFY(nullptr != digi);
+  QVERIFY(nullptr != digi->txContactObj());
+  QCOMPARE(digi->txContactObj()->name(), QString("Bln/Brb"));
+  QCOMPARE(_restored.contacts()->indexOf(digi->txContactObj()), 1);
+  QVERIFY(nullptr != digi->groupListObj());
+  QCOMPARE(_restored.rxGroupLists()->indexOf(digi->groupListObj()), 0);
+  QVERIFY(nullptr != digi->aprsObj());
+  QCOMPARE(_restored.posSystems()->indexOf(digi->aprsObj()), 0);
+
+  // Reference lists
+  Zone *zone = _restored.zones()->get(0)->as<Zone>();
+  QCOMPARE(zone->A()->count(), 3);
+  QCOMPARE(zone->B()->count(), 2);
+  QCOMPARE(_restored.channelList()->indexOf(zone->A()->get(2)), 4);
+  QCOMPARE(_restored.channelList()->indexOf(zone->B()->get(0)), 1);
+  RXGroupList *list = _restored.rxGroupLists()->get(0)->as<RXGroupList>();
+  QCOMPARE(list->contacts()->count(), 2);
+  QCOMPARE(_restored.contacts()->indexOf(list->contacts()->get(1)), 1);
+}
+
+void
+ConfigSnapshotTest::testExtraRecords() {
+  // Default power of channels
+  QCOMPARE(_restored.channelList()->channel(0)->defaultPower(), true);
+  QCOMPARE(_restored.channelList()->channel(1)->defaultPower(), false);
+
+  // Sub tones of analog channels
+  AnalogChannel *orig = _config.channelList()->channel(3)->as<AnalogChannel>();
+  AnalogChannel *analog = _restored.channelList()->channel(3)->as<AnalogChannel>();
+  QVERIFY(nullptr != analog);
+  QCOMPARE(analog->rxTone(), orig->rxTone());
+  QCOMPARE(analog->txTone(), orig->txTone());
+
+  // APRS settings
+  APRSSystem *aprs = _restored.posSystems()->get(1)->as<APRSSystem>();
+  QVERIFY(nullptr != aprs);
+  QCOMPARE(aprs->destination(), QString("WIDE3"));
+  QCOMPARE(aprs->destSSID(), 3U);
+  QCOMPARE(aprs->source(), QString("DM3MAT"));
+  QCOMPARE(aprs->srcSSID(), 7U);
+  QCOMPARE(aprs->path(), QString("WIDE1-1"));
+  QCOMPARE(_restored.channelList()->indexOf(aprs->revertChannel()), 3);
+
+  // Default radio ID
+  QVERIFY(nullptr != _restored.radioIDs()->defaultId());
+  QCOMPARE(_restored.radioIDs()->indexOf(_restored.radioIDs()->defaultId()), 1);
+  QCOMPARE(_restored.radioIDs()->defaultId()->number(), 7654321U);
+}
+
+void
+ConfigSnapshotTest::testInvalid() {
+  QByteArray data;
+  QVERIFY(ConfigSnapshot::save(&_config, data));
+
+  // Wrong magic
+  QByteArray corrupt = data;
+  corrupt[0] = corrupt[0] ^ 0xff;
+  QVERIFY(! ConfigSnapshot::isSnapshot(corrupt));
+  Config config;
+  QVERIFY(! ConfigSnapshot::load(&config, corrupt));
+
+  // Truncated snapshot
+  QVERIFY(! ConfigSnapshot::load(&config, data.left(data.size()/2)));
+}
+
+
+QTEST_GUILESS_MAIN(ConfigSnapshotTest)
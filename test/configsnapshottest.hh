@@ -0,0 +1,29 @@
+#ifndef CONFIGSNAPSHOTTEST_HH
+#define CONFIGSNAPSHOTTEST_HH
+
+#include <QObject>
+#include "config.hh"
+
+
+class ConfigSnapshotTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ConfigSnapshotTest(QObject *parent = nullptr);
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void testRoundTrip();
+  void testReferences();
+  void testExtraRecords();
+  void testInvalid();
+
+protected:
+  Config _config;
+  Config _restored;
+};
+
+#endif // CONFIGSNAPSHOTTEST_HH
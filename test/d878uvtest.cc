@@ -0,0 +1,78 @@
+#include "d878uvtest.hh"
+#include "config.hh"
+#include <QTest>
+#include <QSignalSpy>
+#include <QCoreApplication>
+
+D878UVTest::D878UVTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+D878UVTest::initTestCase() {
+  // Read simple configuration file
+  QString errMessage;
+  QVERIFY(_config.readCSV("://testconfig.conf", errMessage));
+  // Encode config as code-plug
+  _codeplug.setBitmaps(&_config);
+  _codeplug.allocateUpdated();
+  _codeplug.allocateForEncoding();
+  ErrorStack err;
+  if (! _codeplug.encode(&_config, Codeplug::Flags(), err))
+    QFAIL(err.format().toLocal8Bit().constData());
+}
+
+void
+D878UVTest::cleanupTestCase() {
+  // clear codeplug
+  _codeplug.clear();
+}
+
+void
+D878UVTest::testDecode() {
+  Config decoded;
+  ErrorStack err;
+  if (! _codeplug.decode(&decoded, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+
+  // Channels get linked concurrently, check references
+  QCOMPARE(decoded.channelList()->count(), _config.channelList()->count());
+  for (int i=0; i<_config.channelList()->count(); i++) {
+    Channel *expected = _config.channelList()->channel(i), *channel = decoded.channelList()->channel(i);
+    QCOMPARE(channel->name(), expected->name());
+    QCOMPARE(channel->thread(), QThread::currentThread());
+    if (DigitalChannel *dc = expected->as<DigitalChannel>()) {
+      DigitalChannel *ddc = channel->as<DigitalChannel>();
+      QVERIFY(nullptr != ddc);
+      QCOMPARE(ddc->contact()->thread(), QThread::currentThread());
+      if (dc->txContactObj())
+        QCOMPARE(ddc->txContactObj()->name(), dc->txContactObj()->name());
+      if (dc->groupListObj())
+        QCOMPARE(ddc->groupListObj()->name(), dc->groupListObj()->name());
+    }
+  }
+}
+
+void
+D878UVTest::testDecodeSignals() {
+  Config decoded;
+  QSignalSpy modified(decoded.channelList(), SIGNAL(elementModified(int)));
+  QSignalSpy reset(decoded.channelList(), SIGNAL(elementsReset()));
+
+  ErrorStack err;
+  if (! _codeplug.decode(&decoded, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  // Like the application does after reading a codeplug
+  decoded.setModified(false);
+
+  // No signals of the concurrent decoding must be pending
+  QCoreApplication::sendPostedEvents();
+  QCoreApplication::processEvents();
+  QVERIFY(! decoded.isModified());
+  QCOMPARE(modified.count(), 0);
+  QCOMPARE(reset.count(), 1);
+}
+
+
+QTEST_GUILESS_MAIN(D878UVTest)
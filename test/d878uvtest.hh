@@ -0,0 +1,29 @@
+#ifndef D878UVTEST_HH
+#define D878UVTEST_HH
+
+#include "config.hh"
+#include "d878uv_codeplug.hh"
+
+#include <QObject>
+
+
+class D878UVTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit D878UVTest(QObject *parent = nullptr);
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void testDecode();
+  void testDecodeSignals();
+
+protected:
+  Config _config;
+  D878UVCodeplug _codeplug;
+};
+
+#endif // D878UVTEST_HH
@@ -0,0 +1,114 @@
+#include "databasefetchertest.hh"
+#include "databasefetcher.hh"
+#include <QTest>
+#include <QSignalSpy>
+#include <QTcpSocket>
+#include <QFile>
+
+static const QByteArray body = "{\"users\":[{\"radio_id\":1234567,\"callsign\":\"DM3MAT\"}]}";
+
+static QByteArray
+response(int status, const QString &reason, const QByteArray &content=QByteArray()) {
+  return QString("HTTP/1.1 %1 %2\r\nETag: \"v1\"\r\nContent-Length: %3\r\nConnection: close\r\n\r\n")
+      .arg(status).arg(reason).arg(content.size()).toLatin1() + content;
+}
+
+static QByteArray
+readFile(const QString &filename) {
+  QFile file(filename);
+  if (! file.open(QIODevice::ReadOnly))
+    return QByteArray();
+  return file.readAll();
+}
+
+
+DatabaseFetcherTest::DatabaseFetcherTest(QObject *parent)
+  : QObject(parent), _server(), _response(), _request(), _directory()
+{
+  // pass...
+}
+
+void
+DatabaseFetcherTest::initTestCase() {
+  QVERIFY(_directory.isValid());
+  QVERIFY(_server.listen(QHostAddress::LocalHost));
+  // Answers every request with the current response once the header is complete
+  connect(&_server, &QTcpServer::newConnection, [this]() {
+    QTcpSocket *socket = _server.nextPendingConnection();
+    connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+    connect(socket, &QTcpSocket::readyRead, [this, socket]() {
+      QByteArray request = socket->property("request").toByteArray() + socket->readAll();
+      socket->setProperty("request", request);
+      if (! request.contains("\r\n\r\n"))
+        return;
+      _request = request;
+      socket->write(_response);
+      socket->disconnectFromHost();
+    });
+  });
+}
+
+void
+DatabaseFetcherTest::testDownload() {
+  QString filename = _directory.filePath("user.json");
+  DatabaseFetcher fetcher(QUrl(QString("http://127.0.0.1:%1/users.json").arg(_server.serverPort())),
+                          filename);
+  QSignalSpy updated(&fetcher, SIGNAL(updated()));
+  _response = response(200, "OK", body);
+  fetcher.fetch();
+  QVERIFY(updated.wait(5000));
+  QVERIFY(! _request.contains("If-None-Match"));
+  QCOMPARE(readFile(filename), body);
+  QCOMPARE(fetcher.age(), 0U);
+}
+
+void
+DatabaseFetcherTest::testNotModified() {
+  QString filename = _directory.filePath("user.json");
+  DatabaseFetcher fetcher(QUrl(QString("http://127.0.0.1:%1/users.json").arg(_server.serverPort())),
+                          filename);
+  QSignalSpy unchanged(&fetcher, SIGNAL(unchanged()));
+  QSignalSpy updated(&fetcher, SIGNAL(updated()));
+  _response = response(304, "Not Modified");
+  fetcher.fetch();
+  QVERIFY(unchanged.wait(5000));
+  QCOMPARE(updated.count(), 0);
+  // The validators of the last download are sent
+  QVERIFY(_request.contains("If-None-Match: \"v1\""));
+  QCOMPARE(readFile(filename), body);
+}
+
+void
+DatabaseFetcherTest::testUnconditional() {
+  QString filename = _directory.filePath("user.json");
+  DatabaseFetcher fetcher(QUrl(QString("http://127.0.0.1:%1/users.json").arg(_server.serverPort())),
+                          filename);
+  QSignalSpy updated(&fetcher, SIGNAL(updated()));
+  QByteArray newBody = body; newBody.replace("1234567", "7654321");
+  _response = response(200, "OK", newBody);
+  fetcher.fetch(false);
+  QVERIFY(updated.wait(5000));
+  QVERIFY(! _request.contains("If-None-Match"));
+  QVERIFY(! _request.contains("If-Modified-Since"));
+  QCOMPARE(readFile(filename), newBody);
+}
+
+void
+DatabaseFetcherTest::testError() {
+  QString filename = _directory.filePath("user.json");
+  QByteArray local = readFile(filename);
+  DatabaseFetcher fetcher(QUrl(QString("http://127.0.0.1:%1/users.json").arg(_server.serverPort())),
+                          filename);
+  QSignalSpy error(&fetcher, SIGNAL(error(QString)));
+  QSignalSpy updated(&fetcher, SIGNAL(updated()));
+  _response = response(500, "Internal Server Error", "failed");
+  fetcher.fetch();
+  QVERIFY(error.wait(5000));
+  QCOMPARE(updated.count(), 0);
+  QVERIFY(! fetcher.isRunning());
+  // Local copy is kept
+  QCOMPARE(readFile(filename), local);
+}
+
+
+QTEST_GUILESS_MAIN(DatabaseFetcherTest)
@@ -0,0 +1,34 @@
+#ifndef DATABASEFETCHERTEST_HH
+#define DATABASEFETCHERTEST_HH
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTemporaryDir>
+
+class DatabaseFetcherTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit DatabaseFetcherTest(QObject *parent = nullptr);
+
+private slots:
+  void initTestCase();
+
+  void testDownload();
+  void testNotModified();
+  void testUnconditional();
+  void testError();
+
+protected:
+  /** Local HTTP server standing in for the remote database. */
+  QTcpServer _server;
+  /** Response sent for the next request. */
+  QByteArray _response;
+  /** Header of the last request received. */
+  QByteArray _request;
+  /** Holds the local copy of the database. */
+  QTemporaryDir _directory;
+};
+
+#endif // DATABASEFETCHERTEST_HH
@@ -0,0 +1,82 @@
+#include "tablewrappertest.hh"
+#include "config.hh"
+#include "configitemwrapper.hh"
+#include <QTest>
+
+
+TableWrapperTest::TableWrapperTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+TableWrapperTest::testInsertMiddle() {
+  Config config;
+  for (int i=0; i<3; i++)
+    config.contacts()->add(new DigitalContact(DigitalContact::GroupCall, QString("TG%1").arg(i), i+1));
+
+  ContactListWrapper model(config.contacts());
+  QCOMPARE(model.rowCount(QModelIndex()), 3);
+  // format all rows, such that the cache is populated
+  for (int i=0; i<3; i++)
+    QCOMPARE(model.data(model.index(i,1)).toString(), QString("TG%1").arg(i));
+
+  // insert in the middle
+  config.contacts()->add(new DigitalContact(DigitalContact::GroupCall, "new", 99), 1);
+  QCOMPARE(model.rowCount(QModelIndex()), 4);
+  QCOMPARE(model.canFetchMore(QModelIndex()), false);
+  QCOMPARE(model.data(model.index(0,1)).toString(), QString("TG0"));
+  QCOMPARE(model.data(model.index(1,1)).toString(), QString("new"));
+  QCOMPARE(model.data(model.index(2,1)).toString(), QString("TG1"));
+  QCOMPARE(model.data(model.index(3,1)).toString(), QString("TG2"));
+
+  // append at the end
+  config.contacts()->add(new DigitalContact(DigitalContact::GroupCall, "last", 100));
+  QCOMPARE(model.rowCount(QModelIndex()), 5);
+  QCOMPARE(model.data(model.index(4,1)).toString(), QString("last"));
+}
+
+void
+TableWrapperTest::testInsertBeyondLoaded() {
+  Config config;
+  for (int i=0; i<1000; i++)
+    config.contacts()->add(new DigitalContact(DigitalContact::GroupCall, QString("TG%1").arg(i), i+1));
+
+  ContactListWrapper model(config.contacts());
+  int loaded = model.rowCount(QModelIndex());
+  QVERIFY(loaded < 1000);
+  QVERIFY(model.canFetchMore(QModelIndex()));
+
+  // insert beyond the populated rows, must not change the row count
+  config.contacts()->add(new DigitalContact(DigitalContact::GroupCall, "beyond", 2000), loaded+10);
+  QCOMPARE(model.rowCount(QModelIndex()), loaded);
+
+  // insert in the middle of the populated rows
+  config.contacts()->add(new DigitalContact(DigitalContact::GroupCall, "middle", 2001), loaded/2);
+  QCOMPARE(model.rowCount(QModelIndex()), loaded+1);
+  QCOMPARE(model.data(model.index(loaded/2,1)).toString(), QString("middle"));
+  QCOMPARE(model.data(model.index(loaded,1)).toString(), QString("TG%1").arg(loaded-1));
+
+  // populate all rows
+  while (model.canFetchMore(QModelIndex()))
+    model.fetchMore(QModelIndex());
+  QCOMPARE(model.rowCount(QModelIndex()), config.contacts()->count());
+  QCOMPARE(model.data(model.index(loaded+11,1)).toString(), QString("beyond"));
+  QCOMPARE(model.data(model.index(config.contacts()->count()-1,1)).toString(), QString("TG999"));
+}
+
+void
+TableWrapperTest::testRemove() {
+  Config config;
+  for (int i=0; i<3; i++)
+    config.contacts()->add(new DigitalContact(DigitalContact::GroupCall, QString("TG%1").arg(i), i+1));
+
+  ContactListWrapper model(config.contacts());
+  QCOMPARE(model.data(model.index(1,1)).toString(), QString("TG1"));
+  config.contacts()->del(config.contacts()->get(1));
+  QCOMPARE(model.rowCount(QModelIndex()), 2);
+  QCOMPARE(model.data(model.index(1,1)).toString(), QString("TG2"));
+}
+
+
+QTEST_GUILESS_MAIN(TableWrapperTest)
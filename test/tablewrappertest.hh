@@ -0,0 +1,19 @@
+#ifndef TABLEWRAPPERTEST_HH
+#define TABLEWRAPPERTEST_HH
+
+#include <QObject>
+
+class TableWrapperTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit TableWrapperTest(QObject *parent = nullptr);
+
+private slots:
+  void testInsertMiddle();
+  void testInsertBeyondLoaded();
+  void testRemove();
+};
+
+#endif // TABLEWRAPPERTEST_HH
@@ -0,0 +1,140 @@
+#include "userdatabasetest.hh"
+#include "userdatabase.hh"
+#include <QTest>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+static const QByteArray document =
+    "{\"count\": 3, \"users\": [\n"
+    "  {\"fname\": \"Hannes \\\"H\\u00e4nsel\\\"\", \"callsign\": \"DM3MAT\", \"id\": 2621370,"
+    " \"city\": \"Berlin\\\\Mitte\", \"country\": \"Germany\", \"remarks\": \"a}b]c{\"},\n"
+    "  {\"id\": 1234567, \"callsign\": \"W1AW\", \"fname\": \"Hiram\", \"surname\": \"Maxim\","
+    " \"state\": \"Connecticut\", \"country\": \"United States\", \"extra\": [1, {\"x\": 2}]},\n"
+    "  {\"id\": 3141592, \"callsign\": \"F4\xc3\xa4\xc3\xb6\", \"fname\": \"\\ud83d\\udce1 Unicode\"}\n"
+    "], \"timestamp\": \"2024-01-01\"}";
+
+/** Feeds the document split at the given offsets and checks the result against QJsonDocument. */
+static void
+verifySplit(const QList<int> &offsets) {
+  UserDatabase::Reader reader;
+  int start = 0;
+  foreach (int offset, offsets) {
+    QVERIFY(reader.feed(document.mid(start, offset-start)));
+    start = offset;
+  }
+  QVERIFY(reader.feed(document.mid(start)));
+  if (! reader.finish())
+    QFAIL(reader.errorMessage().toLocal8Bit().constData());
+
+  QJsonArray expected = QJsonDocument::fromJson(document).object().value("users").toArray();
+  UserDatabase::Table users = reader.takeUsers();
+  QCOMPARE(users.count(), expected.count());
+  for (int i=0; i<users.count(); i++) {
+    UserDatabase::User ref(expected.at(i).toObject()), user = users.at(i);
+    QCOMPARE(user.id, ref.id);
+    QCOMPARE(user.call, ref.call);
+    QCOMPARE(user.name, ref.name);
+    QCOMPARE(user.surname, ref.surname);
+    QCOMPARE(user.city, ref.city);
+    QCOMPARE(user.state, ref.state);
+    QCOMPARE(user.country, ref.country);
+    QCOMPARE(user.comment, ref.comment);
+  }
+}
+
+
+UserDatabaseTest::UserDatabaseTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+UserDatabaseTest::testSingleChunk() {
+  QVERIFY(QJsonDocument::fromJson(document).isObject());
+  verifySplit({});
+}
+
+void
+UserDatabaseTest::testSplitString() {
+  int offset = document.indexOf("DM3MAT");
+  QVERIFY(0 < offset);
+  verifySplit({offset+3});
+  // Within a key
+  offset = document.indexOf("callsign");
+  verifySplit({offset+4});
+  // Within a multi-byte UTF-8 sequence
+  offset = document.indexOf("\xc3\xa4");
+  verifySplit({offset+1});
+}
+
+void
+UserDatabaseTest::testSplitEscape() {
+  int offset = document.indexOf("\\\"H");
+  QVERIFY(0 < offset);
+  verifySplit({offset+1});
+  offset = document.indexOf("\\\\Mitte");
+  verifySplit({offset+1});
+  offset = document.indexOf("\\u00e4");
+  verifySplit({offset+1});
+  verifySplit({offset+3});
+  offset = document.indexOf("\\udce1");
+  verifySplit({offset-1, offset+2});
+}
+
+void
+UserDatabaseTest::testSplitNumber() {
+  int offset = document.indexOf("2621370");
+  QVERIFY(0 < offset);
+  verifySplit({offset+3});
+  verifySplit({offset+1, offset+2, offset+6});
+  offset = document.indexOf("1234567");
+  verifySplit({offset+7});
+}
+
+void
+UserDatabaseTest::testEverySplit() {
+  for (int i=1; i<document.size(); i++)
+    verifySplit({i});
+  // Byte by byte
+  QList<int> offsets;
+  for (int i=1; i<document.size(); i++)
+    offsets.append(i);
+  verifySplit(offsets);
+}
+
+void
+UserDatabaseTest::testMissingUsers() {
+  UserDatabase::Reader reader;
+  QVERIFY(reader.feed(QByteArray("{\"count\": 0, \"timestamp\": \"2024-01-01\"}")));
+  QVERIFY(! reader.finish());
+  QCOMPARE(reader.errorMessage(), QString("JSON object does not contain 'users' item."));
+
+  // A nested "users" key does not count
+  reader.reset();
+  QVERIFY(reader.feed(QByteArray("{\"meta\": {\"users\": []}}")));
+  QVERIFY(! reader.finish());
+  QCOMPARE(reader.errorMessage(), QString("JSON object does not contain 'users' item."));
+}
+
+void
+UserDatabaseTest::testUsersNotArray() {
+  UserDatabase::Reader reader;
+  QVERIFY(reader.feed(QByteArray("{\"users\": {\"id\": 2621370}}")));
+  QVERIFY(! reader.finish());
+  QCOMPARE(reader.errorMessage(), QString("'users' item is not an array."));
+  QCOMPARE(reader.count(), qint64(0));
+
+  reader.reset();
+  QVERIFY(reader.feed(QByteArray("{\"users\": 42}")));
+  QVERIFY(! reader.finish());
+  QCOMPARE(reader.errorMessage(), QString("'users' item is not an array."));
+
+  reader.reset();
+  QVERIFY(reader.feed(QByteArray("{\"users\": \"none\"}")));
+  QVERIFY(! reader.finish());
+  QCOMPARE(reader.errorMessage(), QString("'users' item is not an array."));
+}
+
+
+QTEST_GUILESS_MAIN(UserDatabaseTest)
@@ -0,0 +1,23 @@
+#ifndef USERDATABASETEST_HH
+#define USERDATABASETEST_HH
+
+#include <QObject>
+
+class UserDatabaseTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit UserDatabaseTest(QObject *parent = nullptr);
+
+private slots:
+  void testSingleChunk();
+  void testSplitString();
+  void testSplitEscape();
+  void testSplitNumber();
+  void testEverySplit();
+  void testMissingUsers();
+  void testUsersNotArray();
+};
+
+#endif // USERDATABASETEST_HH
@@ -2,6 +2,11 @@
 
 #include <QTest>
 #include "utils.hh"
+#include "concurrency.hh"
+#include <QThread>
+#include <QSet>
+#include <QMutex>
+#include <atomic>
 
 UtilsTest::UtilsTest(QObject *parent) : QObject(parent)
 {
@@ -71,5 +76,75 @@ UtilsTest::testEncodeDMRID_bcd() {
   QCOMPARE(res, QByteArray(bcd, 4));
 }
 
+void
+UtilsTest::testBCD8() {
+  QCOMPARE(encode_bcd8(0U), 0x00000000U);
+  QCOMPARE(encode_bcd8(12345678U), 0x12345678U);
+  QCOMPARE(encode_bcd8(99999999U), 0x99999999U);
+  QCOMPARE(encode_bcd8(1020304U), 0x01020304U);
+  QCOMPARE(decode_bcd8(0x12345678U), 12345678U);
+  QCOMPARE(decode_bcd8(0x01020304U), 1020304U);
+  for (uint32_t i=0; i<100000000U; i+=999983U)
+    QCOMPARE(decode_bcd8(encode_bcd8(i)), i);
+}
+
+void
+UtilsTest::testEncodeASCII_n() {
+  // Element and string lengths that are not multiples of the vector width
+  const QVector<QString> texts = { "", "ab", "abcdefg", "abcdefgh", "abcdefghijklmno",
+                                   "abcdefghijklmnopq", QString("abc\u00e4\u20acx") };
+  const size_t sizes[] = { 3, 8, 15, 16, 17 };
+  for (size_t size: sizes) {
+    size_t stride = size+2;
+    QByteArray bufferTest(texts.size()*stride, 0x55), bufferTrue(texts.size()*stride, 0x55);
+    for (int i=0; i<texts.size(); i++)
+      encode_ascii((uint8_t *)bufferTrue.data()+i*stride, texts[i], size, 0xff);
+    encode_ascii_n((uint8_t *)bufferTest.data(), stride, texts.constData(), sizeof(QString),
+                   texts.size(), size, 0xff);
+    QCOMPARE(bufferTest, bufferTrue);
+    for (int i=0; i<texts.size(); i++) {
+      const char *elm = bufferTest.constData()+i*stride;
+      size_t len = std::min(size, size_t(texts[i].size()));
+      // Text is truncated to size, padded with the fill byte, bytes between elements are untouched
+      QCOMPARE(QByteArray(elm, len), texts[i].left(len).toLatin1().replace('?', '\0'));
+      QCOMPARE(QByteArray(elm+len, size-len), QByteArray(size-len, char(0xff)));
+      QCOMPARE(QByteArray(elm+size, 2), QByteArray(2, 0x55));
+    }
+  }
+}
+
+void
+UtilsTest::testParallelRegion() {
+  QMutex lock;
+  QSet<QThread *> threads;
+  auto record = [&lock, &threads](unsigned first, unsigned last) {
+    Q_UNUSED(first); Q_UNUSED(last);
+    QMutexLocker locker(&lock);
+    threads.insert(QThread::currentThread());
+  };
+
+  // Limited to a single thread
+  {
+    ParallelRegion region(1);
+    QCOMPARE(parallel_chunks(1000, 1), 1U);
+    parallel_for(1000, record, 1);
+  }
+  QCOMPARE(threads.count(), 1);
+  QVERIFY(threads.contains(QThread::currentThread()));
+  // Limit is restored
+  QCOMPARE(parallel_chunks(1000, 1), unsigned(std::max(1, QThread::idealThreadCount())));
+
+  // Nested calls run on the thread of the enclosing chunk
+  std::atomic<bool> nestedOnSameThread(true);
+  parallel_for(100, [&nestedOnSameThread](unsigned first, unsigned last) {
+    QThread *outer = QThread::currentThread();
+    parallel_for(last-first, [outer, &nestedOnSameThread](unsigned, unsigned) {
+      if (outer != QThread::currentThread())
+        nestedOnSameThread = false;
+    }, 1);
+  }, 1);
+  QVERIFY(nestedOnSameThread);
+}
+
 
 QTEST_GUILESS_MAIN(UtilsTest)
@@ -18,6 +18,9 @@ private slots:
   void testEncodeFrequency();
   void testDecodeDMRID_bcd();
   void testEncodeDMRID_bcd();
+  void testBCD8();
+  void testEncodeASCII_n();
+  void testParallelRegion();
 };
 
 #endif // UTILSTEST_HH